@@ -0,0 +1,886 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+#include "OSBench.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OSBENCH_MSG_MAX_SIZE        ( 256U )
+#define OSBENCH_TIMER_TICKS         ( 10000U )
+#define OSBENCH_MEM_HOLES           ( 32U )
+
+TINIUX_DATA static uOS32_t gulBenchSamples[ OSBENCH_SAMPLES ];
+TINIUX_DATA static volatile uOS32_t gulBenchStart = 0U;
+TINIUX_DATA static uOS32_t gulBenchOverhead = 0U;
+
+#if ( OS_MEMFREE_ON != 0 )
+TINIUX_DATA static void * gpvBenchMemHoles[ OSBENCH_MEM_HOLES * 2U ];
+#endif /* OS_MEMFREE_ON */
+
+#if ( OS_SEMAPHORE_ON!=0 )
+TINIUX_DATA static OSSemHandle_t gBenchSemPing = OS_NULL;
+TINIUX_DATA static OSSemHandle_t gBenchSemPong = OS_NULL;
+#endif /* OS_SEMAPHORE_ON */
+
+#if ( OS_MSGQ_ON!=0 )
+TINIUX_DATA static OSMsgQHandle_t gBenchMsgQ = OS_NULL;
+TINIUX_DATA static uOS8_t gucBenchMsg[ OSBENCH_MSG_MAX_SIZE ];
+TINIUX_DATA static uOS8_t gucBenchMsgRecv[ OSBENCH_MSG_MAX_SIZE ];
+#endif /* OS_MSGQ_ON */
+
+#if ( OS_MSGBUF_ON!=0 )
+TINIUX_DATA static OSMsgBufHandle_t gBenchMsgBuf = OS_NULL;
+TINIUX_DATA static uOS8_t gucBenchMsgBuf[ OSBENCH_MSG_MAX_SIZE ];
+#endif /* OS_MSGBUF_ON */
+
+#if ( OS_STREAMBUF_ON!=0 )
+TINIUX_DATA static OSStreamBufHandle_t gBenchStreamBuf = OS_NULL;
+#endif /* OS_STREAMBUF_ON */
+
+#if ( OS_MUTEX_ON!=0 )
+TINIUX_DATA static OSMutexHandle_t gBenchMutex = OS_NULL;
+#endif /* OS_MUTEX_ON */
+
+#if ( OS_EVENT_ON!=0 )
+TINIUX_DATA static OSEventFlagsHandle_t gBenchEventFlags = OS_NULL;
+#endif /* OS_EVENT_ON */
+
+#if ( OS_SELECT_ON!=0 ) && ( OS_MSGQ_ON!=0 )
+TINIUX_DATA static OSSelectHandle_t gBenchSelect = OS_NULL;
+#endif /* OS_SELECT_ON */
+
+#define OSBenchStart()              gulBenchStart = FitGetCycleCount()
+
+static void OSBenchStop( uOSBase_t uxIndex )
+{
+    uOS32_t ulCycles = FitGetCycleCount() - gulBenchStart;
+
+    if( ulCycles > gulBenchOverhead )
+    {
+        gulBenchSamples[ uxIndex ] = ulCycles - gulBenchOverhead;
+    }
+    else
+    {
+        gulBenchSamples[ uxIndex ] = 0U;
+    }
+}
+
+static void OSBenchReport( const char *pcName )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    uOSBase_t uxSorted = (uOSBase_t)0U;
+    uOS32_t ulSample = 0U;
+
+    /* Insertion sort, the sample count is small and this is not timed. */
+    for( uxSorted = 1U; uxSorted < OSBENCH_SAMPLES; uxSorted++ )
+    {
+        ulSample = gulBenchSamples[ uxSorted ];
+        for( uxIndex = uxSorted; ( uxIndex > 0U ) && ( gulBenchSamples[ uxIndex - 1U ] > ulSample ); uxIndex-- )
+        {
+            gulBenchSamples[ uxIndex ] = gulBenchSamples[ uxIndex - 1U ];
+        }
+        gulBenchSamples[ uxIndex ] = ulSample;
+    }
+
+    OSBENCH_PRINTF( "%-32s %10lu %10lu %10lu %10lu\n", pcName,
+                    ( unsigned long ) gulBenchSamples[ 0 ],
+                    ( unsigned long ) gulBenchSamples[ OSBENCH_SAMPLES / 2U ],
+                    ( unsigned long ) gulBenchSamples[ ( ( OSBENCH_SAMPLES * 99U ) + 99U ) / 100U - 1U ],
+                    ( unsigned long ) gulBenchSamples[ OSBENCH_SAMPLES - 1U ] );
+}
+
+static OSTaskHandle_t OSBenchHelperCreate( OSTaskFunction_t pxTaskFunction, uOSBase_t uxPriorityOffset )
+{
+    return OSTaskCreate( pxTaskFunction, OS_NULL, OSMINIMAL_STACK_SIZE,
+                         OSTaskGetPriority( OS_NULL ) + uxPriorityOffset, "Bench" );
+}
+
+static void OSBenchHelperExit( void )
+{
+#if ( OS_MEMFREE_ON != 0 )
+    OSTaskDelete( OS_NULL );
+#else
+    OSTaskSuspend( OS_NULL );
+#endif /* OS_MEMFREE_ON */
+}
+
+static void OSBenchSettle( void )
+{
+    /* Let the helpers finish and the idle task recycle them. */
+    OSTaskSleep( 2U );
+}
+
+static void OSBenchOverhead( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gulBenchOverhead = 0U;
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        OSBenchStop( uxIndex );
+    }
+    OSBenchReport( "counter overhead" );
+
+    /* The sorted samples start with the minimum. */
+    gulBenchOverhead = gulBenchSamples[ 0 ];
+}
+
+static void OSBenchSwitchTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    /* Hand back once so that the first sample is a plain switch. */
+    OSSchedule();
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStop( uxIndex );
+        OSSchedule();
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchContextSwitch( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    if( OSBenchHelperCreate( OSBenchSwitchTask, 0U ) != OS_NULL )
+    {
+        OSSchedule();
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            OSBenchStart();
+            OSSchedule();
+        }
+        OSBenchReport( "task switch (yield)" );
+        OSBenchSettle();
+    }
+}
+
+static void OSBenchSpuriousSchedule( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    /* No other task is ready at this priority, so the running task is
+    selected again, as after a spurious schedule request.  On the GCC
+    Cortex-M ports FitPENDSV_ALWAYS_SAVE set to 1 gives the cost without
+    the same task check. */
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        OSSchedule();
+        OSBenchStop( uxIndex );
+    }
+    OSBenchReport( "yield, same task selected" );
+}
+
+#if ( OS_SEMAPHORE_ON!=0 )
+static void OSBenchSemTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSSemPend( gBenchSemPing, OSPEND_FOREVER_VALUE );
+        OSSemPost( gBenchSemPong );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchSem( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchSemPing = OSSemCreate( 0U );
+    gBenchSemPong = OSSemCreate( 0U );
+    if( ( gBenchSemPing != OS_NULL ) && ( gBenchSemPong != OS_NULL ) )
+    {
+        if( OSBenchHelperCreate( OSBenchSemTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                OSSemPost( gBenchSemPing );
+                OSSemPend( gBenchSemPong, OSPEND_FOREVER_VALUE );
+                OSBenchStop( uxIndex );
+            }
+            OSBenchReport( "sem post/pend ping-pong" );
+            OSBenchSettle();
+        }
+    }
+
+#if ( OS_MEMFREE_ON != 0 )
+    if( gBenchSemPing != OS_NULL )
+    {
+        OSSemDelete( gBenchSemPing );
+    }
+    if( gBenchSemPong != OS_NULL )
+    {
+        OSSemDelete( gBenchSemPong );
+    }
+#endif /* OS_MEMFREE_ON */
+}
+#endif /* OS_SEMAPHORE_ON */
+
+#if ( OS_EVENT_ON!=0 )
+static void OSBenchEventTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSEventFlagsWait( gBenchEventFlags, 0x01UL, OSEVENT_AUTO_CLEAR, OS_NULL, OSPEND_FOREVER_VALUE );
+        OSEventFlagsSet( gBenchEventFlags, 0x02UL );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchEvent( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchEventFlags = OSEventFlagsCreate();
+    if( gBenchEventFlags != OS_NULL )
+    {
+        if( OSBenchHelperCreate( OSBenchEventTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                OSEventFlagsSet( gBenchEventFlags, 0x01UL );
+                OSEventFlagsWait( gBenchEventFlags, 0x02UL, OSEVENT_AUTO_CLEAR, OS_NULL, OSPEND_FOREVER_VALUE );
+                OSBenchStop( uxIndex );
+            }
+            OSBenchReport( "event flags set/wait ping-pong" );
+            OSBenchSettle();
+        }
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSEventFlagsDelete( gBenchEventFlags );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+#endif /* OS_EVENT_ON */
+
+#if ( OS_MSGQ_ON!=0 )
+static void OSBenchMsgQTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSMsgQReceive( gBenchMsgQ, gucBenchMsgRecv, OSPEND_FOREVER_VALUE );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchMsgQ( uOSBase_t uxItemSize, const char *pcName )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchMsgQ = OSMsgQCreate( 1U, uxItemSize );
+    if( gBenchMsgQ != OS_NULL )
+    {
+        if( OSBenchHelperCreate( OSBenchMsgQTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                OSMsgQSend( gBenchMsgQ, gucBenchMsg, OSPEND_FOREVER_VALUE );
+            }
+            OSBenchReport( pcName );
+            OSBenchSettle();
+        }
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMsgQDelete( gBenchMsgQ );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+
+static void OSBenchMsgQZeroCopyTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    void *pvItem = OS_NULL;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        pvItem = OSMsgQAcquire( gBenchMsgQ, OSPEND_FOREVER_VALUE );
+        OSBenchStop( uxIndex );
+        OSMsgQRelease( gBenchMsgQ, pvItem );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchMsgQZeroCopy( uOSBase_t uxItemSize, const char *pcName )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    void *pvItem = OS_NULL;
+
+    gBenchMsgQ = OSMsgQCreate( 1U, uxItemSize );
+    if( gBenchMsgQ != OS_NULL )
+    {
+        if( OSBenchHelperCreate( OSBenchMsgQZeroCopyTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                pvItem = OSMsgQReserve( gBenchMsgQ, OSPEND_FOREVER_VALUE );
+                OSMsgQCommit( gBenchMsgQ, pvItem );
+            }
+            OSBenchReport( pcName );
+            OSBenchSettle();
+        }
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMsgQDelete( gBenchMsgQ );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+
+/* Drain 16 queued items of 4 bytes, one by one and then as one batch. */
+static void OSBenchMsgQMulti( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    uOSBase_t uxItem = (uOSBase_t)0U;
+
+    gBenchMsgQ = OSMsgQCreate( 16U, 4U );
+    if( gBenchMsgQ != OS_NULL )
+    {
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            ( void ) OSMsgQSendMulti( gBenchMsgQ, gucBenchMsg, 16U, 16U, 0U );
+            OSBenchStart();
+            for( uxItem = 0U; uxItem < 16U; uxItem++ )
+            {
+                OSMsgQReceive( gBenchMsgQ, &gucBenchMsgRecv[ uxItem * 4U ], 0U );
+            }
+            OSBenchStop( uxIndex );
+        }
+        OSBenchReport( "msgq receive 16 items one by one" );
+
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            ( void ) OSMsgQSendMulti( gBenchMsgQ, gucBenchMsg, 16U, 16U, 0U );
+            OSBenchStart();
+            ( void ) OSMsgQReceiveMulti( gBenchMsgQ, gucBenchMsgRecv, 16U, 16U, 0U );
+            OSBenchStop( uxIndex );
+        }
+        OSBenchReport( "msgq receive 16 items as a batch" );
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMsgQDelete( gBenchMsgQ );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+
+#if ( OS_SELECT_ON!=0 )
+static void OSBenchSelectTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        if( OSSelectWait( gBenchSelect, OSPEND_FOREVER_VALUE ) == gBenchMsgQ )
+        {
+            OSBenchStop( uxIndex );
+            OSMsgQReceive( gBenchMsgQ, gucBenchMsgRecv, 0U );
+        }
+    }
+    OSBenchHelperExit();
+}
+
+/* The same as the 4 bytes MsgQ case, with the receiver waiting on a select. */
+static void OSBenchSelect( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchMsgQ = OSMsgQCreate( 1U, 4U );
+    gBenchSelect = OSSelectCreate( 1U );
+    if( ( gBenchMsgQ != OS_NULL ) && ( gBenchSelect != OS_NULL ) )
+    {
+        ( void ) OSSelectAddMsgQ( gBenchSelect, gBenchMsgQ );
+        if( OSBenchHelperCreate( OSBenchSelectTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                OSMsgQSend( gBenchMsgQ, gucBenchMsg, OSPEND_FOREVER_VALUE );
+            }
+            OSBenchReport( "select wake on msgq send" );
+            OSBenchSettle();
+        }
+    }
+
+#if ( OS_MEMFREE_ON != 0 )
+    if( gBenchSelect != OS_NULL )
+    {
+        OSSelectDelete( gBenchSelect );
+    }
+    if( gBenchMsgQ != OS_NULL )
+    {
+        OSMsgQDelete( gBenchMsgQ );
+    }
+#endif /* OS_MEMFREE_ON */
+}
+#endif /* OS_SELECT_ON */
+#endif /* OS_MSGQ_ON */
+
+#if ( OS_MSGBUF_ON!=0 )
+static void OSBenchMsgBufTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSMsgBufReceive( gBenchMsgBuf, gucBenchMsgBuf, OSBENCH_MSG_MAX_SIZE, OSPEND_FOREVER_VALUE );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchMsgBuf( uOSBase_t uxMsgLen, const char *pcName )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchMsgBuf = OSMsgBufCreate( OSBENCH_MSG_MAX_SIZE );
+    if( gBenchMsgBuf != OS_NULL )
+    {
+        if( OSBenchHelperCreate( OSBenchMsgBufTask, 1U ) != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSBenchStart();
+                OSMsgBufSend( gBenchMsgBuf, gucBenchMsgBuf, uxMsgLen, OSPEND_FOREVER_VALUE );
+            }
+            OSBenchReport( pcName );
+            OSBenchSettle();
+        }
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMsgBufDelete( gBenchMsgBuf );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+#endif /* OS_MSGBUF_ON */
+
+#if ( OS_STREAMBUF_ON!=0 )
+static void OSBenchStreamBuf( void )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    uOS8_t ucByte = 0U;
+
+    gBenchStreamBuf = OSStreamBufCreate( 16U, 1U );
+    if( gBenchStreamBuf != OS_NULL )
+    {
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            OSBenchStart();
+            OSStreamBufWriteFromISR( gBenchStreamBuf, &ucByte, 1U );
+            OSBenchStop( uxIndex );
+            OSStreamBufRead( gBenchStreamBuf, &ucByte, 1U, 0U );
+        }
+        OSBenchReport( "streambuf write from ISR, 1 byte" );
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSStreamBufDelete( gBenchStreamBuf );
+#endif /* OS_MEMFREE_ON */
+    }
+
+#if ( OS_MSGQ_ON!=0 )
+    /* The same byte through a MsgQ, for comparison. */
+    gBenchMsgQ = OSMsgQCreate( 16U, 1U );
+    if( gBenchMsgQ != OS_NULL )
+    {
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            OSBenchStart();
+            OSMsgQSendFromISR( gBenchMsgQ, &ucByte );
+            OSBenchStop( uxIndex );
+            OSMsgQReceive( gBenchMsgQ, &ucByte, 0U );
+        }
+        OSBenchReport( "msgq send from ISR, 1 byte" );
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMsgQDelete( gBenchMsgQ );
+#endif /* OS_MEMFREE_ON */
+    }
+#endif /* OS_MSGQ_ON */
+}
+#endif /* OS_STREAMBUF_ON */
+
+#if ( OS_MUTEX_ON!=0 )
+static void OSBenchMutexTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSTaskSuspend( OS_NULL );
+        OSMutexLock( gBenchMutex, OSPEND_FOREVER_VALUE );
+        OSBenchStop( uxIndex );
+        OSMutexUnlock( gBenchMutex );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchMutex( void )
+{
+    OSTaskHandle_t HelperHandle = OS_NULL;
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    gBenchMutex = OSMutexCreate();
+    if( gBenchMutex != OS_NULL )
+    {
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            OSBenchStart();
+            OSMutexLock( gBenchMutex, OSPEND_FOREVER_VALUE );
+            OSMutexUnlock( gBenchMutex );
+            OSBenchStop( uxIndex );
+        }
+        OSBenchReport( "mutex lock/unlock" );
+
+        /* The helper blocks on the mutex held here, the unlock hands it over
+        and switches to the helper. */
+        HelperHandle = OSBenchHelperCreate( OSBenchMutexTask, 1U );
+        if( HelperHandle != OS_NULL )
+        {
+            for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+            {
+                OSMutexLock( gBenchMutex, OSPEND_FOREVER_VALUE );
+                OSTaskResume( HelperHandle );
+                OSBenchStart();
+                OSMutexUnlock( gBenchMutex );
+            }
+            OSBenchReport( "mutex unlock to waiter" );
+            OSBenchSettle();
+        }
+
+#if ( OS_MEMFREE_ON != 0 )
+        OSMutexDelete( gBenchMutex );
+#endif /* OS_MEMFREE_ON */
+    }
+}
+#endif /* OS_MUTEX_ON */
+
+#if ( OS_TASK_SIGNAL_ON!=0 )
+static void OSBenchSignalTask( void *pvParameters )
+{
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    ( void ) pvParameters;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSTaskSignalWait( OSPEND_FOREVER_VALUE );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchHelperExit();
+}
+
+static void OSBenchSignal( void )
+{
+    OSTaskHandle_t HelperHandle = OS_NULL;
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    HelperHandle = OSBenchHelperCreate( OSBenchSignalTask, 1U );
+    if( HelperHandle != OS_NULL )
+    {
+        for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+        {
+            OSBenchStart();
+            OSTaskSignalEmit( HelperHandle );
+        }
+        OSBenchReport( "task signal emit to wait" );
+        OSBenchSettle();
+    }
+}
+#endif /* OS_TASK_SIGNAL_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+static void OSBenchMemory( void )
+{
+    void *pvBlock = OS_NULL;
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        pvBlock = OSMemMalloc( OSBENCH_MEM_SIZE );
+        OSBenchStop( uxIndex );
+        OSMemFree( pvBlock );
+    }
+    OSBenchReport( "mem malloc" );
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        pvBlock = OSMemMalloc( OSBENCH_MEM_SIZE );
+        OSBenchStart();
+        OSMemFree( pvBlock );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchReport( "mem free" );
+
+    /* Leave every other block free, none of the holes fits the timed request. */
+    for( uxIndex = 0U; uxIndex < OSBENCH_MEM_HOLES * 2U; uxIndex++ )
+    {
+        gpvBenchMemHoles[ uxIndex ] = OSMemMalloc( OSBENCH_MEM_SIZE );
+    }
+    for( uxIndex = 0U; uxIndex < OSBENCH_MEM_HOLES * 2U; uxIndex += 2U )
+    {
+        OSMemFree( gpvBenchMemHoles[ uxIndex ] );
+    }
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        pvBlock = OSMemMalloc( OSBENCH_MEM_SIZE * 4U );
+        OSBenchStop( uxIndex );
+        OSMemFree( pvBlock );
+    }
+    OSBenchReport( "mem malloc, fragmented heap" );
+
+    /* Longest stretch the same request keeps the interrupts off. With the
+       interrupt lock it is the whole call, with SETOS_MEM_SCHEDULE_LOCK only
+       OSScheduleUnlock() masks them, it is timed as a whole as an upper bound. */
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+#if ( OS_MEM_SCHEDULE_LOCK_ON==0 )
+        OSBenchStart();
+        pvBlock = OSMemMalloc( OSBENCH_MEM_SIZE * 4U );
+        OSBenchStop( uxIndex );
+#else
+        OSScheduleLock();
+        pvBlock = OSMemMalloc( OSBENCH_MEM_SIZE * 4U );
+        OSBenchStart();
+        ( void ) OSScheduleUnlock();
+        OSBenchStop( uxIndex );
+#endif /* OS_MEM_SCHEDULE_LOCK_ON */
+        OSMemFree( pvBlock );
+    }
+    OSBenchReport( "mem int-off, fragmented heap" );
+
+    for( uxIndex = 1U; uxIndex < OSBENCH_MEM_HOLES * 2U; uxIndex += 2U )
+    {
+        OSMemFree( gpvBenchMemHoles[ uxIndex ] );
+    }
+}
+#endif /* OS_MEMFREE_ON */
+
+#if ( OS_MEMPOOL_ON!=0 )
+static void OSBenchMemPool( void )
+{
+    OSMemPoolHandle_t MemPoolHandle = OSMemPoolCreate( OSBENCH_MEM_SIZE, 1U );
+    void *pvBlock = OS_NULL;
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        pvBlock = OSMemPoolAlloc( MemPoolHandle, 0U );
+        OSBenchStop( uxIndex );
+        ( void ) OSMemPoolFree( MemPoolHandle, pvBlock );
+    }
+    OSBenchReport( "mempool alloc" );
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        pvBlock = OSMemPoolAlloc( MemPoolHandle, 0U );
+        OSBenchStart();
+        ( void ) OSMemPoolFree( MemPoolHandle, pvBlock );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchReport( "mempool free" );
+
+#if ( OS_MEMFREE_ON != 0 )
+    OSMemPoolDelete( MemPoolHandle );
+#endif /* OS_MEMFREE_ON */
+}
+#endif /* OS_MEMPOOL_ON */
+
+#if ( OS_TIMER_ON!=0 )
+static void OSBenchTimerFunction( void *pvParameter )
+{
+    ( void ) pvParameter;
+}
+
+static void OSBenchTimerArmed( OSTimerHandle_t *pTimerHandles, uOSBase_t uxArmedNum )
+{
+    OSTimerHandle_t TimerHandle = pTimerHandles[ OSBENCH_TIMER_NUM ];
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    /* Arm the other timers, each one at a different expiry. */
+    for( uxIndex = 0U; uxIndex < uxArmedNum; uxIndex++ )
+    {
+        OSTimerSetTicks( pTimerHandles[ uxIndex ], OSBENCH_TIMER_TICKS + uxIndex );
+        OSTimerStart( pTimerHandles[ uxIndex ] );
+    }
+
+    OSBENCH_PRINTF( "with %lu armed timers:\n", ( unsigned long ) uxArmedNum );
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSBenchStart();
+        OSTimerStart( TimerHandle );
+        OSBenchStop( uxIndex );
+        OSTimerStop( TimerHandle );
+    }
+    OSBenchReport( "timer start" );
+
+    for( uxIndex = 0U; uxIndex < OSBENCH_SAMPLES; uxIndex++ )
+    {
+        OSTimerStart( TimerHandle );
+        OSBenchStart();
+        OSTimerStop( TimerHandle );
+        OSBenchStop( uxIndex );
+    }
+    OSBenchReport( "timer stop" );
+
+    for( uxIndex = 0U; uxIndex < uxArmedNum; uxIndex++ )
+    {
+        OSTimerStop( pTimerHandles[ uxIndex ] );
+    }
+}
+
+static void OSBenchTimer( void )
+{
+    /* The last timer is the one being timed. */
+    OSTimerHandle_t TimerHandles[ OSBENCH_TIMER_NUM + 1U ];
+    uOSBase_t uxTimerNum = (uOSBase_t)0U;
+
+    for( uxTimerNum = 0U; uxTimerNum <= OSBENCH_TIMER_NUM; uxTimerNum++ )
+    {
+        TimerHandles[ uxTimerNum ] = OSTimerCreate( OSBENCH_TIMER_TICKS, 1U, OSBenchTimerFunction, OS_NULL, "Bench" );
+        if( TimerHandles[ uxTimerNum ] == OS_NULL )
+        {
+            break;
+        }
+    }
+
+    if( uxTimerNum > OSBENCH_TIMER_NUM )
+    {
+        OSBenchTimerArmed( TimerHandles, 0U );
+        if( OSBENCH_TIMER_NUM > 0U )
+        {
+            OSBenchTimerArmed( TimerHandles, OSBENCH_TIMER_NUM );
+        }
+    }
+
+#if ( OS_MEMFREE_ON != 0 )
+    while( uxTimerNum > 0U )
+    {
+        uxTimerNum--;
+        OSTimerDelete( TimerHandles[ uxTimerNum ] );
+    }
+#endif /* OS_MEMFREE_ON */
+}
+#endif /* OS_TIMER_ON */
+
+void OSBenchRun( void )
+{
+    FitCycleCounterInit();
+
+    OSBENCH_PRINTF( "%-32s %10s %10s %10s %10s\n", "case", "min", "median", "p99", "max" );
+
+    OSBenchOverhead();
+    OSBenchContextSwitch();
+    OSBenchSpuriousSchedule();
+#if ( OS_SEMAPHORE_ON!=0 )
+    OSBenchSem();
+#endif /* OS_SEMAPHORE_ON */
+#if ( OS_EVENT_ON!=0 )
+    OSBenchEvent();
+#endif /* OS_EVENT_ON */
+#if ( OS_MSGQ_ON!=0 )
+    OSBenchMsgQ( 4U, "msgq send to receive, 4 bytes" );
+    OSBenchMsgQ( 16U, "msgq send to receive, 16 bytes" );
+    OSBenchMsgQ( 64U, "msgq send to receive, 64 bytes" );
+    OSBenchMsgQ( 256U, "msgq send to receive, 256 bytes" );
+    OSBenchMsgQZeroCopy( 256U, "msgq commit to acquire, 256 bytes" );
+    OSBenchMsgQMulti();
+#if ( OS_SELECT_ON!=0 )
+    OSBenchSelect();
+#endif /* OS_SELECT_ON */
+#endif /* OS_MSGQ_ON */
+#if ( OS_MSGBUF_ON!=0 )
+    OSBenchMsgBuf( 16U, "msgbuf send to receive, 16 bytes" );
+    OSBenchMsgBuf( 200U, "msgbuf send to receive, 200 bytes" );
+#endif /* OS_MSGBUF_ON */
+#if ( OS_STREAMBUF_ON!=0 )
+    OSBenchStreamBuf();
+#endif /* OS_STREAMBUF_ON */
+#if ( OS_MUTEX_ON!=0 )
+    OSBenchMutex();
+#endif /* OS_MUTEX_ON */
+#if ( OS_TASK_SIGNAL_ON!=0 )
+    OSBenchSignal();
+#endif /* OS_TASK_SIGNAL_ON */
+#if ( OS_MEMFREE_ON != 0 )
+    OSBenchMemory();
+#endif /* OS_MEMFREE_ON */
+#if ( OS_MEMPOOL_ON!=0 )
+    OSBenchMemPool();
+#endif /* OS_MEMPOOL_ON */
+#if ( OS_TIMER_ON!=0 )
+    OSBenchTimer();
+#endif /* OS_TIMER_ON */
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,90 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_BENCH_H_
+#define __OS_BENCH_H_
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Kernel micro-benchmarks.  OSBenchRun() must be called from a task once the
+ * scheduler has started, it creates its helper tasks at its own priority and
+ * one above it, so it should run below OSCALLBACK_TASK_PRIO - 1.  Every case is
+ * sampled OSBENCH_SAMPLES times and reported as min/median/p99/max in the unit
+ * of FitGetCycleCount(): CPU cycles from the DWT on Cortex-M3/M4/M7,
+ * nanoseconds on the POSIX host port.  The cost of reading the counter is
+ * measured first and subtracted from every sample.
+ */
+
+// Number of samples taken for every case
+#ifndef SETOS_BENCH_SAMPLES
+  #define    OSBENCH_SAMPLES           ( 100U )
+#else
+  #define    OSBENCH_SAMPLES           ( SETOS_BENCH_SAMPLES )
+#endif
+
+// Number of timers kept armed while OSTimerStart/OSTimerStop are timed
+#ifndef SETOS_BENCH_TIMER_NUM
+  #define    OSBENCH_TIMER_NUM         ( 16U )
+#else
+  #define    OSBENCH_TIMER_NUM         ( SETOS_BENCH_TIMER_NUM )
+#endif
+
+// Block size used by the OSMemMalloc/OSMemFree case
+#ifndef SETOS_BENCH_MEM_SIZE
+  #define    OSBENCH_MEM_SIZE          ( 32U )
+#else
+  #define    OSBENCH_MEM_SIZE          ( SETOS_BENCH_MEM_SIZE )
+#endif
+
+// Output of the results
+#ifndef OSBENCH_PRINTF
+  #include <stdio.h>
+  #define    OSBENCH_PRINTF            printf
+#endif
+
+void      OSBenchRun( void ) TINIUX_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_BENCH_H_
@@ -50,6 +50,7 @@ extern void FitSchedule( void );
 #define FitNVIC_INT_CTRL_REG        ( * ( ( volatile uOS32_t * ) 0xe000ed04 ) )
 #define FitNVIC_PENDSVSET_BIT       ( 1UL << 28UL )
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#define FitMemoryBarrier()          __asm volatile( "dmb" ::: "memory" )
 
 extern void FitIntLock( void );
 extern void FitIntUnlock( void );
@@ -37,6 +37,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /* Compiler includes. */
 #include <stdint.h>
+#include <stddef.h>
 
 #include "TINIUX.h"
 
@@ -133,6 +134,42 @@ static void FitStartFirstTask( void ) __attribute__ (( naked ));
 static void FitEnableVFP( void ) __attribute__ (( naked ));
 static void FitTaskExitError( void );
 
+#if ( OS_STACK_MPU_GUARD_ON!=0 )
+/*
+ * Set up the stack guard region and enable the MPU.
+ */
+static void FitStackGuardInit( void );
+
+extern tOSTCB_t * volatile gptCurrentTCB;
+
+/* Move the guard to the bottom of the incoming task stack, r1 holds its TCB.
+Writing RBAR with the VALID bit selects the region and sets its base at once. */
+#define FitSTACK_GUARD_MOVE                                                     \
+    "    ldr r2, [r1, %1]                    \n" /* puxStartStack of the TCB. */ \
+    "    add r2, r2, %2                      \n"                                \
+    "    bic r2, r2, %2                      \n" /* Align up to the guard size. */ \
+    "    orr r2, r2, %3                      \n" /* VALID and the region number. */ \
+    "    movw r0, #0xed9c                    \n"                                \
+    "    movt r0, #0xe000                    \n" /* MPU RBAR. */                 \
+    "    str r2, [r0]                        \n"                                \
+    "    dsb                                 \n"
+#define FitSTACK_GUARD_OPERANDS                                                 \
+    , "i"( offsetof( tOSTCB_t, puxStartStack ) ), "i"( FitMPU_GUARD_SIZE - 1UL ), "i"( FitMPU_RBAR_VALID_BIT | FitMPU_GUARD_REGION )
+/* The guard checks the stack, OSTaskSwitchContext does not. */
+#define FitSTACK_TOP_SET
+#else
+#define FitSTACK_GUARD_MOVE
+#define FitSTACK_GUARD_OPERANDS
+/* OSTaskSwitchContext checks the stack before the task registers are saved,
+so give it the top of stack they will leave. */
+#define FitSTACK_TOP_SET                                                        \
+    "    sub r1, r0, #36                     \n"                                \
+    "    tst r14, #0x10                      \n"                                \
+    "    it eq                               \n"                                \
+    "    subeq r1, r1, #64                   \n" /* And the high vfp registers. */ \
+    "    str r1, [r2]                        \n"
+#endif /* OS_STACK_MPU_GUARD_ON */
+
 
 uOSStack_t *FitInitializeStack( uOSStack_t *pxTopOfStack,
         OSTaskFunction_t TaskFunction, void *pvParameters )
@@ -240,6 +277,10 @@ uOSBase_t FitStartScheduler( void )
     /* Lazy save always. */
     *( FitFPCCR ) |= FitASPEN_AND_LSPEN_BITS;
 
+    #if ( OS_STACK_MPU_GUARD_ON!=0 )
+    FitStackGuardInit();
+    #endif /* OS_STACK_MPU_GUARD_ON */
+
     /* Start the first task. */
     FitStartFirstTask();
 
@@ -249,6 +290,47 @@ uOSBase_t FitStartScheduler( void )
     return 0;    
 }
 
+#if ( OS_STACK_MPU_GUARD_ON!=0 )
+static void FitStackGuardInit( void )
+{
+    /* No access and no execution, even for privileged code. */
+    FitMPU_RNR_REG = FitMPU_GUARD_REGION;
+    FitMPU_RASR_REG = FitMPU_RASR_XN_BIT | FitMPU_GUARD_SIZE_FIELD | FitMPU_RASR_ENABLE_BIT;
+    FitMPU_RBAR_REG = ( FitStackGuardEnd( gptCurrentTCB->puxStartStack ) - FitMPU_GUARD_SIZE ) | FitMPU_RBAR_VALID_BIT | FitMPU_GUARD_REGION;
+
+    /* The default memory map stays for everything else, an overflow is
+    reported as a MemManage fault instead of a HardFault. */
+    FitNVIC_SHCSR_REG |= FitNVIC_MEMFAULTENA_BIT;
+    FitMPU_CTRL_REG = FitMPU_ENABLE_BIT | FitMPU_PRIVDEFENA_BIT;
+    __asm volatile( "dsb" );
+    __asm volatile( "isb" );
+}
+#endif /* OS_STACK_MPU_GUARD_ON */
+
+#if ( OS_FAST_SECTION_ON!=0 )
+/* Load and run addresses of the fast sections, given by FitSection.ld. */
+extern uOS32_t _sitiniux_fast_text[], _stiniux_fast_text[], _etiniux_fast_text[];
+extern uOS32_t _sitiniux_fast_data[], _stiniux_fast_data[], _etiniux_fast_data[];
+
+static void FitSectionCopy( const uOS32_t *pulLoad, uOS32_t *pulStart, const uOS32_t *pulEnd )
+{
+    while( pulStart < pulEnd )
+    {
+        *pulStart++ = *pulLoad++;
+    }
+}
+
+void FitSectionInit( void )
+{
+    FitSectionCopy( _sitiniux_fast_text, _stiniux_fast_text, _etiniux_fast_text );
+    FitSectionCopy( _sitiniux_fast_data, _stiniux_fast_data, _etiniux_fast_data );
+
+    /* The copied code must be visible to the instruction fetch before it runs. */
+    __asm volatile( "dsb" ::: "memory" );
+    __asm volatile( "isb" );
+}
+#endif /* OS_FAST_SECTION_ON */
+
 void FitEndScheduler( void )
 {
 
@@ -271,6 +353,20 @@ void FitIntUnlock( void )
 }
 
 
+/* FitPENDSV_ALWAYS_SAVE set to 1 stores and restores the task registers even
+when the same task is selected again, as before the check was added, so the
+"yield, same task selected" bench case can be timed both ways on a target. */
+#ifndef FitPENDSV_ALWAYS_SAVE
+  #define FitPENDSV_ALWAYS_SAVE                 ( 0 )
+#endif
+#if ( FitPENDSV_ALWAYS_SAVE == 0 )
+#define FitPENDSV_SAME_TASK_SKIP                                                \
+    "    cmp r1, r2                          \n" /* The same task was selected again, resume it as it is. */ \
+    "    beq 1f                              \n"
+#else
+#define FitPENDSV_SAME_TASK_SKIP
+#endif
+
 void FitPendSVHandler( void )
 {
     /* This is a naked function. */
@@ -283,15 +379,8 @@ void FitPendSVHandler( void )
     "    ldr    r3, ptCurrentTCBTemp2        \n" /* Get the location of the current TCB. */
     "    ldr    r2, [r3]                     \n"
     "                                        \n"
-    "    tst r14, #0x10                      \n" /* Is the task using the FPU context?  If so, push high vfp registers. */
-    "    it eq                               \n"
-    "    vstmdbeq r0!, {s16-s31}             \n"
-    "                                        \n"
-    "    stmdb r0!, {r4-r11, r14}            \n" /* Save the core registers. */
-    "                                        \n"
-    "    str r0, [r2]                        \n" /* Save the new top of stack into the first member of the TCB. */
-    "                                        \n"
-    "    stmdb sp!, {r3}                     \n"
+    FitSTACK_TOP_SET
+    "    stmdb sp!, {r0, r2, r3, r14}        \n" /* The task registers are callee saved, they are only stored on a real switch. */
     "    mov r0, %0                          \n"
     "    msr basepri, r0                     \n"
     "    dsb                                 \n"
@@ -299,9 +388,19 @@ void FitPendSVHandler( void )
     "    bl OSTaskSwitchContext              \n"
     "    mov r0, #0                          \n"
     "    msr basepri, r0                     \n"
-    "    ldmia sp!, {r3}                     \n"
+    "    ldmia sp!, {r0, r2, r3, r14}        \n"
+    "                                        \n"
+    "    ldr r1, [r3]                        \n" /* The TCB selected to run. */
+    FitPENDSV_SAME_TASK_SKIP
+    "                                        \n"
+    "    tst r14, #0x10                      \n" /* Is the task using the FPU context?  If so, push high vfp registers. */
+    "    it eq                               \n"
+    "    vstmdbeq r0!, {s16-s31}             \n"
+    "                                        \n"
+    "    stmdb r0!, {r4-r11, r14}            \n" /* Save the core registers. */
+    "    str r0, [r2]                        \n" /* Save the new top of stack into the first member of the TCB. */
     "                                        \n"
-    "    ldr r1, [r3]                        \n" /* The first item in gptCurrentTCB is the task top of stack. */
+    FitSTACK_GUARD_MOVE
     "    ldr r0, [r1]                        \n"
     "                                        \n"
     "    ldmia r0!, {r4-r11, r14}            \n" /* Pop the core registers. */
@@ -313,6 +412,7 @@ void FitPendSVHandler( void )
     "    msr psp, r0                         \n"
     "    isb                                 \n"
     "                                        \n"
+    "1:                                      \n"
     #ifdef WORKAROUND_PMU_CM001 /* XMC4000 specific errata workaround. */
         #if WORKAROUND_PMU_CM001 == 1
     "            push { r14 }                \n"
@@ -324,7 +424,7 @@ void FitPendSVHandler( void )
     "                                        \n"
     "    .align 4                            \n"
     "ptCurrentTCBTemp2: .word gptCurrentTCB  \n"
-    ::"i"(OSMAX_HWINT_PRI)
+    ::"i"(OSMAX_HWINT_PRI) FitSTACK_GUARD_OPERANDS
     );
 }
 
@@ -63,6 +63,47 @@ extern "C" {
 #define FitNVIC_INT_CTRL_REG                    ( * ( ( volatile uOS32_t * ) 0xe000ed04 ) )
 #define FitNVIC_PENDSVSET_BIT                   ( 1UL << 28UL )
 #define FitScheduleFromISR( b )                 if( b ) FitSchedule()
+#define FitMemoryBarrier()                      __asm volatile( "dmb" ::: "memory" )
+
+/* Cycle counter, used to time the kernel primitives. */
+#define FitDEMCR_REG                            ( * ( ( volatile uOS32_t * ) 0xe000edfc ) )
+#define FitDWT_CTRL_REG                         ( * ( ( volatile uOS32_t * ) 0xe0001000 ) )
+#define FitDWT_CYCCNT_REG                       ( * ( ( volatile uOS32_t * ) 0xe0001004 ) )
+#define FitDEMCR_TRCENA_BIT                     ( 1UL << 24UL )
+#define FitDWT_CYCCNTENA_BIT                    ( 1UL << 0UL )
+
+#define FitCycleCounterInit()                                                    \
+{                                                                                \
+    FitDEMCR_REG |= FitDEMCR_TRCENA_BIT;                                         \
+    FitDWT_CYCCNT_REG = 0UL;                                                     \
+    FitDWT_CTRL_REG |= FitDWT_CYCCNTENA_BIT;                                     \
+}
+#define FitGetCycleCount()                      ( FitDWT_CYCCNT_REG )
+
+#if ( OS_STACK_MPU_GUARD_ON!=0 )
+/* MPU region which makes the bottom of the running task stack fault, it is
+moved to the incoming task by FitPendSVHandler. Region 7 takes precedence
+over the regions of the application, it must be left to the kernel. */
+#define FITSTACK_GUARD                          ( 1U )
+#define FitMPU_CTRL_REG                         ( * ( ( volatile uOS32_t * ) 0xe000ed94 ) )
+#define FitMPU_RNR_REG                          ( * ( ( volatile uOS32_t * ) 0xe000ed98 ) )
+#define FitMPU_RBAR_REG                         ( * ( ( volatile uOS32_t * ) 0xe000ed9c ) )
+#define FitMPU_RASR_REG                         ( * ( ( volatile uOS32_t * ) 0xe000eda0 ) )
+#define FitNVIC_SHCSR_REG                       ( * ( ( volatile uOS32_t * ) 0xe000ed24 ) )
+#define FitMPU_ENABLE_BIT                       ( 1UL << 0UL )
+#define FitMPU_PRIVDEFENA_BIT                   ( 1UL << 2UL )
+#define FitMPU_RBAR_VALID_BIT                   ( 1UL << 4UL )
+#define FitMPU_RASR_XN_BIT                      ( 1UL << 28UL )
+#define FitMPU_RASR_ENABLE_BIT                  ( 1UL << 0UL )
+#define FitNVIC_MEMFAULTENA_BIT                 ( 1UL << 16UL )
+#define FitMPU_GUARD_REGION                     ( 7UL )
+#define FitMPU_GUARD_SIZE                       ( 32UL )            /* The smallest MPU region. */
+#define FitMPU_GUARD_SIZE_FIELD                 ( 4UL << 1UL )      /* 2^(4+1) bytes. */
+
+/* The guard is the first FitMPU_GUARD_SIZE aligned block of the stack, this
+is the first byte above it. */
+#define FitStackGuardEnd( puxStack )            ( ( ( ( uOS32_t ) ( puxStack ) + FitMPU_GUARD_SIZE - 1UL ) & ~( FitMPU_GUARD_SIZE - 1UL ) ) + FitMPU_GUARD_SIZE )
+#endif /* OS_STACK_MPU_GUARD_ON */
 
 
 /* Critical section management. */
@@ -80,7 +121,6 @@ extern void FitIntUnlock( void );
     #define FIT_FORCE_INLINE inline __attribute__(( always_inline))
 #endif
 
-#if (OSHIGHEAST_PRIORITY<=32U)
 #define FITQUICK_GET_PRIORITY                  ( 1U )
 /* Generic helper function. */
 static FIT_FORCE_INLINE uOS8_t FitCountLeadingZeros( uint32_t ulBitmap )
@@ -91,7 +131,6 @@ static FIT_FORCE_INLINE uOS8_t FitCountLeadingZeros( uint32_t ulBitmap )
     return ucReturn;
 }
 #define FitGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - FitCountLeadingZeros( ( uxReadyPriorities ) ) )
-#endif
 
 FIT_FORCE_INLINE uOS32_t FitGetIPSR( void )
 {
@@ -143,10 +182,15 @@ static FIT_FORCE_INLINE uOS32_t FitRaiseBasePRI( void )
 uOSStack_t *FitInitializeStack( uOSStack_t *pxTopOfStack, OSTaskFunction_t TaskFunction, void *pvParameters );
 uOSBase_t FitStartScheduler( void );
 
-void FitPendSVHandler( void ) __attribute__ (( naked ));
-void FitOSTickISR( void );
+void FitPendSVHandler( void ) __attribute__ (( naked )) TINIUX_FAST_FUNCTION;
+void FitOSTickISR( void ) TINIUX_FAST_FUNCTION;
 void FitSVCHandler( void ) __attribute__ (( naked ));
 
+#if ( OS_FAST_SECTION_ON!=0 )
+/* Copy the fast sections from flash, called first by OSInit. */
+void FitSectionInit( void );
+#endif /* OS_FAST_SECTION_ON */
+
 #if ( OS_LOWPOWER_ON!=0 )
 /* Tickless idle/low power functionality. */
     #ifndef FitLowPowerIdle
@@ -58,6 +58,10 @@ typedef        uOS32_t             uOSTick_t;
 #define        FITSTACK_GROWTH     ( -1 )
 #define        FITBYTE_ALIGNMENT   ( 8 )
 
+/* Sections of the scheduler hot path, placed in ITCM and DTCM by FitSection.ld. */
+#define        FITSECTION_FAST_DATA         __attribute__(( section( ".tiniux_fast_data" ) ))
+#define        FITSECTION_FAST_FUNCTION     __attribute__(( section( ".tiniux_fast_text" ) ))
+
 #ifdef __cplusplus
 }
 #endif
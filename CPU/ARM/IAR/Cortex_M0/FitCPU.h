@@ -49,6 +49,8 @@ extern void FitSchedule( void );
 #define FitNVIC_INT_CTRL            ( ( volatile uOS32_t *) 0xe000ed04 )
 #define FitNVIC_PENDSVSET           0x10000000
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#include <intrinsics.h>
+#define FitMemoryBarrier()          __DMB()
 
 extern void FitIntLock( void );
 extern void FitIntUnlock( void );
@@ -49,13 +49,27 @@ extern void FitSchedule( void );
 #define FitNVIC_INT_CTRL_REG        ( * ( ( volatile uOS32_t * ) 0xe000ed04UL ) )
 #define FitNVIC_PENDSVSET_BIT       ( 1UL << 28UL )
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#define FitMemoryBarrier()          __DMB()
+
+/* Cycle counter, used to time the kernel primitives. */
+#define FitDEMCR_REG                            ( * ( ( volatile uOS32_t * ) 0xe000edfc ) )
+#define FitDWT_CTRL_REG                         ( * ( ( volatile uOS32_t * ) 0xe0001000 ) )
+#define FitDWT_CYCCNT_REG                       ( * ( ( volatile uOS32_t * ) 0xe0001004 ) )
+#define FitDEMCR_TRCENA_BIT                     ( 1UL << 24UL )
+#define FitDWT_CYCCNTENA_BIT                    ( 1UL << 0UL )
+
+#define FitCycleCounterInit()                                                    \
+{                                                                                \
+    FitDEMCR_REG |= FitDEMCR_TRCENA_BIT;                                         \
+    FitDWT_CYCCNT_REG = 0UL;                                                     \
+    FitDWT_CTRL_REG |= FitDWT_CYCCNTENA_BIT;                                     \
+}
+#define FitGetCycleCount()                      ( FitDWT_CYCCNT_REG )
 /*-----------------------------------------------------------*/
 
 #include <intrinsics.h>
-#if (OSHIGHEAST_PRIORITY<=32U)
 #define FITQUICK_GET_PRIORITY      ( 1U )
 #define FitGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __CLZ( ( uxReadyPriorities ) ) )
-#endif
 
 extern void FitIntLock( void );
 extern void FitIntUnlock( void );
@@ -53,6 +53,7 @@ extern void FitSchedule( void );
 #define FitIsInsideISR()            ( ( uOSBool_t ) ( FitGetIPSR() != ( uOSBase_t )0 ) )
 
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#define FitMemoryBarrier()          __dmb( 15 )
 
 extern void FitIntLock( void );
 extern void FitIntUnlock( void );
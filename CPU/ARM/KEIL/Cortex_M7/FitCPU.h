@@ -69,6 +69,25 @@ extern "C" {
 #define FitIsInsideISR()            ( ( uOSBool_t ) ( FitGetIPSR() != ( uOSBase_t )0 ) )
 
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#define FitMemoryBarrier()          __dmb( 15 )
+
+/* Cycle counter, used to time the kernel primitives. */
+#define FitDEMCR_REG                            ( * ( ( volatile uOS32_t * ) 0xe000edfc ) )
+#define FitDWT_CTRL_REG                         ( * ( ( volatile uOS32_t * ) 0xe0001000 ) )
+#define FitDWT_CYCCNT_REG                       ( * ( ( volatile uOS32_t * ) 0xe0001004 ) )
+#define FitDWT_LAR_REG                          ( * ( ( volatile uOS32_t * ) 0xe0001fb0 ) )
+#define FitDWT_LAR_UNLOCK_KEY                   ( 0xc5acce55UL )
+#define FitDEMCR_TRCENA_BIT                     ( 1UL << 24UL )
+#define FitDWT_CYCCNTENA_BIT                    ( 1UL << 0UL )
+
+#define FitCycleCounterInit()                                                    \
+{                                                                                \
+    FitDEMCR_REG |= FitDEMCR_TRCENA_BIT;                                         \
+    FitDWT_LAR_REG = FitDWT_LAR_UNLOCK_KEY;                                      \
+    FitDWT_CYCCNT_REG = 0UL;                                                     \
+    FitDWT_CTRL_REG |= FitDWT_CYCCNTENA_BIT;                                     \
+}
+#define FitGetCycleCount()                      ( FitDWT_CYCCNT_REG )
 
 extern void FitIntLock( void );
 extern void FitIntUnlock( void );
@@ -80,10 +99,8 @@ extern uOS32_t FitGetIPSR( void );
 #define FitIntMaskFromISR()         FitIntMask()
 #define FitIntUnmaskFromISR( x )    FitIntUnmask( x )
 
-#if (OSHIGHEAST_PRIORITY<=32U)
 #define FITQUICK_GET_PRIORITY      ( 1U )
 #define FitGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __clz( ( uxReadyPriorities ) ) )
-#endif
 
 #ifndef FIT_FORCE_INLINE
     #define FIT_FORCE_INLINE __forceinline
@@ -77,6 +77,7 @@ extern "C" {
 /* Task utilities. */
 void FitSchedule( void ) __naked;
 #define FitScheduleFromISR( b )     if( b ) FitSchedule()
+#define FitMemoryBarrier()
 /*-----------------------------------------------------------*/
 
 #define FitNOP()                __asm    \
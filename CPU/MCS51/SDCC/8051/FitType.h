@@ -48,8 +48,8 @@ typedef unsigned   char            uOS8_t;
 typedef char                       sOS8_t;
 typedef unsigned   short           uOS16_t;
 typedef signed     short           sOS16_t;
-typedef unsigned   int             uOS32_t;
-typedef signed     int             sOS32_t;
+typedef unsigned   long            uOS32_t;
+typedef signed     long            sOS32_t;
 
 
 typedef        uOS8_t              uOSStack_t;
@@ -59,6 +59,7 @@ typedef        uOS16_t             uOSTick_t;
 
 #define        FITSTACK_GROWTH     ( 1 )
 #define        FITBYTE_ALIGNMENT   ( 1 )
+#define        FITBASE_MAX         ( 0xFFU )
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,436 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+/* Host includes. */
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Every task runs on a host stack of this size.  The stack allocated by the
+kernel only holds a pointer to the task context, host library code such as
+printf() needs far more room than a task on the target would. */
+#ifndef SETHW_HOST_STACK_SIZE
+    #define FitHOST_STACK_SIZE              ( 256U * 1024U )
+#else
+    #define FitHOST_STACK_SIZE              ( SETHW_HOST_STACK_SIZE )
+#endif
+
+/* The tick interrupt is emulated by an interval timer signal. */
+#define FitTICK_SIGNAL                      ( SIGALRM )
+#define FitTICK_PERIOD_US                   ( 1000000UL / OSTICK_RATE_HZ )
+
+#define FitCompilerBarrier()                __asm volatile( "" ::: "memory" )
+
+typedef struct tFitTaskContext
+{
+    ucontext_t                  tContext;
+    OSTaskFunction_t            pxTaskFunction;
+    void *                      pvParameters;
+    struct tFitTaskContext *    ptNext;         /*< All contexts, released when the scheduler ends. */
+} tFitTaskContext_t;
+
+/* The first item in the TCB is the top of stack, where FitInitializeStack()
+left the pointer to the task context. */
+#define FitGetContext( ptTCB )              ( ( tFitTaskContext_t * ) ( *( ( ptTCB )->puxTopOfStack ) ) )
+
+extern tOSTCB_t * volatile gptCurrentTCB;
+
+/* Emulated interrupt state.  The signal handler only does its work while the
+interrupts are unmasked, otherwise it leaves the tick pending and the work is
+done when the mask is lifted, the same way an NVIC holds a masked interrupt. */
+static volatile sig_atomic_t gbIntMasked            = 1;
+static volatile sig_atomic_t gbInsideISR            = 0;
+static volatile sig_atomic_t gbTickPending          = 0;
+static volatile sig_atomic_t gbSchedulePending      = 0;
+
+/* Each task maintains its own interrupt status in the lock nesting
+variable. */
+static uOSBase_t guxIntLocked = 0xaaaaaaaa;
+
+static ucontext_t gtMainContext;
+static struct sigaction gtOldTickAction;
+static tFitTaskContext_t *gptContextList = OS_NULL;
+
+/*
+ * Setup the timer to generate the tick interrupts.  The implementation in this
+ * file is weak to allow application writers to change the timer used to
+ * generate the tick interrupt.
+ */
+void FitSetupTimerInterrupt( void );
+static void FitStopTimerInterrupt( void );
+
+static void FitTaskEntry( void );
+static void FitTaskExitError( void );
+static void FitServiceInterrupts( void );
+
+uOSStack_t *FitInitializeStack( uOSStack_t *pxTopOfStack,
+        OSTaskFunction_t TaskFunction, void *pvParameters )
+{
+    tFitTaskContext_t *ptContext = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    /* The host allocator is not reentrant, keep the tick away from it. */
+    uxIntSave = FitIntMask();
+    {
+        ptContext = ( tFitTaskContext_t * ) malloc( sizeof( tFitTaskContext_t ) + FitHOST_STACK_SIZE );
+        if( ptContext != OS_NULL )
+        {
+            ptContext->ptNext = gptContextList;
+            gptContextList = ptContext;
+        }
+    }
+    FitIntUnmask( uxIntSave );
+
+    if( ptContext == OS_NULL )
+    {
+        fprintf( stderr, "TINIUX: no host memory for a task stack\n" );
+        abort();
+    }
+
+    ptContext->pxTaskFunction = TaskFunction;
+    ptContext->pvParameters = pvParameters;
+
+    getcontext( &( ptContext->tContext ) );
+    ptContext->tContext.uc_stack.ss_sp = ( void * ) ( ptContext + 1 );
+    ptContext->tContext.uc_stack.ss_size = FitHOST_STACK_SIZE;
+    ptContext->tContext.uc_link = OS_NULL;
+    sigdelset( &( ptContext->tContext.uc_sigmask ), FitTICK_SIGNAL );
+    makecontext( &( ptContext->tContext ), FitTaskEntry, 0 );
+
+    /* Leave the context where the switch code can find it from the TCB. */
+    *pxTopOfStack = ( uOSStack_t ) ptContext;
+
+    return pxTopOfStack;
+}
+
+static void FitTaskEntry( void )
+{
+    tFitTaskContext_t * const ptContext = FitGetContext( gptCurrentTCB );
+
+    /* A task is always entered from a context switch, which has the
+    interrupts masked. */
+    FitIntUnmask( 0 );
+
+    ptContext->pxTaskFunction( ptContext->pvParameters );
+
+    FitTaskExitError();
+}
+
+static void FitTaskExitError( void )
+{
+    /* A function that implements a task must not exit or attempt to return to
+    its caller as there is nothing to return to.  If a task wants to exit it
+    should instead call OSTaskDelete( OS_NULL ).*/
+
+    FitIntMask();
+    fprintf( stderr, "TINIUX: task %s returned from its function\n", gptCurrentTCB->pcTaskName );
+    abort();
+}
+
+static void FitSwitchContext( void )
+{
+    tFitTaskContext_t *ptOldContext = OS_NULL;
+    tFitTaskContext_t *ptNewContext = OS_NULL;
+    int iErrno = 0;
+
+    /* This is the PendSV handler, it runs with the interrupts masked. */
+    gbSchedulePending = 0;
+
+    ptOldContext = FitGetContext( gptCurrentTCB );
+    OSTaskSwitchContext();
+    ptNewContext = FitGetContext( gptCurrentTCB );
+
+    if( ptOldContext != ptNewContext )
+    {
+        /* errno belongs to the host thread that all tasks share. */
+        iErrno = errno;
+        swapcontext( &( ptOldContext->tContext ), &( ptNewContext->tContext ) );
+        errno = iErrno;
+    }
+}
+
+static void FitServiceInterrupts( void )
+{
+    /* Run whatever was held pending while the interrupts were masked, the tick
+    first, then the context switch it may have requested. */
+    while( ( gbInsideISR == 0 ) && ( ( gbTickPending != 0 ) || ( gbSchedulePending != 0 ) ) )
+    {
+        gbIntMasked = 1;
+        FitCompilerBarrier();
+
+        if( gbTickPending != 0 )
+        {
+            gbTickPending = 0;
+            gbInsideISR = 1;
+            FitOSTickISR();
+            gbInsideISR = 0;
+        }
+
+        if( gbSchedulePending != 0 )
+        {
+            FitSwitchContext();
+        }
+
+        FitCompilerBarrier();
+        gbIntMasked = 0;
+    }
+}
+
+static void FitTickSignalHandler( int iSignal )
+{
+    const int iErrno = errno;
+
+    ( void ) iSignal;
+
+    gbTickPending = 1;
+    if( gbIntMasked == 0 )
+    {
+        FitServiceInterrupts();
+    }
+
+    errno = iErrno;
+}
+
+void FitSchedule( void )
+{
+    /* Pend the switch, it is performed as soon as the interrupts are unmasked
+    and no ISR is running. */
+    gbSchedulePending = 1;
+    if( gbIntMasked == 0 )
+    {
+        FitServiceInterrupts();
+    }
+}
+
+uOSBase_t FitIntMask( void )
+{
+    uOSBase_t uxIntSave = ( uOSBase_t ) gbIntMasked;
+
+    gbIntMasked = 1;
+    FitCompilerBarrier();
+
+    return uxIntSave;
+}
+
+void FitIntUnmask( uOSBase_t uxIntSave )
+{
+    FitCompilerBarrier();
+    gbIntMasked = ( sig_atomic_t ) uxIntSave;
+
+    if( uxIntSave == 0 )
+    {
+        FitServiceInterrupts();
+    }
+}
+
+uOS32_t FitGetCycleCount( void )
+{
+    struct timespec tNow;
+
+    clock_gettime( CLOCK_MONOTONIC, &tNow );
+
+    return ( uOS32_t ) ( ( ( unsigned long long ) tNow.tv_sec * 1000000000ULL ) + ( unsigned long long ) tNow.tv_nsec );
+}
+
+uOSBool_t FitIsInsideISR( void )
+{
+    return ( uOSBool_t ) ( gbInsideISR != 0 );
+}
+
+void FitIntLock( void )
+{
+    FitIntMask();
+    guxIntLocked++;
+}
+
+void FitIntUnlock( void )
+{
+    guxIntLocked--;
+    if( guxIntLocked == 0 )
+    {
+        FitIntUnmask( 0 );
+    }
+}
+
+void FitOSTickISR( void )
+{
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = FitIntMaskFromISR();
+    {
+        /* Increment the RTOS tick. */
+        if( OSIncrementTickCount() != OS_FALSE )
+        {
+            /* A context switch is required, it is performed when the ISR
+            returns. */
+            gbSchedulePending = 1;
+        }
+    }
+    FitIntUnmaskFromISR( uxIntSave );
+}
+
+uOSBase_t FitStartScheduler( void )
+{
+    struct sigaction tAction;
+    tFitTaskContext_t *ptContext = OS_NULL;
+
+    /* Initialise the lock nesting count ready for the first task, which
+    unmasks the interrupts when it is entered. */
+    guxIntLocked = 0;
+    gbIntMasked = 1;
+
+    memset( &tAction, 0, sizeof( tAction ) );
+    tAction.sa_handler = FitTickSignalHandler;
+    tAction.sa_flags = SA_RESTART;
+    sigemptyset( &( tAction.sa_mask ) );
+    sigaction( FitTICK_SIGNAL, &tAction, &gtOldTickAction );
+
+    /* Start the timer that generates the tick ISR. */
+    FitSetupTimerInterrupt();
+
+    /* Start the first task. */
+    swapcontext( &gtMainContext, &( FitGetContext( gptCurrentTCB )->tContext ) );
+
+    /* FitEndScheduler() returns here. */
+    FitStopTimerInterrupt();
+    sigaction( FitTICK_SIGNAL, &gtOldTickAction, OS_NULL );
+
+    while( gptContextList != OS_NULL )
+    {
+        ptContext = gptContextList;
+        gptContextList = ptContext->ptNext;
+        free( ptContext );
+    }
+
+    return 0;
+}
+
+void FitEndScheduler( void )
+{
+    /* Leave the tasks behind and go back to the caller of OSStart(). */
+    FitIntMask();
+    FitStopTimerInterrupt();
+    setcontext( &gtMainContext );
+}
+
+#if( OS_LOWPOWER_ON!=0 )
+__attribute__((weak)) void FitTicklessIdle( uOSTick_t uxLowPowerTicks )
+{
+    struct timespec tStart, tEnd, tSleep;
+    unsigned long long ullSleptUs = 0ULL;
+    uOSTick_t uxCompleteLowPowerTicks = (uOSTick_t)0U;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = FitIntMask();
+
+    /* Ensure it is still ok to enter the sleep mode.  The timer is left
+    running otherwise, restarting it would delay the next tick by up to a
+    whole period every time the idle task tries. */
+    if( OSEnableLowPowerIdle() != OS_FALSE )
+    {
+        /* Stop the timer that is generating the tick interrupt. */
+        FitStopTimerInterrupt();
+
+        /* -1 is used because this code will execute part way through one of
+        the tick periods. */
+        ullSleptUs = ( unsigned long long ) FitTICK_PERIOD_US * ( uxLowPowerTicks - 1U );
+        tSleep.tv_sec = ( time_t ) ( ullSleptUs / 1000000ULL );
+        tSleep.tv_nsec = ( long ) ( ( ullSleptUs % 1000000ULL ) * 1000ULL );
+
+        /* Any other signal ends the sleep early, like an interrupt would. */
+        clock_gettime( CLOCK_MONOTONIC, &tStart );
+        ( void ) nanosleep( &tSleep, OS_NULL );
+        clock_gettime( CLOCK_MONOTONIC, &tEnd );
+
+        ullSleptUs = ( unsigned long long ) ( tEnd.tv_sec - tStart.tv_sec ) * 1000000ULL;
+        ullSleptUs += ( unsigned long long ) ( ( tEnd.tv_nsec - tStart.tv_nsec ) / 1000L );
+        uxCompleteLowPowerTicks = ( uOSTick_t ) ( ullSleptUs / FitTICK_PERIOD_US );
+        if( uxCompleteLowPowerTicks > ( uxLowPowerTicks - 1U ) )
+        {
+            uxCompleteLowPowerTicks = uxLowPowerTicks - 1U;
+        }
+
+        /* Correct the kernels tick count to account for the time spent in the
+        low power state. */
+        OSFixTickCount( uxCompleteLowPowerTicks );
+
+        /* Restart the timer that is generating the tick interrupt. */
+        FitSetupTimerInterrupt();
+    }
+
+    FitIntUnmask( uxIntSave );
+}
+#endif /* OS_LOWPOWER_ON */
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the interval timer to generate the tick interrupts at the required
+ * frequency.
+ */
+__attribute__(( weak )) void FitSetupTimerInterrupt( void )
+{
+    struct itimerval tTimer;
+
+    tTimer.it_interval.tv_sec = ( time_t ) ( FitTICK_PERIOD_US / 1000000UL );
+    tTimer.it_interval.tv_usec = ( suseconds_t ) ( FitTICK_PERIOD_US % 1000000UL );
+    tTimer.it_value = tTimer.it_interval;
+
+    setitimer( ITIMER_REAL, &tTimer, OS_NULL );
+}
+
+static void FitStopTimerInterrupt( void )
+{
+    struct itimerval tTimer;
+
+    memset( &tTimer, 0, sizeof( tTimer ) );
+    setitimer( ITIMER_REAL, &tTimer, OS_NULL );
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,364 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_EVENT_ON!=0 )
+
+/* Set in the options of a waiting task once a setter has woken it. */
+TINIUX_DATA static uOS8_t const EVENT_WAIT_SATISFIED              = ( ( uOS8_t ) 0x80U );
+
+static uOSBool_t OSEventFlagsIsMatched( const uOS32_t uiFlags, const uOS32_t uiFlagsToWait, const uOS8_t ucOptions )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( ( ucOptions & OSEVENT_WAIT_ALL ) != 0U )
+    {
+        bReturn = ( uOSBool_t ) ( ( uiFlags & uiFlagsToWait ) == uiFlagsToWait );
+    }
+    else
+    {
+        bReturn = ( uOSBool_t ) ( ( uiFlags & uiFlagsToWait ) != 0UL );
+    }
+
+    return bReturn;
+}
+
+/* Wake every task whose wait is satisfied by the current flags, must be
+called with the interrupts locked or masked. */
+static uOSBool_t OSEventFlagsWakeWaiters( tOSEventFlags_t * const ptEventFlags )
+{
+    tOSList_t * const ptList = &( ptEventFlags->tTaskListEventFlags );
+    tOSListItem_t *ptIterator = OS_NULL;
+    tOSTCB_t *ptTCB = OS_NULL;
+    const uOS32_t uiFlags = ptEventFlags->uiFlags;
+    uOS32_t uiFlagsToClear = 0UL;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    /* All the waiters are checked against the same flags, the ones to be
+    cleared automatically are only cleared after the whole list is done. */
+    ptIterator = OSListGetHeadItem( ptList );
+    while( ptIterator != OSListGetEndMarkerItem( ptList ) )
+    {
+        ptTCB = ( tOSTCB_t * ) OSListItemGetHolder( ptIterator );
+        ptIterator = OSListItemGetNextItem( ptIterator );
+
+        if( OSEventFlagsIsMatched( uiFlags, ptTCB->uiEventFlags, ptTCB->ucEventOptions ) != OS_FALSE )
+        {
+            if( ( ptTCB->ucEventOptions & OSEVENT_AUTO_CLEAR ) != 0U )
+            {
+                uiFlagsToClear |= ptTCB->uiEventFlags;
+            }
+
+            /* Hand the flags which satisfied the wait over to the task. */
+            ptTCB->uiEventFlags = uiFlags;
+            ptTCB->ucEventOptions |= EVENT_WAIT_SATISFIED;
+
+            if( OSTaskListEventRemoveTask( ptTCB ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    ptEventFlags->uiFlags = uiFlags & ~uiFlagsToClear;
+
+    return bNeedSchedule;
+}
+
+static void OSEventFlagsInitNew( tOSEventFlags_t * const ptNewEventFlags )
+{
+    ptNewEventFlags->pcEventName[ 0 ] = '\0';
+    OSListInit( &( ptNewEventFlags->tTaskListEventFlags ) );
+    ptNewEventFlags->uiFlags = 0UL;
+    ptNewEventFlags->xID = 0;
+}
+
+OSEventFlagsHandle_t OSEventFlagsCreate( void )
+{
+    tOSEventFlags_t *ptNewEventFlags = OS_NULL;
+
+    ptNewEventFlags = ( tOSEventFlags_t * ) OSMemMalloc( sizeof( tOSEventFlags_t ) );
+
+    if( ptNewEventFlags != OS_NULL )
+    {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewEventFlags->ucStaticAlloc = OS_FALSE;
+#endif
+        OSEventFlagsInitNew( ptNewEventFlags );
+    }
+
+    return ptNewEventFlags;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSEventFlagsHandle_t OSEventFlagsCreateStatic( tOSEventFlags_t * const ptEventFlagsBuffer )
+{
+    if( ptEventFlagsBuffer != OS_NULL )
+    {
+        ptEventFlagsBuffer->ucStaticAlloc = OS_TRUE;
+        OSEventFlagsInitNew( ptEventFlagsBuffer );
+    }
+
+    return ptEventFlagsBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSEventFlagsDelete( OSEventFlagsHandle_t EventFlagsHandle )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+
+    OSMemFreeObject( ptEventFlags );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSEventFlagsSetID(OSEventFlagsHandle_t EventFlagsHandle, sOSBase_t xID)
+{
+    if(EventFlagsHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        EventFlagsHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSEventFlagsGetID(OSEventFlagsHandle_t const EventFlagsHandle)
+{
+    sOSBase_t xID = 0;
+    
+    OSIntLock();
+    if(EventFlagsHandle != OS_NULL)
+    {
+        xID = EventFlagsHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+uOS32_t OSEventFlagsGet( OSEventFlagsHandle_t const EventFlagsHandle )
+{
+    uOS32_t uiReturn = 0UL;
+
+    OSIntLock();
+    {
+        uiReturn = ( ( tOSEventFlags_t * ) EventFlagsHandle )->uiFlags;
+    }
+    OSIntUnlock();
+
+    return uiReturn;
+}
+
+uOS32_t OSEventFlagsGetFromISR( OSEventFlagsHandle_t const EventFlagsHandle )
+{
+    uOS32_t uiReturn = 0UL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uiReturn = ( ( tOSEventFlags_t * ) EventFlagsHandle )->uiFlags;
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return uiReturn;
+}
+
+uOS32_t OSEventFlagsSet( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToSet )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+    uOS32_t uiReturn = 0UL;
+
+    OSIntLock();
+    {
+        ptEventFlags->uiFlags |= uiFlagsToSet;
+
+        if( OSListIsEmpty( &( ptEventFlags->tTaskListEventFlags ) ) == OS_FALSE )
+        {
+            if( OSEventFlagsWakeWaiters( ptEventFlags ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+        }
+
+        uiReturn = ptEventFlags->uiFlags;
+    }
+    OSIntUnlock();
+
+    return uiReturn;
+}
+
+uOS32_t OSEventFlagsSetFromISR( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToSet )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+    uOS32_t uiReturn = 0UL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        ptEventFlags->uiFlags |= uiFlagsToSet;
+
+        if( OSListIsEmpty( &( ptEventFlags->tTaskListEventFlags ) ) == OS_FALSE )
+        {
+            bNeedSchedule = OSEventFlagsWakeWaiters( ptEventFlags );
+        }
+
+        uiReturn = ptEventFlags->uiFlags;
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return uiReturn;
+}
+
+uOS32_t OSEventFlagsClear( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToClear )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+    uOS32_t uiReturn = 0UL;
+
+    OSIntLock();
+    {
+        uiReturn = ptEventFlags->uiFlags;
+        ptEventFlags->uiFlags = uiReturn & ~uiFlagsToClear;
+    }
+    OSIntUnlock();
+
+    return uiReturn;
+}
+
+uOS32_t OSEventFlagsClearFromISR( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToClear )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+    uOS32_t uiReturn = 0UL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uiReturn = ptEventFlags->uiFlags;
+        ptEventFlags->uiFlags = uiReturn & ~uiFlagsToClear;
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return uiReturn;
+}
+
+uOSBool_t OSEventFlagsWait( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToWait, const uOS8_t ucOptions, uOS32_t * const puiFlags, uOSTick_t uxTicksToWait )
+{
+    tOSEventFlags_t * const ptEventFlags = ( tOSEventFlags_t * ) EventFlagsHandle;
+    tOSTCB_t * const ptTCB = ( tOSTCB_t * ) OSGetCurrentTaskHandle();
+    uOS32_t uiFlags = 0UL;
+    uOSBool_t bBlocked = OS_FALSE;
+    uOSBool_t bReturn = OS_FALSE;
+
+    if( uiFlagsToWait == 0UL )
+    {
+        return OS_FALSE;
+    }
+
+    OSIntLock();
+    {
+        uiFlags = ptEventFlags->uiFlags;
+
+        if( OSEventFlagsIsMatched( uiFlags, uiFlagsToWait, ucOptions ) != OS_FALSE )
+        {
+            if( ( ucOptions & OSEVENT_AUTO_CLEAR ) != 0U )
+            {
+                ptEventFlags->uiFlags = uiFlags & ~uiFlagsToWait;
+            }
+            bReturn = OS_TRUE;
+        }
+        else if( uxTicksToWait > ( uOSTick_t ) 0U )
+        {
+            /* The setters check the wait against the flags on behalf of this
+            task, so it only runs again once it is satisfied or timed out. */
+            ptTCB->uiEventFlags = uiFlagsToWait;
+            ptTCB->ucEventOptions = ucOptions & ( OSEVENT_WAIT_ALL | OSEVENT_AUTO_CLEAR );
+
+            OSTaskListEventAdd( &( ptEventFlags->tTaskListEventFlags ), uxTicksToWait );
+            bBlocked = OS_TRUE;
+
+            OSSchedule();
+        }
+    }
+    OSIntUnlock();
+
+    if( bBlocked != OS_FALSE )
+    {
+        OSIntLock();
+        {
+            if( ( ptTCB->ucEventOptions & EVENT_WAIT_SATISFIED ) != 0U )
+            {
+                uiFlags = ptTCB->uiEventFlags;
+                bReturn = OS_TRUE;
+            }
+            else
+            {
+                /* The wait timed out. */
+                uiFlags = ptEventFlags->uiFlags;
+            }
+            ptTCB->ucEventOptions = 0U;
+        }
+        OSIntUnlock();
+    }
+
+    if( puiFlags != OS_NULL )
+    {
+        *puiFlags = uiFlags;
+    }
+
+    return bReturn;
+}
+
+#endif //( OS_EVENT_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
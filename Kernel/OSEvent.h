@@ -0,0 +1,97 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_EVENT_H_
+#define __OS_EVENT_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_EVENT_ON!=0 )
+
+// Options of OSEventFlagsWait
+#define OSEVENT_WAIT_ANY                ( ( uOS8_t ) 0x00U )  // Wake when any of the flags is set
+#define OSEVENT_WAIT_ALL                ( ( uOS8_t ) 0x01U )  // Wake when all of the flags are set
+#define OSEVENT_AUTO_CLEAR              ( ( uOS8_t ) 0x02U )  // Clear the flags waited for before returning
+
+typedef struct tOSEventFlags
+{
+    char                        pcEventName[ OSNAME_MAX_LEN ];
+
+    tOSList_t                   tTaskListEventFlags;  // Event flags Wait TaskList;
+
+    volatile uOS32_t            uiFlags;
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;        // OS_TRUE if the memory was given by the application;
+#endif
+
+    sOSBase_t                   xID;
+} tOSEventFlags_t;
+
+typedef tOSEventFlags_t* OSEventFlagsHandle_t;
+
+OSEventFlagsHandle_t OSEventFlagsCreate( void ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSEventFlagsHandle_t OSEventFlagsCreateStatic( tOSEventFlags_t * const ptEventFlagsBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_MEMFREE_ON != 0 )
+void              OSEventFlagsDelete( OSEventFlagsHandle_t EventFlagsHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSEventFlagsSetID(OSEventFlagsHandle_t EventFlagsHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSEventFlagsGetID(OSEventFlagsHandle_t const EventFlagsHandle) TINIUX_FUNCTION;
+
+uOS32_t           OSEventFlagsGet( OSEventFlagsHandle_t const EventFlagsHandle ) TINIUX_FUNCTION;
+uOS32_t           OSEventFlagsGetFromISR( OSEventFlagsHandle_t const EventFlagsHandle ) TINIUX_FUNCTION;
+uOS32_t           OSEventFlagsSet( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToSet ) TINIUX_FUNCTION;
+uOS32_t           OSEventFlagsSetFromISR( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToSet ) TINIUX_FUNCTION;
+uOS32_t           OSEventFlagsClear( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToClear ) TINIUX_FUNCTION;
+uOS32_t           OSEventFlagsClearFromISR( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToClear ) TINIUX_FUNCTION;
+
+uOSBool_t         OSEventFlagsWait( OSEventFlagsHandle_t EventFlagsHandle, const uOS32_t uiFlagsToWait, const uOS8_t ucOptions, uOS32_t * const puiFlags, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+
+#endif //( OS_EVENT_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_EVENT_H_
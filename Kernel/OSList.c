@@ -183,6 +183,83 @@ uOSBase_t OSListRemoveItem( tOSListItem_t * const ptItemToRemove )
     return ptList->uxNumberOfItems;
 }
 
+/*****************************************************************************
+Function    : OSListWheelInit 
+Description : Initialise a timing wheel and all of its slots. 
+Input       : ptWheel -- Pointer of the wheel to be initialised.
+              ptSlots -- Array of uxSlotNum lists used as the slots.
+              uxSlotNum -- Number of slots, must be a power of two.
+Output      : None 
+Return      : None 
+*****************************************************************************/
+void OSListWheelInit( tOSListWheel_t * const ptWheel, tOSList_t * const ptSlots, const uOSBase_t uxSlotNum )
+{
+    uOSBase_t uxSlot = ( uOSBase_t ) 0U;
+
+    for( uxSlot = ( uOSBase_t ) 0U; uxSlot < uxSlotNum; uxSlot++ )
+    {
+        OSListInit( &( ptSlots[ uxSlot ] ) );
+    }
+
+    ptWheel->ptSlots = ptSlots;
+    ptWheel->uxSlotMask = ( uOSTick_t ) ( uxSlotNum - ( uOSBase_t ) 1U );
+}
+
+/*****************************************************************************
+Function    : OSListWheelInsertItem 
+Description : Insert a list item into the slot of its uxItemValue, slots are
+              not sorted so this takes constant time. 
+Input       : ptWheel -- Pointer of the wheel to be inserted.
+              ptNewListItem -- Pointer of a new list item.
+Output      : None 
+Return      : None 
+*****************************************************************************/
+void OSListWheelInsertItem( tOSListWheel_t * const ptWheel, tOSListItem_t * const ptNewListItem )
+{
+    OSListInsertItemToEnd( OSListWheelGetSlot( ptWheel, ptNewListItem->uxItemValue ), ptNewListItem );
+}
+
+/*****************************************************************************
+Function    : OSListWheelGetNextDelta 
+Description : Find the smallest distance from uxValueNow to the value of an
+              item in the wheel.  The slots are visited in order from the one
+              of uxValueNow, and the walk stops as soon as no later slot can
+              hold a nearer item. 
+Input       : ptWheel -- Pointer of the wheel.
+              uxValueNow -- Value the distances are measured from.
+Output      : None 
+Return      : The smallest distance, OSPEND_FOREVER_VALUE if the wheel is empty.
+*****************************************************************************/
+uOSTick_t OSListWheelGetNextDelta( tOSListWheel_t * const ptWheel, const uOSTick_t uxValueNow )
+{
+    tOSList_t *ptSlot = OS_NULL;
+    tOSListItem_t *ptIterator = OS_NULL;
+    uOSTick_t uxOffset = ( uOSTick_t ) 0U;
+    uOSTick_t uxDelta = ( uOSTick_t ) 0U;
+    uOSTick_t uxNextDelta = OSPEND_FOREVER_VALUE;
+
+    for( uxOffset = ( uOSTick_t ) 0U; uxOffset <= ptWheel->uxSlotMask; uxOffset++ )
+    {
+        ptSlot = OSListWheelGetSlot( ptWheel, ( uOSTick_t ) ( uxValueNow + uxOffset ) );
+        for( ptIterator = OSListGetHeadItem( ptSlot ); ptIterator != OSListGetEndMarkerItem( ptSlot ); ptIterator = ptIterator->ptNext )
+        {
+            uxDelta = ( uOSTick_t ) ( ptIterator->uxItemValue - uxValueNow );
+            if( uxDelta < uxNextDelta )
+            {
+                uxNextDelta = uxDelta;
+            }
+        }
+
+        /* Every item in a later slot is at least uxOffset + 1 away. */
+        if( uxNextDelta <= ( uOSTick_t ) ( uxOffset + ( uOSTick_t ) 1U ) )
+        {
+            break;
+        }
+    }
+
+    return uxNextDelta;
+}
+
 #ifdef __cplusplus
 }
 #endif
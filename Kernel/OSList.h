@@ -62,6 +62,13 @@ typedef struct OSList
     tOSListItem_t                       tNilItem;            //tNilItem as sentinel item.
 } tOSList_t;
 
+//hashed timing wheel, the item with value x is kept unsorted in slot x modulo the wheel size.
+typedef struct OSListWheel
+{
+    tOSList_t *                         ptSlots;
+    uOSTick_t                           uxSlotMask;
+} tOSListWheel_t;
+
 #define OSListItemSetHolder( ptListItem, pxHolder )         ( ( ptListItem )->pvHolder = ( void * ) ( pxHolder ) )
 #define OSListItemGetHolder( ptListItem )                   ( ( ptListItem )->pvHolder )
 #define OSListItemSetValue( ptListItem, xValue )            ( ( ptListItem )->uxItemValue = ( xValue ) )
@@ -90,6 +97,9 @@ typedef struct OSList
 
 #define OSListGetHeadItemHolder( ptList )                   ( (&( ( ptList )->tNilItem ))->ptNext->pvHolder )
 #define OSListContainListItem( ptList, ptListItem )         ( ( uOSBool_t ) ( ( ptListItem )->pvList == ( void * ) ( ptList ) ) )
+#define OSListWheelGetSlot( ptWheel, uxValue )              ( &( ( ptWheel )->ptSlots[ ( uxValue ) & ( ptWheel )->uxSlotMask ] ) )
+#define OSListWheelContainListItem( ptWheel, ptListItem )   ( ( uOSBool_t ) ( ( ( tOSList_t * ) ( ptListItem )->pvList >= ( ptWheel )->ptSlots ) && \
+                                                                          ( ( tOSList_t * ) ( ptListItem )->pvList <= &( ( ptWheel )->ptSlots[ ( ptWheel )->uxSlotMask ] ) ) ) )
 #define OSListIsInitialised( ptList )                       ( ( uOSBool_t ) ( ( ptList )->tNilItem.uxItemValue == OSPEND_FOREVER_VALUE ) )
 
 void OSListItemInitialise( tOSListItem_t * const ptListItem );
@@ -99,6 +109,10 @@ void OSListInsertItem( tOSList_t * const ptList, tOSListItem_t * const ptNewList
 void OSListInsertItemToEnd( tOSList_t * const ptList, tOSListItem_t * const ptNewListItem );
 uOSBase_t OSListRemoveItem( tOSListItem_t * const ptItemToRemove );
 
+void OSListWheelInit( tOSListWheel_t * const ptWheel, tOSList_t * const ptSlots, const uOSBase_t uxSlotNum );
+void OSListWheelInsertItem( tOSListWheel_t * const ptWheel, tOSListItem_t * const ptNewListItem );
+uOSTick_t OSListWheelGetNextDelta( tOSListWheel_t * const ptWheel, const uOSTick_t uxValueNow );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,345 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MEMPOOL_ON!=0 )
+
+static void OSMemPoolInitNew( tOSMemPool_t * const ptNewMemPool, uOS8_t * const pucStorage, const uOSBase_t uxBlockSize, const uOSBase_t uxBlockNum )
+{
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+    uOS8_t *pucBlock = pucStorage;
+
+    ptNewMemPool->pcMemPoolName[ 0 ] = '\0';
+    ptNewMemPool->pucBuffer = pucStorage;
+    ptNewMemPool->uxBlockSize = uxBlockSize;
+    ptNewMemPool->uxBlockNum = uxBlockNum;
+
+    /* Chain every block to the one after it. */
+    for( uxIndex = ( uOSBase_t ) 1U; uxIndex < uxBlockNum; uxIndex++ )
+    {
+        *( ( void ** ) pucBlock ) = ( void * ) ( pucBlock + uxBlockSize );
+        pucBlock += uxBlockSize;
+    }
+    *( ( void ** ) pucBlock ) = OS_NULL;
+    ptNewMemPool->pvFreeList = ( void * ) pucStorage;
+
+    OSListInit( &( ptNewMemPool->tTaskListEventMemPool ) );
+
+    ptNewMemPool->uxFreeNum = uxBlockNum;
+    ptNewMemPool->uxMinFreeNum = uxBlockNum;
+    ptNewMemPool->xID = 0;
+}
+
+static void * OSMemPoolTake( tOSMemPool_t * const ptMemPool )
+{
+    void *pvBlock = ptMemPool->pvFreeList;
+
+    if( pvBlock != OS_NULL )
+    {
+        ptMemPool->pvFreeList = *( ( void ** ) pvBlock );
+        ptMemPool->uxFreeNum--;
+        if( ptMemPool->uxFreeNum < ptMemPool->uxMinFreeNum )
+        {
+            ptMemPool->uxMinFreeNum = ptMemPool->uxFreeNum;
+        }
+    }
+
+    return pvBlock;
+}
+
+static uOSBool_t OSMemPoolGive( tOSMemPool_t * const ptMemPool, void * pvBlock )
+{
+    uOSAddr_t uxOffset = ( uOSAddr_t ) pvBlock - ( uOSAddr_t ) ptMemPool->pucBuffer;
+#if ( OS_MEMPOOL_CHECK_ON!=0 )
+    void *pvFree = OS_NULL;
+#endif /* OS_MEMPOOL_CHECK_ON */
+
+    /* Only a block of this pool may be given back. */
+    if( ( uxOffset >= ( ( uOSAddr_t ) ptMemPool->uxBlockSize * ( uOSAddr_t ) ptMemPool->uxBlockNum ) ) ||
+        ( ( uxOffset % ( uOSAddr_t ) ptMemPool->uxBlockSize ) != ( uOSAddr_t ) 0U ) )
+    {
+        return OS_FALSE;
+    }
+
+    /* With every block free already, this one is given back twice. */
+    if( ptMemPool->uxFreeNum >= ptMemPool->uxBlockNum )
+    {
+        return OS_FALSE;
+    }
+
+#if ( OS_MEMPOOL_CHECK_ON!=0 )
+    /* While other blocks are in use, a block given back twice can only be
+    found on the free list. */
+    for( pvFree = ptMemPool->pvFreeList; pvFree != OS_NULL; pvFree = *( ( void ** ) pvFree ) )
+    {
+        if( pvFree == pvBlock )
+        {
+            return OS_FALSE;
+        }
+    }
+#endif /* OS_MEMPOOL_CHECK_ON */
+
+    *( ( void ** ) pvBlock ) = ptMemPool->pvFreeList;
+    ptMemPool->pvFreeList = pvBlock;
+    ptMemPool->uxFreeNum++;
+
+    return OS_TRUE;
+}
+
+OSMemPoolHandle_t OSMemPoolCreate( const uOSBase_t uxBlockSize, const uOSBase_t uxBlockNum )
+{
+    tOSMemPool_t *ptNewMemPool = OS_NULL;
+    uOSBase_t uxRealSize = ( uOSBase_t ) 0U;
+    uOS32_t uxHeadSize = ( uOS32_t ) OSMEM_ALIGN_SIZE( sizeof( tOSMemPool_t ) );
+
+    if( ( uxBlockSize == ( uOSBase_t ) 0U ) || ( uxBlockNum == ( uOSBase_t ) 0U ) )
+    {
+        return ptNewMemPool;
+    }
+    uxRealSize = ( uOSBase_t ) OSMEMPOOL_BLOCK_SIZE( uxBlockSize );
+
+    /* The blocks are stored right after the pool, on an aligned address. */
+    ptNewMemPool = ( tOSMemPool_t * ) OSMemMalloc( uxHeadSize + ( ( uOS32_t ) uxRealSize * ( uOS32_t ) uxBlockNum ) );
+
+    if( ptNewMemPool != OS_NULL )
+    {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewMemPool->ucStaticAlloc = OS_FALSE;
+#endif
+        OSMemPoolInitNew( ptNewMemPool, ( ( uOS8_t * ) ptNewMemPool ) + uxHeadSize, uxRealSize, uxBlockNum );
+    }
+
+    return ptNewMemPool;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMemPoolHandle_t OSMemPoolCreateStatic( const uOSBase_t uxBlockSize, const uOSBase_t uxBlockNum, void * const pvStorage, tOSMemPool_t * const ptMemPoolBuffer )
+{
+    if( ( uxBlockSize == ( uOSBase_t ) 0U ) || ( uxBlockNum == ( uOSBase_t ) 0U ) || ( pvStorage == OS_NULL ) || ( ptMemPoolBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    ptMemPoolBuffer->ucStaticAlloc = OS_TRUE;
+    OSMemPoolInitNew( ptMemPoolBuffer, ( uOS8_t * ) OSMEM_ALIGN_ADDR( pvStorage ), ( uOSBase_t ) OSMEMPOOL_BLOCK_SIZE( uxBlockSize ), uxBlockNum );
+
+    return ptMemPoolBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSMemPoolDelete( OSMemPoolHandle_t MemPoolHandle )
+{
+    tOSMemPool_t * const ptMemPool = ( tOSMemPool_t * ) MemPoolHandle;
+
+    OSMemFreeObject( ptMemPool );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSMemPoolSetID(OSMemPoolHandle_t MemPoolHandle, sOSBase_t xID)
+{
+    if(MemPoolHandle == OS_NULL)
+    {
+        return (sOSBase_t)1;
+    }
+    OSIntLock();
+    {
+        MemPoolHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return (sOSBase_t)0;
+}
+
+sOSBase_t OSMemPoolGetID(OSMemPoolHandle_t const MemPoolHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(MemPoolHandle != OS_NULL)
+    {
+        xID = MemPoolHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+void * OSMemPoolAlloc( OSMemPoolHandle_t MemPoolHandle, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    void *pvBlock = OS_NULL;
+    tOSMemPool_t * const ptMemPool = ( tOSMemPool_t * ) MemPoolHandle;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            pvBlock = OSMemPoolTake( ptMemPool );
+            if( pvBlock != OS_NULL )
+            {
+                OSIntUnlock();
+                return pvBlock;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //the MemPool is empty
+                return OS_NULL;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+            {
+                OSIntUnlock();
+                //the MemPool is empty
+                return OS_NULL;
+            }
+
+            /* Try again once a block has been freed or the time is up. */
+            OSTaskListEventAdd( &( ptMemPool->tTaskListEventMemPool ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+void * OSMemPoolAllocFromISR( OSMemPoolHandle_t MemPoolHandle )
+{
+    void *pvBlock = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        pvBlock = OSMemPoolTake( ( tOSMemPool_t * ) MemPoolHandle );
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return pvBlock;
+}
+
+uOSBool_t OSMemPoolFree( OSMemPoolHandle_t MemPoolHandle, void * pvBlock )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    tOSMemPool_t * const ptMemPool = ( tOSMemPool_t * ) MemPoolHandle;
+
+    OSIntLock();
+    {
+        bReturn = OSMemPoolGive( ptMemPool, pvBlock );
+        if( bReturn != OS_FALSE )
+        {
+            if( OSListIsEmpty( &( ptMemPool->tTaskListEventMemPool ) ) == OS_FALSE )
+            {
+                if( OSTaskListEventRemove( &( ptMemPool->tTaskListEventMemPool ) ) != OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+uOSBool_t OSMemPoolFreeFromISR( OSMemPoolHandle_t MemPoolHandle, void * pvBlock )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMemPool_t * const ptMemPool = ( tOSMemPool_t * ) MemPoolHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        bReturn = OSMemPoolGive( ptMemPool, pvBlock );
+        if( bReturn != OS_FALSE )
+        {
+            if( OSListIsEmpty( &( ptMemPool->tTaskListEventMemPool ) ) == OS_FALSE )
+            {
+                bNeedSchedule = OSTaskListEventRemove( &( ptMemPool->tTaskListEventMemPool ) );
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+uOSBase_t OSMemPoolGetBlockSize( const OSMemPoolHandle_t MemPoolHandle )
+{
+    return ( ( tOSMemPool_t * ) MemPoolHandle )->uxBlockSize;
+}
+
+uOSBase_t OSMemPoolGetFreeNum( const OSMemPoolHandle_t MemPoolHandle )
+{
+    return ( ( tOSMemPool_t * ) MemPoolHandle )->uxFreeNum;
+}
+
+uOSBase_t OSMemPoolGetMaxUsedNum( const OSMemPoolHandle_t MemPoolHandle )
+{
+    uOSBase_t uxReturn = (uOSBase_t)0U;
+    tOSMemPool_t * const ptMemPool = ( tOSMemPool_t * ) MemPoolHandle;
+
+    OSIntLock();
+    {
+        uxReturn = ptMemPool->uxBlockNum - ptMemPool->uxMinFreeNum;
+    }
+    OSIntUnlock();
+
+    return uxReturn;
+}
+
+#endif //( OS_MEMPOOL_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,106 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_MEMPOOL_H_
+#define __OS_MEMPOOL_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MEMPOOL_ON!=0 )
+
+/* A partition of equal-sized blocks. The free blocks are chained through
+   their first bytes, so allocate and free are O(1) and may run in an ISR. */
+typedef struct tOSMemPool
+{
+    char                        pcMemPoolName[ OSNAME_MAX_LEN ];
+
+    uOS8_t *                    pucBuffer;            // First block
+    void *                      pvFreeList;           // First free block, each free block holds the next
+    uOSBase_t                   uxBlockSize;          // Block size, rounded up to the alignment
+    uOSBase_t                   uxBlockNum;
+
+    tOSList_t                   tTaskListEventMemPool; // MemPool Alloc TaskList;
+
+    volatile uOSBase_t          uxFreeNum;
+    uOSBase_t                   uxMinFreeNum;         // Fewest free blocks seen, the high-water mark of the pool
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;        // OS_TRUE if the memory was given by the application
+#endif
+
+    sOSBase_t                   xID;
+} tOSMemPool_t;
+
+typedef tOSMemPool_t*           OSMemPoolHandle_t;
+
+// Size of one block in the pool: large enough for the free list link and aligned
+#define OSMEMPOOL_BLOCK_SIZE( uxBlockSize )     OSMEM_ALIGN_SIZE( ( ( uxBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( uxBlockSize ) )
+// Bytes of storage OSMemPoolCreateStatic needs, with room to align the first block
+#define OSMEMPOOL_STORAGE_SIZE( uxBlockSize, uxBlockNum )    ( ( OSMEMPOOL_BLOCK_SIZE( uxBlockSize ) * ( uxBlockNum ) ) + OSMEM_ALIGNMENT - 1U )
+
+OSMemPoolHandle_t OSMemPoolCreate( const uOSBase_t uxBlockSize, const uOSBase_t uxBlockNum ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMemPoolHandle_t OSMemPoolCreateStatic( const uOSBase_t uxBlockSize, const uOSBase_t uxBlockNum, void * const pvStorage, tOSMemPool_t * const ptMemPoolBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_MEMFREE_ON != 0 )
+void              OSMemPoolDelete( OSMemPoolHandle_t MemPoolHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSMemPoolSetID(OSMemPoolHandle_t MemPoolHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSMemPoolGetID(OSMemPoolHandle_t const MemPoolHandle) TINIUX_FUNCTION;
+
+void *            OSMemPoolAlloc( OSMemPoolHandle_t MemPoolHandle, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+void *            OSMemPoolAllocFromISR( OSMemPoolHandle_t MemPoolHandle ) TINIUX_FUNCTION;
+
+uOSBool_t         OSMemPoolFree( OSMemPoolHandle_t MemPoolHandle, void * pvBlock ) TINIUX_FUNCTION;
+uOSBool_t         OSMemPoolFreeFromISR( OSMemPoolHandle_t MemPoolHandle, void * pvBlock ) TINIUX_FUNCTION;
+
+uOSBase_t         OSMemPoolGetBlockSize( const OSMemPoolHandle_t MemPoolHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSMemPoolGetFreeNum( const OSMemPoolHandle_t MemPoolHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSMemPoolGetMaxUsedNum( const OSMemPoolHandle_t MemPoolHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_MEMPOOL_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_MEMPOOL_H_
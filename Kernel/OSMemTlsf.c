@@ -0,0 +1,742 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+#include "OSMemory.h"
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MEM_TLSF_ON!=0 )
+
+/**
+ * Two-Level Segregated Fit heap. The free blocks are kept in lists indexed by
+ * the highest set bit of their size (first level) and the next OSTLSF_SL_LOG2
+ * bits (second level). Two bitmaps tell which lists are not empty, so a fit is
+ * found with two bit scans and OSMemMalloc/OSMemFree run in bounded time
+ * whatever the state of the heap. */
+
+/** The low bits of a block size hold the flags, so blocks are at least 4 aligned. */
+#if ( OSMEM_ALIGNMENT <= 4U )
+  #define    OSTLSF_ALIGNMENT          ( 4U )
+  #define    OSTLSF_ALIGN_LOG2         ( 2U )
+#elif ( OSMEM_ALIGNMENT == 8U )
+  #define    OSTLSF_ALIGNMENT          ( 8U )
+  #define    OSTLSF_ALIGN_LOG2         ( 3U )
+#elif ( OSMEM_ALIGNMENT == 16U )
+  #define    OSTLSF_ALIGNMENT          ( 16U )
+  #define    OSTLSF_ALIGN_LOG2         ( 4U )
+#else
+  #error "OSMEM_ALIGNMENT is not supported by the TLSF heap"
+#endif
+#define      OSTLSF_ALIGN_SIZE(size)   (((size) + OSTLSF_ALIGNMENT - 1U) & ~(uOSMemSize_t)(OSTLSF_ALIGNMENT-1U))
+
+/** Second level lists per power of two, fewer on the small 16 bit heaps. */
+#if OSMEM_MAX_SIZE > 64000L
+  #define    OSTLSF_SL_LOG2            ( 4U )
+#else
+  #define    OSTLSF_SL_LOG2            ( 3U )
+#endif
+#define      OSTLSF_SL_COUNT           ( 1U << OSTLSF_SL_LOG2 )
+
+/** Blocks smaller than 1 << OSTLSF_FL_SHIFT all go to the first level 0. */
+#define      OSTLSF_FL_SHIFT           ( OSTLSF_SL_LOG2 + OSTLSF_ALIGN_LOG2 )
+#define      OSTLSF_SMALL_BLOCK_SIZE   ( 1UL << OSTLSF_FL_SHIFT )
+
+/** Every block is smaller than 1 << OSTLSF_FL_INDEX_MAX. */
+#if OSMEM_MAX_SIZE <= 0x1000L
+  #define    OSTLSF_FL_INDEX_MAX       ( 12U )
+#elif OSMEM_MAX_SIZE <= 0x10000L
+  #define    OSTLSF_FL_INDEX_MAX       ( 16U )
+#elif OSMEM_MAX_SIZE <= 0x100000L
+  #define    OSTLSF_FL_INDEX_MAX       ( 20U )
+#elif OSMEM_MAX_SIZE <= 0x1000000L
+  #define    OSTLSF_FL_INDEX_MAX       ( 24U )
+#else
+  #define    OSTLSF_FL_INDEX_MAX       ( 31U )
+#endif
+#define      OSTLSF_FL_COUNT           ( OSTLSF_FL_INDEX_MAX - OSTLSF_FL_SHIFT + 1U )
+
+/** Flags kept in the low bits of Size. */
+#define      OSTLSF_BLOCK_FREE         ( ( uOSMemSize_t ) 0x01U )
+#define      OSTLSF_SIZE_MASK          ( ~( uOSMemSize_t ) ( OSTLSF_ALIGNMENT - 1U ) )
+
+/** Header of every block, the data follows it. */
+typedef struct _tOSMemBlock
+{
+  struct _tOSMemBlock *ptPrevPhys; /** the block just below this one in the heap, OS_NULL for the first */
+  uOSMemSize_t Size;               /** size of the data, OSTLSF_BLOCK_FREE set while the block is free */
+}tOSMemBlock_t;
+
+/** Links of a free block, stored in its data. */
+typedef struct _tOSMemFreeLink
+{
+  tOSMemBlock_t *ptNextFree;
+  tOSMemBlock_t *ptPrevFree;
+}tOSMemFreeLink_t;
+
+#define OSTLSF_HEADER_SIZE        OSTLSF_ALIGN_SIZE(sizeof(tOSMemBlock_t))
+#define OSTLSF_MIN_SIZE           OSTLSF_ALIGN_SIZE(sizeof(tOSMemFreeLink_t))
+#define OSMEM_SIZE_ALIGNED        OSTLSF_ALIGN_SIZE(OSMEM_SIZE)
+
+#define OSTlsfBlockSize( ptBlock )      ( ( ptBlock )->Size & OSTLSF_SIZE_MASK )
+#define OSTlsfBlockIsFree( ptBlock )    ( ( ( ptBlock )->Size & OSTLSF_BLOCK_FREE ) != 0U )
+#define OSTlsfBlockLink( ptBlock )      ( ( tOSMemFreeLink_t * )(void *)( ( uOS8_t * )( ptBlock ) + OSTLSF_HEADER_SIZE ) )
+#define OSTlsfBlockNext( ptBlock )      ( ( tOSMemBlock_t * )(void *)( ( uOS8_t * )( ptBlock ) + OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptBlock ) ) )
+
+/** If you want to relocate the heap to external memory, simply define
+ * OSRAM_HEAP_POINTER as a void-pointer to that location.
+ * If so, make sure the memory at that location is big enough (see below on
+ * how that space is calculated). */
+#ifndef OSRAM_HEAP_POINTER
+/** the heap. we need one block header at each end and some room for alignment */
+uOS8_t OSRamHeap[OSMEM_SIZE_ALIGNED + (2U*OSTLSF_HEADER_SIZE) + OSTLSF_ALIGNMENT];
+#define OSRAM_HEAP_POINTER OSRamHeap
+#endif /* OSRAM_HEAP_POINTER */
+
+/** State of one heap region. */
+typedef struct _tOSMemHeap
+{
+  uOS8_t *pBegin;                     /** pointer to the region, aligned */
+  tOSMemBlock_t *pEnd;                /** the last block, always used and empty */
+  uOSMemSize_t SizeAligned;           /** size of the region without the last block */
+  uOS32_t FlBitmap;                   /** bit f is set when one of the lists of the first level f is not empty */
+  uOS32_t SlBitmap[ OSTLSF_FL_COUNT ];/** bit s of entry f is set when the list [f][s] is not empty */
+  tOSMemBlock_t *ptFree[ OSTLSF_FL_COUNT ][ OSTLSF_SL_COUNT ]; /** heads of the free lists */
+#if ( OS_MEM_STATS_ON!=0 )
+  uOSMemSize_t FreeSize;              /** bytes which are not in used blocks */
+  uOSMemSize_t MinFreeSize;           /** lowest FreeSize since the region was initialized */
+  uOSBase_t Changes;                  /** counts the changes of the region, to restart OSMemHeapWalk() */
+#endif /* OS_MEM_STATS_ON */
+}tOSMemHeap_t;
+
+static tOSMemHeap_t gtOSMemHeap[ OSMEM_REGION_NUM ];
+
+/***************************************************************************** 
+Function    : OSTlsfLowestBit 
+Description : Index of the lowest set bit of a non zero bitmap.
+*****************************************************************************/
+static uOSBase_t OSTlsfLowestBit( uOS32_t ulBitmap )
+{
+    uOSBase_t uxBit = ( uOSBase_t ) 0U;
+
+    OSGET_HIGHEST_BIT( uxBit, ulBitmap & ( ~ulBitmap + 1UL ) );
+    return uxBit;
+}
+
+/***************************************************************************** 
+Function    : OSTlsfMapping 
+Description : The first and second level list a free block of 'size' bytes belongs to.
+*****************************************************************************/
+static void OSTlsfMapping( uOS32_t size, uOSBase_t *puxFl, uOSBase_t *puxSl )
+{
+    uOSBase_t uxBit = ( uOSBase_t ) 0U;
+
+    if( size < OSTLSF_SMALL_BLOCK_SIZE )
+    {
+        *puxFl = ( uOSBase_t ) 0U;
+        *puxSl = ( uOSBase_t ) ( size >> OSTLSF_ALIGN_LOG2 );
+    }
+    else
+    {
+        OSGET_HIGHEST_BIT( uxBit, size );
+        *puxSl = ( uOSBase_t ) ( ( size >> ( uxBit - OSTLSF_SL_LOG2 ) ) ^ OSTLSF_SL_COUNT );
+        *puxFl = ( uOSBase_t ) ( uxBit - ( OSTLSF_FL_SHIFT - 1U ) );
+    }
+}
+
+/***************************************************************************** 
+Function    : OSTlsfFindFree 
+Description : A free block of at least 'size' bytes, taken from the first list
+              whose blocks are all large enough.
+Return      : the block, still in its list, or OS_NULL.
+*****************************************************************************/
+static tOSMemBlock_t *OSTlsfFindFree( tOSMemHeap_t *ptHeap, uOS32_t size, uOSBase_t *puxFl, uOSBase_t *puxSl )
+{
+    uOSBase_t uxBit = ( uOSBase_t ) 0U;
+    uOS32_t ulMap = 0U;
+    uOS32_t ulRound = size;
+    tOSMemBlock_t *ptBlock = OS_NULL;
+
+    // round up to the next list, so that any block of it fits
+    if( size >= OSTLSF_SMALL_BLOCK_SIZE )
+    {
+        OSGET_HIGHEST_BIT( uxBit, size );
+        ulRound += ( 1UL << ( uxBit - OSTLSF_SL_LOG2 ) ) - 1UL;
+    }
+    OSTlsfMapping( ulRound, puxFl, puxSl );
+    if( *puxFl < OSTLSF_FL_COUNT )
+    {
+        ulMap = ptHeap->SlBitmap[ *puxFl ] & ( ~0UL << *puxSl );
+        if( ulMap == 0UL )
+        {
+            // nothing in this first level, take the next one which is not empty
+            ulMap = ptHeap->FlBitmap & ( ~0UL << ( *puxFl + 1U ) );
+            if( ulMap != 0UL )
+            {
+                *puxFl = OSTlsfLowestBit( ulMap );
+                ulMap = ptHeap->SlBitmap[ *puxFl ];
+            }
+        }
+        if( ulMap != 0UL )
+        {
+            *puxSl = OSTlsfLowestBit( ulMap );
+            ptBlock = ptHeap->ptFree[ *puxFl ][ *puxSl ];
+        }
+    }
+
+    if( ptBlock == OS_NULL )
+    {
+        // no larger list, the head of the list of 'size' itself may still fit
+        OSTlsfMapping( size, puxFl, puxSl );
+        if( *puxFl < OSTLSF_FL_COUNT )
+        {
+            ptBlock = ptHeap->ptFree[ *puxFl ][ *puxSl ];
+            if( ( ptBlock != OS_NULL ) && ( ( uOS32_t ) OSTlsfBlockSize( ptBlock ) < size ) )
+            {
+                ptBlock = OS_NULL;
+            }
+        }
+    }
+
+    return ptBlock;
+}
+
+static void OSTlsfRemoveFree( tOSMemHeap_t *ptHeap, tOSMemBlock_t *ptBlock, uOSBase_t uxFl, uOSBase_t uxSl )
+{
+    tOSMemFreeLink_t *ptLink = OSTlsfBlockLink( ptBlock );
+
+    if( ptLink->ptNextFree != OS_NULL )
+    {
+        OSTlsfBlockLink( ptLink->ptNextFree )->ptPrevFree = ptLink->ptPrevFree;
+    }
+    if( ptLink->ptPrevFree != OS_NULL )
+    {
+        OSTlsfBlockLink( ptLink->ptPrevFree )->ptNextFree = ptLink->ptNextFree;
+    }
+    else
+    {
+        ptHeap->ptFree[ uxFl ][ uxSl ] = ptLink->ptNextFree;
+        if( ptLink->ptNextFree == OS_NULL )
+        {
+            ptHeap->SlBitmap[ uxFl ] &= ~( 1UL << uxSl );
+            if( ptHeap->SlBitmap[ uxFl ] == 0UL )
+            {
+                ptHeap->FlBitmap &= ~( 1UL << uxFl );
+            }
+        }
+    }
+}
+
+static void OSTlsfUnlinkFree( tOSMemHeap_t *ptHeap, tOSMemBlock_t *ptBlock )
+{
+    uOSBase_t uxFl = ( uOSBase_t ) 0U;
+    uOSBase_t uxSl = ( uOSBase_t ) 0U;
+
+    OSTlsfMapping( ( uOS32_t ) OSTlsfBlockSize( ptBlock ), &uxFl, &uxSl );
+    OSTlsfRemoveFree( ptHeap, ptBlock, uxFl, uxSl );
+}
+
+static void OSTlsfInsertFree( tOSMemHeap_t *ptHeap, tOSMemBlock_t *ptBlock )
+{
+    uOSBase_t uxFl = ( uOSBase_t ) 0U;
+    uOSBase_t uxSl = ( uOSBase_t ) 0U;
+    tOSMemFreeLink_t *ptLink = OSTlsfBlockLink( ptBlock );
+
+    OSTlsfMapping( ( uOS32_t ) OSTlsfBlockSize( ptBlock ), &uxFl, &uxSl );
+
+    ptBlock->Size |= OSTLSF_BLOCK_FREE;
+    ptLink->ptPrevFree = OS_NULL;
+    ptLink->ptNextFree = ptHeap->ptFree[ uxFl ][ uxSl ];
+    if( ptLink->ptNextFree != OS_NULL )
+    {
+        OSTlsfBlockLink( ptLink->ptNextFree )->ptPrevFree = ptBlock;
+    }
+    ptHeap->ptFree[ uxFl ][ uxSl ] = ptBlock;
+    ptHeap->SlBitmap[ uxFl ] |= ( 1UL << uxSl );
+    ptHeap->FlBitmap |= ( 1UL << uxFl );
+}
+
+/***************************************************************************** 
+Function    : OSTlsfSplit 
+Description : Cut 'ptBlock' down to 'size' bytes and put the rest back in the
+              free lists, if it is large enough to be a block of its own.
+              'ptBlock' must not be in a free list.
+*****************************************************************************/
+static void OSTlsfSplit( tOSMemHeap_t *ptHeap, tOSMemBlock_t *ptBlock, uOSMemSize_t size )
+{
+    tOSMemBlock_t *ptRemain = OS_NULL;
+    tOSMemBlock_t *ptNext = OS_NULL;
+    uOSMemSize_t RemainSize = OSTlsfBlockSize( ptBlock ) - size;
+
+    if( RemainSize < ( OSTLSF_HEADER_SIZE + OSTLSF_MIN_SIZE ) )
+    {
+        return;
+    }
+
+    ptBlock->Size = size | ( ptBlock->Size & OSTLSF_BLOCK_FREE );
+    ptRemain = OSTlsfBlockNext( ptBlock );
+    ptRemain->ptPrevPhys = ptBlock;
+    ptRemain->Size = RemainSize - OSTLSF_HEADER_SIZE;
+
+    ptNext = OSTlsfBlockNext( ptRemain );
+    ptNext->ptPrevPhys = ptRemain;
+    if( OSTlsfBlockIsFree( ptNext ) )
+    {
+        // only happens when a block is trimmed, keep free blocks apart
+        OSTlsfUnlinkFree( ptHeap, ptNext );
+        ptRemain->Size += OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptNext );
+        OSTlsfBlockNext( ptRemain )->ptPrevPhys = ptRemain;
+    }
+    OSTlsfInsertFree( ptHeap, ptRemain );
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapInit 
+Description : Make a heap region one large free block.
+Input       : uxRegion -- index of the region.
+              pvStart -- start of the region, OS_NULL for OSRamHeap which is
+                         zeroed as well.
+              ulSize -- size of the region in bytes, unused for OSRamHeap.
+Output      : None 
+Return      : OS_TRUE if the region can be used, OS_FALSE if it is too small.
+*****************************************************************************/
+uOSBool_t OSMemHeapInit(uOSBase_t uxRegion, void *pvStart, uOS32_t ulSize)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMemBlock_t *ptBlock = OS_NULL;
+#if ( OSMEM_REGION_NUM > 1U )
+    uOS32_t ulHead = 0U;
+#else
+    (void)ulSize;
+#endif /* OSMEM_REGION_NUM */
+
+    if (pvStart == OS_NULL) 
+    {
+        // align the heap 
+        ptHeap->pBegin = (uOS8_t *)((((uOSAddr_t)OSRAM_HEAP_POINTER) + OSTLSF_ALIGNMENT - 1U) & ~(uOSAddr_t)(OSTLSF_ALIGNMENT - 1U));
+        ptHeap->SizeAligned = OSMEM_SIZE_ALIGNED;
+
+        /* Initialize the stack tiniux used. */
+        memset(ptHeap->pBegin, 0U, OSMEM_SIZE_ALIGNED + OSTLSF_HEADER_SIZE);
+    }
+#if ( OSMEM_REGION_NUM > 1U )
+    else
+    {
+        // align the region and keep room for the last block, the data is
+        // not zeroed since external memory may be large and slow
+        ptHeap->pBegin = (uOS8_t *)((((uOSAddr_t)pvStart) + OSTLSF_ALIGNMENT - 1U) & ~(uOSAddr_t)(OSTLSF_ALIGNMENT - 1U));
+        ulHead = (uOS32_t)(ptHeap->pBegin - (uOS8_t *)pvStart) + OSTLSF_HEADER_SIZE;
+        if (ulSize < ulHead + OSTLSF_HEADER_SIZE + OSTLSF_MIN_SIZE) 
+        {
+            return OS_FALSE;
+        }
+        ulSize -= ulHead;
+        if (ulSize > (uOS32_t)OSMEM_REGION_MAX_SIZE) 
+        {
+            // the rest of a larger region is left unused
+            ulSize = (uOS32_t)OSMEM_REGION_MAX_SIZE;
+        }
+        ptHeap->SizeAligned = (uOSMemSize_t)(ulSize & ~(uOS32_t)(OSTLSF_ALIGNMENT - 1U));
+    }
+#endif /* OSMEM_REGION_NUM */
+
+    memset(ptHeap->SlBitmap, 0U, sizeof(ptHeap->SlBitmap));
+    memset(ptHeap->ptFree, 0U, sizeof(ptHeap->ptFree));
+    ptHeap->FlBitmap = 0U;
+
+    // the end of the heap, a used block without data
+    ptHeap->pEnd = (tOSMemBlock_t *)(void *)&ptHeap->pBegin[ptHeap->SizeAligned];
+    ptHeap->pEnd->Size = 0U;
+
+    // the rest is one free block
+    ptBlock = (tOSMemBlock_t *)(void *)ptHeap->pBegin;
+    ptBlock->ptPrevPhys = OS_NULL;
+    ptBlock->Size = ptHeap->SizeAligned - OSTLSF_HEADER_SIZE;
+    ptHeap->pEnd->ptPrevPhys = ptBlock;
+    OSTlsfInsertFree( ptHeap, ptBlock );
+
+#if ( OS_MEM_STATS_ON!=0 )
+    ptHeap->FreeSize = ptHeap->SizeAligned;
+    ptHeap->MinFreeSize = ptHeap->SizeAligned;
+    ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+
+    return OS_TRUE;
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapContains 
+Description : Tell if pMem lies in the data of a heap region.
+Input       : uxRegion -- index of the region.
+              pMem -- the pointer to check.
+Output      : None 
+Return      : OS_TRUE if pMem belongs to the region.
+*****************************************************************************/
+uOSBool_t OSMemHeapContains(uOSBase_t uxRegion, void *pMem)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+
+    if ((uOS8_t *)pMem < (uOS8_t *)ptHeap->pBegin || (uOS8_t *)pMem >= (uOS8_t *)ptHeap->pEnd) 
+    {
+        return OS_FALSE;
+    }
+    return OS_TRUE;
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapWalk 
+Description : Count the blocks of a heap region and add them to ptStats.
+              The heap lock is released every OSMEM_WALK_STEP blocks, the walk
+              starts again if the region was changed meanwhile, up to
+              OSMEM_WALK_RETRY times before it keeps the lock to the end.
+Input       : uxRegion -- index of the region.
+Output      : ptStats -- the sizes and block counts are added to it.
+Return      : None 
+*****************************************************************************/
+#if ( OS_MEM_STATS_ON!=0 )
+void OSMemHeapWalk(uOSBase_t uxRegion, tOSMemStats_t *ptStats)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMemBlock_t *ptBlock = OS_NULL;
+    uOSMemSize_t Largest = 0U;
+    uOS32_t ulFreeBlocks = 0U, ulUsedBlocks = 0U;
+    uOSBase_t uxChanges = 0U, uxStep = 0U, uxRetry = 0U;
+
+    OSMemLock();
+    uxChanges = ptHeap->Changes;
+    ptBlock = (tOSMemBlock_t *)(void *)ptHeap->pBegin;
+    while (ptBlock != ptHeap->pEnd) 
+    {
+        if (OSTlsfBlockIsFree( ptBlock )) 
+        {
+            ulFreeBlocks++;
+            if (OSTlsfBlockSize( ptBlock ) > Largest) 
+            {
+                Largest = OSTlsfBlockSize( ptBlock );
+            }
+        }
+        else 
+        {
+            ulUsedBlocks++;
+        }
+        ptBlock = OSTlsfBlockNext( ptBlock );
+
+        uxStep++;
+        if ((uxStep >= OSMEM_WALK_STEP) && (uxRetry < OSMEM_WALK_RETRY)) 
+        {
+            // let the pending interrupts (or tasks) in 
+            uxStep = 0U;
+            OSMemUnlock();
+            OSMemLock();
+            if (ptHeap->Changes != uxChanges) 
+            {
+                // the region was changed, the walk has to start again 
+                uxChanges = ptHeap->Changes;
+                uxRetry++;
+                ptBlock = (tOSMemBlock_t *)(void *)ptHeap->pBegin;
+                Largest = 0U;
+                ulFreeBlocks = 0U;
+                ulUsedBlocks = 0U;
+            }
+        }
+    }
+
+    ptStats->ulTotalSize += ptHeap->SizeAligned;
+    ptStats->ulFreeSize += ptHeap->FreeSize;
+    ptStats->ulMinFreeSize += ptHeap->MinFreeSize;
+    OSMemUnlock();
+
+    if (Largest > ptStats->ulLargestFreeBlock) 
+    {
+        ptStats->ulLargestFreeBlock = Largest;
+    }
+    ptStats->ulFreeBlocks += ulFreeBlocks;
+    ptStats->ulUsedBlocks += ulUsedBlocks;
+}
+#endif /* OS_MEM_STATS_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapFree 
+Description : Put a block back on its heap region, merged with the free blocks around it.
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the data portion of a block as returned by a previous 
+                      call to OSMemHeapMalloc()
+Output      : None 
+Return      : None 
+*****************************************************************************/ 
+#if ( OS_MEMFREE_ON != 0 )
+void OSMemHeapFree(uOSBase_t uxRegion, void *pMem)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMemBlock_t *ptBlock = OS_NULL;
+    tOSMemBlock_t *ptNeighbour = OS_NULL;
+
+    // protect the heap from concurrent access 
+    OSMemLock();
+    ptBlock = (tOSMemBlock_t *)(void *)((uOS8_t *)pMem - OSTLSF_HEADER_SIZE);
+
+    //the block must be used
+    if( !OSTlsfBlockIsFree( ptBlock ) )
+    {
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize += OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptBlock );
+        ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+
+        // merge with the next block 
+        ptNeighbour = OSTlsfBlockNext( ptBlock );
+        if( OSTlsfBlockIsFree( ptNeighbour ) )
+        {
+            OSTlsfUnlinkFree( ptHeap, ptNeighbour );
+            ptBlock->Size += OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptNeighbour );
+            OSTlsfBlockNext( ptBlock )->ptPrevPhys = ptBlock;
+        }
+
+        // merge with the previous block 
+        ptNeighbour = ptBlock->ptPrevPhys;
+        if( ( ptNeighbour != OS_NULL ) && OSTlsfBlockIsFree( ptNeighbour ) )
+        {
+            OSTlsfUnlinkFree( ptHeap, ptNeighbour );
+            ptNeighbour->Size = OSTlsfBlockSize( ptNeighbour ) + OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptBlock );
+            ptBlock = ptNeighbour;
+            OSTlsfBlockNext( ptBlock )->ptPrevPhys = ptBlock;
+        }
+
+        OSTlsfInsertFree( ptHeap, ptBlock );
+    }
+    OSMemUnlock();
+
+    return;
+}
+#endif /* OS_MEMFREE_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapTrim 
+Description : Shrink memory returned by OSMemHeapMalloc().
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to memory allocated by OSMemMalloc is to be shrinked
+              newsize -- required size after shrinking (needs to be smaller than or
+                         equal to the previous size)
+Output      : None 
+Return      : for compatibility reasons: is always == pMem, at the moment
+              or OS_NULL if newsize is > old size, in which case pMem is NOT touched
+              or freed!
+*****************************************************************************/ 
+#if ( OS_MEMFREE_ON != 0 )
+void* OSMemHeapTrim(uOSBase_t uxRegion, void *pMem, uOSMemSize_t newsize)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMemBlock_t *ptBlock = OS_NULL;
+
+    if (newsize > ptHeap->SizeAligned) 
+    {
+        return OS_NULL;
+    }
+
+    // Expand the size of the allocated memory region so that we can adjust for alignment. 
+    newsize = OSTLSF_ALIGN_SIZE(newsize);
+    if(newsize < OSTLSF_MIN_SIZE) 
+    {
+        newsize = OSTLSF_MIN_SIZE;
+    }
+
+    ptBlock = (tOSMemBlock_t *)(void *)((uOS8_t *)pMem - OSTLSF_HEADER_SIZE);
+
+    if (newsize > OSTlsfBlockSize( ptBlock )) 
+    {
+        // not supported
+        return OS_NULL;
+    }
+
+    // protect the heap from concurrent access 
+    OSMemLock();
+#if ( OS_MEM_STATS_ON!=0 )
+    // the bytes cut off are free now 
+    ptHeap->FreeSize += OSTlsfBlockSize( ptBlock );
+    OSTlsfSplit( ptHeap, ptBlock, newsize );
+    ptHeap->FreeSize -= OSTlsfBlockSize( ptBlock );
+    ptHeap->Changes++;
+#else
+    OSTlsfSplit( ptHeap, ptBlock, newsize );
+#endif /* OS_MEM_STATS_ON */
+    OSMemUnlock();
+
+    return pMem;
+}
+#endif /* OS_MEMFREE_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapGetSize 
+Description : The data size of a block returned by OSMemHeapMalloc().
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to the block.
+Output      : None 
+Return      : the size in bytes, at least the size asked for.
+*****************************************************************************/ 
+#if ( OS_MEMFREE_ON != 0 )
+uOSMemSize_t OSMemHeapGetSize(uOSBase_t uxRegion, void *pMem)
+{
+    ( void ) uxRegion;
+
+    return OSTlsfBlockSize( (tOSMemBlock_t *)(void *)((uOS8_t *)pMem - OSTLSF_HEADER_SIZE) );
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapGrow 
+Description : Grow memory returned by OSMemHeapMalloc() in place, by merging
+              it with the next block if that one is free and large enough.
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to memory allocated by OSMemHeapMalloc.
+              newsize -- required size after growing.
+Output      : None 
+Return      : OS_TRUE if the block holds newsize bytes now, OS_FALSE if it 
+              could not grow, in which case pMem is NOT touched.
+*****************************************************************************/ 
+uOSBool_t OSMemHeapGrow(uOSBase_t uxRegion, void *pMem, uOSMemSize_t newsize)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    uOSBool_t bReturn = OS_FALSE;
+    tOSMemBlock_t *ptBlock = OS_NULL;
+    tOSMemBlock_t *ptNext = OS_NULL;
+
+    if (newsize > ptHeap->SizeAligned) 
+    {
+        return OS_FALSE;
+    }
+
+    // Expand the size of the allocated memory region so that we can adjust for alignment. 
+    newsize = OSTLSF_ALIGN_SIZE(newsize);
+
+    // protect the heap from concurrent access 
+    OSMemLock();
+
+    ptBlock = (tOSMemBlock_t *)(void *)((uOS8_t *)pMem - OSTLSF_HEADER_SIZE);
+    ptNext = OSTlsfBlockNext( ptBlock );
+    if( OSTlsfBlockIsFree( ptNext ) && 
+        ( ( uOS32_t ) OSTlsfBlockSize( ptBlock ) + OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptNext ) >= ( uOS32_t ) newsize ) )
+    {
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize += OSTlsfBlockSize( ptBlock );
+#endif /* OS_MEM_STATS_ON */
+        OSTlsfUnlinkFree( ptHeap, ptNext );
+        ptBlock->Size += OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptNext );
+        OSTlsfBlockNext( ptBlock )->ptPrevPhys = ptBlock;
+
+        // give back what is not needed 
+        OSTlsfSplit( ptHeap, ptBlock, newsize );
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize -= OSTlsfBlockSize( ptBlock );
+        if (ptHeap->FreeSize < ptHeap->MinFreeSize) 
+        {
+            ptHeap->MinFreeSize = ptHeap->FreeSize;
+        }
+        ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+        bReturn = OS_TRUE;
+    }
+
+    OSMemUnlock();
+
+    return bReturn;
+}
+#endif /* OS_MEMFREE_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapMalloc 
+Description : Allocate a block of memory with a minimum of 'size' bytes from a heap region.
+Input       : uxRegion -- index of the region.
+              size -- the minimum size of the requested block in bytes.
+Output      : None 
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+*****************************************************************************/ 
+void* OSMemHeapMalloc(uOSBase_t uxRegion, uOSMemSize_t size)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    uOS8_t * pResult = OS_NULL;
+    tOSMemBlock_t *ptBlock = OS_NULL;
+    uOSBase_t uxFl = ( uOSBase_t ) 0U;
+    uOSBase_t uxSl = ( uOSBase_t ) 0U;
+
+    if ((size == 0) || (size > ptHeap->SizeAligned)) 
+    {
+        return pResult;
+    }
+
+    // Expand the size of the allocated memory region so that we can
+    // adjust for alignment. 
+    size = OSTLSF_ALIGN_SIZE(size);
+    if(size < OSTLSF_MIN_SIZE) 
+    {
+        // every free block must be able to hold the free list links
+        size = OSTLSF_MIN_SIZE;
+    }
+
+    // protect the heap from concurrent access 
+    OSMemLock();
+
+    ptBlock = OSTlsfFindFree( ptHeap, ( uOS32_t ) size, &uxFl, &uxSl );
+    if( ptBlock != OS_NULL )
+    {
+        OSTlsfRemoveFree( ptHeap, ptBlock, uxFl, uxSl );
+        ptBlock->Size &= ~OSTLSF_BLOCK_FREE;
+        OSTlsfSplit( ptHeap, ptBlock, size );
+
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize -= OSTLSF_HEADER_SIZE + OSTlsfBlockSize( ptBlock );
+        if (ptHeap->FreeSize < ptHeap->MinFreeSize) 
+        {
+            ptHeap->MinFreeSize = ptHeap->FreeSize;
+        }
+        ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+        pResult = (uOS8_t *)ptBlock + OSTLSF_HEADER_SIZE;
+    }
+
+    OSMemUnlock();
+
+    return pResult;
+}
+
+#endif /* OS_MEM_TLSF_ON */
+
+#ifdef __cplusplus
+}
+#endif
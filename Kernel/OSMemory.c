@@ -43,6 +43,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
+/* The TLSF heap in OSMemTlsf.c replaces this one when OS_MEM_TLSF_ON is set. */
+#if ( OS_MEM_TLSF_ON==0 )
+
 /**
  * The heap is made up as a list of structs of this type.
  * This does not have to be aligned since for getting its size,
@@ -75,27 +78,37 @@ uOS8_t OSRamHeap[OSMEM_SIZE_ALIGNED + (2U*SIZEOF_OSMEM_ALIGNED) + OSMEM_ALIGNMEN
 #define OSRAM_HEAP_POINTER OSRamHeap
 #endif /* OSRAM_HEAP_POINTER */
 
-/** pointer to the heap (OSRamHeap): for alignment, gpOSMemBegin is now a pointer instead of an array */
-static uOS8_t *gpOSMemBegin = OS_NULL;
-/** the last entry, always unused! */
-static tOSMem_t *gpOSMemEnd = OS_NULL;
-/** pointer to the lowest free block, this is Used for faster search */
-static tOSMem_t *gpOSMemLFree = OS_NULL;
+/** State of one heap region. */
+typedef struct _tOSMemHeap
+{
+  uOS8_t *pBegin;            /** pointer to the region: for alignment, pBegin is a pointer instead of an array */
+  tOSMem_t *pEnd;            /** the last entry, always unused! */
+  tOSMem_t *pLFree;          /** pointer to the lowest free block, this is Used for faster search */
+  uOSMemSize_t SizeAligned;  /** size of the region without the last entry */
+#if ( OS_MEM_STATS_ON!=0 )
+  uOSMemSize_t FreeSize;     /** bytes which are not in used blocks */
+  uOSMemSize_t MinFreeSize;  /** lowest FreeSize since the region was initialized */
+  uOSBase_t Changes;         /** counts the changes of the region, to restart OSMemHeapWalk() */
+#endif /* OS_MEM_STATS_ON */
+}tOSMemHeap_t;
+
+static tOSMemHeap_t gtOSMemHeap[ OSMEM_REGION_NUM ];
 
 /***************************************************************************** 
 Function    : OSMemCombine 
 Description : "OSMemCombine" by combining adjacent empty struct mems.
               After this function is through, there should not exist
               one empty tOSMem_t pointing to another empty tOSMem_t.
-              this function is only called by OSMemFree() and OSMemTrim(),
+              this function is only called by OSMemHeapFree() and OSMemHeapTrim(),
               This assumes access to the heap is protected by the calling function
               already.
-Input       : ptOSMem -- the point to a tOSMem_t which just has been freed.
+Input       : ptHeap -- the region ptOSMem belongs to.
+              ptOSMem -- the point to a tOSMem_t which just has been freed.
 Output      : None 
 Return      : None 
 *****************************************************************************/
 #if ( OS_MEMFREE_ON != 0 )
-static void OSMemCombine(tOSMem_t *ptOSMem)
+static void OSMemCombine(tOSMemHeap_t *ptHeap, tOSMem_t *ptOSMem)
 {
     tOSMem_t *ptNextOSMem = OS_NULL;
     tOSMem_t *ptPrevOSMem = OS_NULL;
@@ -106,94 +119,218 @@ static void OSMemCombine(tOSMem_t *ptOSMem)
     }
     
     // Combine forward 
-    ptNextOSMem = (tOSMem_t *)(void *)&gpOSMemBegin[ptOSMem->NextMem];
-    if (ptOSMem != ptNextOSMem && ptNextOSMem->Used == 0 && (uOS8_t *)ptNextOSMem != (uOS8_t *)gpOSMemEnd) 
+    ptNextOSMem = (tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMem->NextMem];
+    if (ptOSMem != ptNextOSMem && ptNextOSMem->Used == 0 && (uOS8_t *)ptNextOSMem != (uOS8_t *)ptHeap->pEnd) 
     {
-        // if ptOSMem->NextMem is unused and not end of gpOSMemBegin, combine ptOSMem and ptOSMem->NextMem 
-        if (gpOSMemLFree == ptNextOSMem) 
+        // if ptOSMem->NextMem is unused and not end of the region, combine ptOSMem and ptOSMem->NextMem 
+        if (ptHeap->pLFree == ptNextOSMem) 
         {
-            gpOSMemLFree = ptOSMem;
+            ptHeap->pLFree = ptOSMem;
         }
         ptOSMem->NextMem = ptNextOSMem->NextMem;
-        ((tOSMem_t *)(void *)&gpOSMemBegin[ptNextOSMem->NextMem])->PrevMem = (uOSMemSize_t)((uOS8_t *)ptOSMem - gpOSMemBegin);
+        ((tOSMem_t *)(void *)&ptHeap->pBegin[ptNextOSMem->NextMem])->PrevMem = (uOSMemSize_t)((uOS8_t *)ptOSMem - ptHeap->pBegin);
     }
 
     // Combine backward 
-    ptPrevOSMem = (tOSMem_t *)(void *)&gpOSMemBegin[ptOSMem->PrevMem];
+    ptPrevOSMem = (tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMem->PrevMem];
     if (ptPrevOSMem != ptOSMem && ptPrevOSMem->Used == 0) 
     {
         // if ptOSMem->PrevMem is unused, combine ptOSMem and ptOSMem->PrevMem 
-        if (gpOSMemLFree == ptOSMem) 
+        if (ptHeap->pLFree == ptOSMem) 
         {
-            gpOSMemLFree = ptPrevOSMem;
+            ptHeap->pLFree = ptPrevOSMem;
         }
         ptPrevOSMem->NextMem = ptOSMem->NextMem;
-        ((tOSMem_t *)(void *)&gpOSMemBegin[ptOSMem->NextMem])->PrevMem = (uOSMemSize_t)((uOS8_t *)ptPrevOSMem - gpOSMemBegin);
+        ((tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMem->NextMem])->PrevMem = (uOSMemSize_t)((uOS8_t *)ptPrevOSMem - ptHeap->pBegin);
     }
     return;
 }
 #endif /* OS_MEMFREE_ON */
 
 /***************************************************************************** 
-Function    : OSMemInit 
-Description : Zero the heap and initialize start, end and lowest-free pointer.
-Input       : None
+Function    : OSMemHeapInit 
+Description : Initialize start, end and lowest-free pointer of a heap region.
+Input       : uxRegion -- index of the region.
+              pvStart -- start of the region, OS_NULL for OSRamHeap which is
+                         zeroed as well.
+              ulSize -- size of the region in bytes, unused for OSRamHeap.
 Output      : None 
-Return      : None 
+Return      : OS_TRUE if the region can be used, OS_FALSE if it is too small.
 *****************************************************************************/
-uOSBase_t OSMemInit(void)
+uOSBool_t OSMemHeapInit(uOSBase_t uxRegion, void *pvStart, uOS32_t ulSize)
 {
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
     tOSMem_t *ptOSMemTemp = OS_NULL;
+#if ( OSMEM_REGION_NUM > 1U )
+    uOS32_t ulHead = 0U;
+#else
+    (void)ulSize;
+#endif /* OSMEM_REGION_NUM */
 
-    // align the heap 
-    gpOSMemBegin = (uOS8_t *)OSMEM_ALIGN_ADDR(OSRAM_HEAP_POINTER);
+    if (pvStart == OS_NULL) 
+    {
+        // align the heap 
+        ptHeap->pBegin = (uOS8_t *)OSMEM_ALIGN_ADDR(OSRAM_HEAP_POINTER);
+        ptHeap->SizeAligned = OSMEM_SIZE_ALIGNED;
 
-    /* Initialize the stack tiniux used. */
-    memset(gpOSMemBegin, 0U, OSMEM_SIZE_ALIGNED);
+        /* Initialize the stack tiniux used. */
+        memset(ptHeap->pBegin, 0U, OSMEM_SIZE_ALIGNED);
+    }
+#if ( OSMEM_REGION_NUM > 1U )
+    else
+    {
+        // align the region and keep room for the last entry, the data is
+        // not zeroed since external memory may be large and slow
+        ptHeap->pBegin = (uOS8_t *)OSMEM_ALIGN_ADDR(pvStart);
+        ulHead = (uOS32_t)(ptHeap->pBegin - (uOS8_t *)pvStart) + SIZEOF_OSMEM_ALIGNED;
+        if (ulSize < ulHead + SIZEOF_OSMEM_ALIGNED + OSMIN_SIZE_ALIGNED) 
+        {
+            return OS_FALSE;
+        }
+        ulSize -= ulHead;
+        if (ulSize > (uOS32_t)OSMEM_REGION_MAX_SIZE) 
+        {
+            // the rest of a larger region is left unused
+            ulSize = (uOS32_t)OSMEM_REGION_MAX_SIZE;
+        }
+        ptHeap->SizeAligned = (uOSMemSize_t)(ulSize & ~(uOS32_t)OSMEM_ALIGNMENT_MASK);
+    }
+#endif /* OSMEM_REGION_NUM */
 
     // initialize the start of the heap 
-    ptOSMemTemp = (tOSMem_t *)(void *)gpOSMemBegin;
-    ptOSMemTemp->NextMem = OSMEM_SIZE_ALIGNED;
+    ptOSMemTemp = (tOSMem_t *)(void *)ptHeap->pBegin;
+    ptOSMemTemp->NextMem = ptHeap->SizeAligned;
     ptOSMemTemp->PrevMem = 0;
     ptOSMemTemp->Used = 0;
     
     // initialize the end of the heap 
-    gpOSMemEnd = (tOSMem_t *)(void *)&gpOSMemBegin[OSMEM_SIZE_ALIGNED];
-    gpOSMemEnd->Used = 1;
-    gpOSMemEnd->NextMem = OSMEM_SIZE_ALIGNED;
-    gpOSMemEnd->PrevMem = OSMEM_SIZE_ALIGNED;
+    ptHeap->pEnd = (tOSMem_t *)(void *)&ptHeap->pBegin[ptHeap->SizeAligned];
+    ptHeap->pEnd->Used = 1;
+    ptHeap->pEnd->NextMem = ptHeap->SizeAligned;
+    ptHeap->pEnd->PrevMem = ptHeap->SizeAligned;
 
     // initialize the lowest-free pointer to the start of the heap 
-    gpOSMemLFree = (tOSMem_t *)(void *)gpOSMemBegin;
+    ptHeap->pLFree = (tOSMem_t *)(void *)ptHeap->pBegin;
+
+#if ( OS_MEM_STATS_ON!=0 )
+    ptHeap->FreeSize = ptHeap->SizeAligned;
+    ptHeap->MinFreeSize = ptHeap->SizeAligned;
+    ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
     
-    return 0U;
+    return OS_TRUE;
 }
 
 /***************************************************************************** 
-Function    : OSMemFree 
-Description : Put a tOSMem_t back on the heap. 
-Input       : pMem -- the data portion of a tOSMem_t as returned by a previous 
-                      call to OSMemMalloc()
+Function    : OSMemHeapContains 
+Description : Tell if pMem lies in the data of a heap region.
+Input       : uxRegion -- index of the region.
+              pMem -- the pointer to check.
 Output      : None 
+Return      : OS_TRUE if pMem belongs to the region.
+*****************************************************************************/
+uOSBool_t OSMemHeapContains(uOSBase_t uxRegion, void *pMem)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+
+    if ((uOS8_t *)pMem < (uOS8_t *)ptHeap->pBegin || (uOS8_t *)pMem >= (uOS8_t *)ptHeap->pEnd) 
+    {
+        return OS_FALSE;
+    }
+    return OS_TRUE;
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapWalk 
+Description : Count the blocks of a heap region and add them to ptStats.
+              The heap lock is released every OSMEM_WALK_STEP blocks, the walk
+              starts again if the region was changed meanwhile, up to
+              OSMEM_WALK_RETRY times before it keeps the lock to the end.
+Input       : uxRegion -- index of the region.
+Output      : ptStats -- the sizes and block counts are added to it.
 Return      : None 
-*****************************************************************************/ 
-#if ( OS_MEMFREE_ON != 0 )
-void OSMemFree(void *pMem)
+*****************************************************************************/
+#if ( OS_MEM_STATS_ON!=0 )
+void OSMemHeapWalk(uOSBase_t uxRegion, tOSMemStats_t *ptStats)
 {
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
     tOSMem_t *ptOSMemTemp = OS_NULL;
+    uOSMemSize_t ptr = 0U, size = 0U;
+    uOSMemSize_t Largest = 0U;
+    uOS32_t ulFreeBlocks = 0U, ulUsedBlocks = 0U;
+    uOSBase_t uxChanges = 0U, uxStep = 0U, uxRetry = 0U;
 
-    if (pMem == OS_NULL) 
+    OSMemLock();
+    uxChanges = ptHeap->Changes;
+    while (ptr < ptHeap->SizeAligned) 
     {
-        return;
+        ptOSMemTemp = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr];
+        if (ptOSMemTemp->Used) 
+        {
+            ulUsedBlocks++;
+        }
+        else 
+        {
+            ulFreeBlocks++;
+            size = ptOSMemTemp->NextMem - ptr - SIZEOF_OSMEM_ALIGNED;
+            if (size > Largest) 
+            {
+                Largest = size;
+            }
+        }
+        ptr = ptOSMemTemp->NextMem;
+
+        uxStep++;
+        if ((uxStep >= OSMEM_WALK_STEP) && (uxRetry < OSMEM_WALK_RETRY)) 
+        {
+            // let the pending interrupts (or tasks) in 
+            uxStep = 0U;
+            OSMemUnlock();
+            OSMemLock();
+            if (ptHeap->Changes != uxChanges) 
+            {
+                // the region was changed, the walk has to start again 
+                uxChanges = ptHeap->Changes;
+                uxRetry++;
+                ptr = 0U;
+                Largest = 0U;
+                ulFreeBlocks = 0U;
+                ulUsedBlocks = 0U;
+            }
+        }
     }
 
-    if ((uOS8_t *)pMem < (uOS8_t *)gpOSMemBegin || (uOS8_t *)pMem >= (uOS8_t *)gpOSMemEnd) 
+    ptStats->ulTotalSize += ptHeap->SizeAligned;
+    ptStats->ulFreeSize += ptHeap->FreeSize;
+    ptStats->ulMinFreeSize += ptHeap->MinFreeSize;
+    OSMemUnlock();
+
+    if (Largest > ptStats->ulLargestFreeBlock) 
     {
-        return;
+        ptStats->ulLargestFreeBlock = Largest;
     }
-    
+    ptStats->ulFreeBlocks += ulFreeBlocks;
+    ptStats->ulUsedBlocks += ulUsedBlocks;
+}
+#endif /* OS_MEM_STATS_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapFree 
+Description : Put a tOSMem_t back on its heap region. 
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the data portion of a tOSMem_t as returned by a previous 
+                      call to OSMemHeapMalloc()
+Output      : None 
+Return      : None 
+*****************************************************************************/ 
+#if ( OS_MEMFREE_ON != 0 )
+void OSMemHeapFree(uOSBase_t uxRegion, void *pMem)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMem_t *ptOSMemTemp = OS_NULL;
+
     // protect the heap from concurrent access 
-    OSIntLock();
+    OSMemLock();
     // Get the corresponding tOSMem_t ... 
     ptOSMemTemp = (tOSMem_t *)(void *)((uOS8_t *)pMem - SIZEOF_OSMEM_ALIGNED);
     
@@ -203,25 +340,31 @@ void OSMemFree(void *pMem)
         // now set it unused. 
         ptOSMemTemp->Used = 0;
 
-        if (ptOSMemTemp < gpOSMemLFree) 
+        if (ptOSMemTemp < ptHeap->pLFree) 
         {
             // the newly freed struct is now the lowest 
-            gpOSMemLFree = ptOSMemTemp;
+            ptHeap->pLFree = ptOSMemTemp;
         }
 
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize += ptOSMemTemp->NextMem - (uOSMemSize_t)((uOS8_t *)ptOSMemTemp - ptHeap->pBegin);
+        ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+
         // finally, see if prev or next are free also 
-        OSMemCombine(ptOSMemTemp);        
+        OSMemCombine(ptHeap, ptOSMemTemp);        
     }
-    OSIntUnlock();
+    OSMemUnlock();
     
     return;
 }
 #endif /* OS_MEMFREE_ON */
 
 /***************************************************************************** 
-Function    : OSMemTrim 
-Description : Shrink memory returned by OSMemMalloc().
-Input       : pMem -- the pointer to memory allocated by OSMemMalloc is to be shrinked
+Function    : OSMemHeapTrim 
+Description : Shrink memory returned by OSMemHeapMalloc().
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to memory allocated by OSMemMalloc is to be shrinked
               newsize -- required size after shrinking (needs to be smaller than or
                          equal to the previous size)
 Output      : None 
@@ -230,8 +373,9 @@ Return      : for compatibility reasons: is always == pMem, at the moment
               or freed!
 *****************************************************************************/ 
 #if ( OS_MEMFREE_ON != 0 )
-void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
+void* OSMemHeapTrim(uOSBase_t uxRegion, void *pMem, uOSMemSize_t newsize)
 {
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
     uOSMemSize_t size = 0U;
     uOSMemSize_t ptr = 0U, ptr2 = 0U;
     tOSMem_t *ptOSMemTemp = OS_NULL, *ptOSMemTemp2 = OS_NULL;
@@ -245,19 +389,15 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
         newsize = OSMIN_SIZE_ALIGNED;
     }
 
-    if (newsize > OSMEM_SIZE_ALIGNED) 
+    if (newsize > ptHeap->SizeAligned) 
     {
         return OS_NULL;
     }
 
-    if ((uOS8_t *)pMem < (uOS8_t *)gpOSMemBegin || (uOS8_t *)pMem >= (uOS8_t *)gpOSMemEnd) 
-    {
-        return pMem;
-    }
     // Get the corresponding tOSMem_t 
     ptOSMemTemp = (tOSMem_t *)(void *)((uOS8_t *)pMem - SIZEOF_OSMEM_ALIGNED);
     // Get its offset pointer 
-    ptr = (uOSMemSize_t)((uOS8_t *)ptOSMemTemp - gpOSMemBegin);
+    ptr = (uOSMemSize_t)((uOS8_t *)ptOSMemTemp - ptHeap->pBegin);
 
     size = ptOSMemTemp->NextMem - ptr - SIZEOF_OSMEM_ALIGNED;
     if (newsize > size) 
@@ -272,9 +412,9 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
     }
 
     // protect the heap from concurrent access 
-    OSIntLock();
+    OSMemLock();
 
-    ptOSMemTemp2 = (tOSMem_t *)(void *)&gpOSMemBegin[ptOSMemTemp->NextMem];
+    ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMemTemp->NextMem];
     if(ptOSMemTemp2->Used == 0) 
     {
         // The next struct is unused, we can simply move it at little 
@@ -283,11 +423,11 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
         NextMem = ptOSMemTemp2->NextMem;
         // create new tOSMem_t which is moved directly after the shrinked ptOSMemTemp 
         ptr2 = ptr + SIZEOF_OSMEM_ALIGNED + newsize;
-        if (gpOSMemLFree == ptOSMemTemp2) 
+        if (ptHeap->pLFree == ptOSMemTemp2) 
         {
-            gpOSMemLFree = (tOSMem_t *)(void *)&gpOSMemBegin[ptr2];
+            ptHeap->pLFree = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
         }
-        ptOSMemTemp2 = (tOSMem_t *)(void *)&gpOSMemBegin[ptr2];
+        ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
         ptOSMemTemp2->Used = 0;
         // restore the next pointer 
         ptOSMemTemp2->NextMem = NextMem;
@@ -298,9 +438,9 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
         // last thing to restore linked list: as we have moved ptOSMemTemp2,
         // let 'ptOSMemTemp2->NextMem->PrevMem' point to ptOSMemTemp2 again. but only if ptOSMemTemp2->NextMem is not
         // the end of the heap 
-        if (ptOSMemTemp2->NextMem != OSMEM_SIZE_ALIGNED) 
+        if (ptOSMemTemp2->NextMem != ptHeap->SizeAligned) 
         {
-            ((tOSMem_t *)(void *)&gpOSMemBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
+            ((tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
         }
         // no need to combine, we've already done that 
     } 
@@ -311,18 +451,18 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
         // Old size ('size') must be big enough to contain at least 'newsize' plus a tOSMem_t
         // ('SIZEOF_OSMEM_ALIGNED') with some data ('OSMIN_SIZE_ALIGNED').
         ptr2 = ptr + SIZEOF_OSMEM_ALIGNED + newsize;
-        ptOSMemTemp2 = (tOSMem_t *)(void *)&gpOSMemBegin[ptr2];
-        if (ptOSMemTemp2 < gpOSMemLFree) 
+        ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
+        if (ptOSMemTemp2 < ptHeap->pLFree) 
         {
-            gpOSMemLFree = ptOSMemTemp2;
+            ptHeap->pLFree = ptOSMemTemp2;
         }
         ptOSMemTemp2->Used = 0;
         ptOSMemTemp2->NextMem = ptOSMemTemp->NextMem;
         ptOSMemTemp2->PrevMem = ptr;
         ptOSMemTemp->NextMem = ptr2;
-        if (ptOSMemTemp2->NextMem != OSMEM_SIZE_ALIGNED) 
+        if (ptOSMemTemp2->NextMem != ptHeap->SizeAligned) 
         {
-            ((tOSMem_t *)(void *)&gpOSMemBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
+            ((tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
         }
         // the original ptOSMemTemp->NextMem is Used, so no need to combine! 
     }
@@ -334,33 +474,143 @@ void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
         -> the remaining space stays unused since it is too small
     } 
 */
-  OSIntUnlock();
+#if ( OS_MEM_STATS_ON!=0 )
+    // the bytes cut off are free now 
+    ptHeap->FreeSize += size - (ptOSMemTemp->NextMem - ptr - SIZEOF_OSMEM_ALIGNED);
+    ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+  OSMemUnlock();
   return pMem;
 }
 #endif /* OS_MEMFREE_ON */
 
 /***************************************************************************** 
-Function    : OSMemMalloc 
-Description : Allocate a block of memory with a minimum of 'size' bytes.
-Input       : size -- the minimum size of the requested block in bytes.
+Function    : OSMemHeapGetSize 
+Description : The data size of a block returned by OSMemHeapMalloc().
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to the block.
 Output      : None 
-Return      : pointer to allocated memory or OS_NULL if no free memory was found.
-              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+Return      : the size in bytes, at least the size asked for.
 *****************************************************************************/ 
-void* OSMemMalloc(uOSMemSize_t size)
+#if ( OS_MEMFREE_ON != 0 )
+uOSMemSize_t OSMemHeapGetSize(uOSBase_t uxRegion, void *pMem)
 {
-    uOS8_t * pResult = OS_NULL;
-    uOSMemSize_t ptr = 0U, ptr2 = 0U;
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    tOSMem_t *ptOSMemTemp = (tOSMem_t *)(void *)((uOS8_t *)pMem - SIZEOF_OSMEM_ALIGNED);
+
+    return (uOSMemSize_t)(ptOSMemTemp->NextMem - ((uOS8_t *)ptOSMemTemp - ptHeap->pBegin) - SIZEOF_OSMEM_ALIGNED);
+}
+
+/***************************************************************************** 
+Function    : OSMemHeapGrow 
+Description : Grow memory returned by OSMemHeapMalloc() in place, by taking
+              the start of the next tOSMem_t if it is unused and large enough.
+Input       : uxRegion -- index of the region pMem belongs to.
+              pMem -- the pointer to memory allocated by OSMemHeapMalloc.
+              newsize -- required size after growing.
+Output      : None 
+Return      : OS_TRUE if the block holds newsize bytes now, OS_FALSE if it 
+              could not grow, in which case pMem is NOT touched.
+*****************************************************************************/ 
+uOSBool_t OSMemHeapGrow(uOSBase_t uxRegion, void *pMem, uOSMemSize_t newsize)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    uOSBool_t bReturn = OS_FALSE;
+    uOSMemSize_t ptr = 0U, ptr2 = 0U, NextMem = 0U;
     tOSMem_t *ptOSMemTemp = OS_NULL, *ptOSMemTemp2 = OS_NULL;
 
-    if(gpOSMemEnd==OS_NULL)
+    // Expand the size of the allocated memory region so that we can adjust for alignment. 
+    newsize = OSMEM_ALIGN_SIZE(newsize);
+
+    if (newsize > ptHeap->SizeAligned) 
     {
-        OSMemInit();
-        if(gpOSMemEnd==OS_NULL)
+        return OS_FALSE;
+    }
+
+    // protect the heap from concurrent access 
+    OSMemLock();
+
+    ptOSMemTemp = (tOSMem_t *)(void *)((uOS8_t *)pMem - SIZEOF_OSMEM_ALIGNED);
+    ptr = (uOSMemSize_t)((uOS8_t *)ptOSMemTemp - ptHeap->pBegin);
+    ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMemTemp->NextMem];
+
+    // the end of the heap is always Used, so ptOSMemTemp2 is a real block here 
+    if ((ptOSMemTemp2->Used == 0) && (ptOSMemTemp2->NextMem - (ptr + SIZEOF_OSMEM_ALIGNED) >= newsize)) 
+    {
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize += ptOSMemTemp->NextMem - ptr;
+#endif /* OS_MEM_STATS_ON */
+        // remember the end of the unused block 
+        NextMem = ptOSMemTemp2->NextMem;
+        if (NextMem - (ptr + SIZEOF_OSMEM_ALIGNED) >= (newsize + SIZEOF_OSMEM_ALIGNED + OSMIN_SIZE_ALIGNED)) 
+        {
+            // the rest of the unused block stays unused, moved behind the grown ptOSMemTemp 
+            ptr2 = ptr + SIZEOF_OSMEM_ALIGNED + newsize;
+            if (ptHeap->pLFree == ptOSMemTemp2) 
+            {
+                ptHeap->pLFree = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
+            }
+            ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
+            ptOSMemTemp2->Used = 0;
+            ptOSMemTemp2->NextMem = NextMem;
+            ptOSMemTemp2->PrevMem = ptr;
+            ptOSMemTemp->NextMem = ptr2;
+            if (NextMem != ptHeap->SizeAligned) 
+            {
+                ((tOSMem_t *)(void *)&ptHeap->pBegin[NextMem])->PrevMem = ptr2;
+            }
+        }
+        else 
+        {
+            // too little would be left, take the whole unused block 
+            ptOSMemTemp->NextMem = NextMem;
+            if (NextMem != ptHeap->SizeAligned) 
+            {
+                ((tOSMem_t *)(void *)&ptHeap->pBegin[NextMem])->PrevMem = ptr;
+            }
+            if (ptHeap->pLFree == ptOSMemTemp2) 
+            {
+                // Find next free block and update lowest free pointer 
+                ptHeap->pLFree = ptOSMemTemp;
+                while (ptHeap->pLFree->Used && ptHeap->pLFree != ptHeap->pEnd) 
+                {
+                    ptHeap->pLFree = (tOSMem_t *)(void *)&ptHeap->pBegin[ptHeap->pLFree->NextMem];
+                }
+            }
+        }
+#if ( OS_MEM_STATS_ON!=0 )
+        ptHeap->FreeSize -= ptOSMemTemp->NextMem - ptr;
+        if (ptHeap->FreeSize < ptHeap->MinFreeSize) 
         {
-            return pResult;
+            ptHeap->MinFreeSize = ptHeap->FreeSize;
         }
+        ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
+        bReturn = OS_TRUE;
     }
+
+    OSMemUnlock();
+
+    return bReturn;
+}
+#endif /* OS_MEMFREE_ON */
+
+/***************************************************************************** 
+Function    : OSMemHeapMalloc 
+Description : Allocate a block of memory with a minimum of 'size' bytes from a heap region.
+Input       : uxRegion -- index of the region.
+              size -- the minimum size of the requested block in bytes.
+Output      : None 
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+*****************************************************************************/ 
+void* OSMemHeapMalloc(uOSBase_t uxRegion, uOSMemSize_t size)
+{
+    tOSMemHeap_t *ptHeap = &gtOSMemHeap[uxRegion];
+    uOS8_t * pResult = OS_NULL;
+    uOSMemSize_t ptr = 0U, ptr2 = 0U;
+    tOSMem_t *ptOSMemTemp = OS_NULL, *ptOSMemTemp2 = OS_NULL;
+
     if (size == 0) 
     {
         return pResult;
@@ -376,20 +626,20 @@ void* OSMemMalloc(uOSMemSize_t size)
         size = OSMIN_SIZE_ALIGNED;
     }
 
-    if (size > OSMEM_SIZE_ALIGNED) 
+    if (size > ptHeap->SizeAligned) 
     {
         return pResult;
     }
 
     // protect the heap from concurrent access 
-    OSIntLock();
+    OSMemLock();
 
     // Scan through the heap searching for a free block that is big enough,
     // beginning with the lowest free block.
-    for (ptr = (uOSMemSize_t)((uOS8_t *)gpOSMemLFree - gpOSMemBegin); ptr < OSMEM_SIZE_ALIGNED - size;
-        ptr = ((tOSMem_t *)(void *)&gpOSMemBegin[ptr])->NextMem) 
+    for (ptr = (uOSMemSize_t)((uOS8_t *)ptHeap->pLFree - ptHeap->pBegin); ptr < ptHeap->SizeAligned - size;
+        ptr = ((tOSMem_t *)(void *)&ptHeap->pBegin[ptr])->NextMem) 
     {
-        ptOSMemTemp = (tOSMem_t *)(void *)&gpOSMemBegin[ptr];
+        ptOSMemTemp = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr];
 
         if ((!ptOSMemTemp->Used) && (ptOSMemTemp->NextMem - (ptr + SIZEOF_OSMEM_ALIGNED)) >= size) 
         {
@@ -406,7 +656,7 @@ void* OSMemMalloc(uOSMemSize_t size)
                 // tOSMem_t would fit in but no data between ptOSMemTemp2 and ptOSMemTemp2->NextMem
                 ptr2 = ptr + SIZEOF_OSMEM_ALIGNED + size;
                 // create ptOSMemTemp2 struct 
-                ptOSMemTemp2 = (tOSMem_t *)(void *)&gpOSMemBegin[ptr2];
+                ptOSMemTemp2 = (tOSMem_t *)(void *)&ptHeap->pBegin[ptr2];
                 ptOSMemTemp2->Used = 0;
                 ptOSMemTemp2->NextMem = ptOSMemTemp->NextMem;
                 ptOSMemTemp2->PrevMem = ptr;
@@ -414,9 +664,9 @@ void* OSMemMalloc(uOSMemSize_t size)
                 ptOSMemTemp->NextMem = ptr2;
                 ptOSMemTemp->Used = 1;
 
-                if (ptOSMemTemp2->NextMem != OSMEM_SIZE_ALIGNED) 
+                if (ptOSMemTemp2->NextMem != ptHeap->SizeAligned) 
                 {
-                    ((tOSMem_t *)(void *)&gpOSMemBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
+                    ((tOSMem_t *)(void *)&ptHeap->pBegin[ptOSMemTemp2->NextMem])->PrevMem = ptr2;
                 }
             } 
             else 
@@ -430,24 +680,440 @@ void* OSMemMalloc(uOSMemSize_t size)
                 ptOSMemTemp->Used = 1;
             }
 
-            if (ptOSMemTemp == gpOSMemLFree) 
+            if (ptOSMemTemp == ptHeap->pLFree) 
             {
                 // Find next free block after ptOSMemTemp and update lowest free pointer 
-                while (gpOSMemLFree->Used && gpOSMemLFree != gpOSMemEnd) 
+                while (ptHeap->pLFree->Used && ptHeap->pLFree != ptHeap->pEnd) 
                 {
-                    gpOSMemLFree = (tOSMem_t *)(void *)&gpOSMemBegin[gpOSMemLFree->NextMem];
+                    ptHeap->pLFree = (tOSMem_t *)(void *)&ptHeap->pBegin[ptHeap->pLFree->NextMem];
                 }
             }
+#if ( OS_MEM_STATS_ON!=0 )
+            ptHeap->FreeSize -= ptOSMemTemp->NextMem - ptr;
+            if (ptHeap->FreeSize < ptHeap->MinFreeSize) 
+            {
+                ptHeap->MinFreeSize = ptHeap->FreeSize;
+            }
+            ptHeap->Changes++;
+#endif /* OS_MEM_STATS_ON */
             pResult = (uOS8_t *)ptOSMemTemp + SIZEOF_OSMEM_ALIGNED;
             break;
         }
     }
 
-    OSIntUnlock();
+    OSMemUnlock();
+
+    return pResult;
+}
+
+#endif /* OS_MEM_TLSF_ON */
+
+#if ( OSMEM_REGION_NUM > 1U )
+/** placement attributes of the regions, in the order they were added */
+static uOS8_t gucOSMemRegionAttr[ OSMEM_REGION_NUM ];
+#endif /* OSMEM_REGION_NUM */
+/** number of regions in use, 0 until the heap is initialized */
+static uOSBase_t guxOSMemRegionNum = 0U;
+
+#if ( OS_MEM_STATS_ON!=0 )
+/** calls of OSMemMalloc which succeeded and failed, calls of OSMemFree */
+static uOS32_t gulOSMemAllocCount = 0U;
+static uOS32_t gulOSMemFailCount = 0U;
+static uOS32_t gulOSMemFreeCount = 0U;
+#endif /* OS_MEM_STATS_ON */
+
+#if ( OS_MEM_SCHEDULE_LOCK_ON!=0 )
+/***************************************************************************** 
+Function    : OSMemLock 
+Description : Lock the heap by locking the scheduler, the interrupts stay on
+              while the free list is scanned. Before OSStart() there is no
+              other task and the ISRs never use the heap in this mode, so
+              nothing has to be locked.
+Input       : None
+Output      : None 
+Return      : None 
+*****************************************************************************/ 
+void OSMemLock(void)
+{
+    if (OSScheduleGetState() != SCHEDULER_NOT_STARTED) 
+    {
+        OSScheduleLock();
+    }
+}
+
+/***************************************************************************** 
+Function    : OSMemUnlock 
+Description : Unlock the heap locked by OSMemLock(), a task made ready
+              meanwhile is switched to here.
+Input       : None
+Output      : None 
+Return      : None 
+*****************************************************************************/ 
+void OSMemUnlock(void)
+{
+    if (OSScheduleGetState() != SCHEDULER_NOT_STARTED) 
+    {
+        (void)OSScheduleUnlock();
+    }
+}
+#endif /* OS_MEM_SCHEDULE_LOCK_ON */
+
+/***************************************************************************** 
+Function    : OSMemInit 
+Description : Zero the heap (OSRamHeap) and make it the first region,
+              the regions added before are forgotten.
+Input       : None
+Output      : None 
+Return      : None 
+*****************************************************************************/
+uOSBase_t OSMemInit(void)
+{
+    guxOSMemRegionNum = 0U;
+#if ( OS_MEM_STATS_ON!=0 )
+    gulOSMemAllocCount = 0U;
+    gulOSMemFailCount = 0U;
+    gulOSMemFreeCount = 0U;
+#endif /* OS_MEM_STATS_ON */
+    if (OSMemHeapInit(0U, OS_NULL, 0U) == OS_TRUE) 
+    {
+#if ( OSMEM_REGION_NUM > 1U )
+        gucOSMemRegionAttr[0] = (uOS8_t)OSMEM_HEAP_ATTR;
+#endif /* OSMEM_REGION_NUM */
+        guxOSMemRegionNum = 1U;
+    }
+
+    return 0U;
+}
+
+/***************************************************************************** 
+Function    : OSMemAddRegion 
+Description : Add a block of memory (CCM/DTCM, another SRAM bank, external SDRAM...)
+              to the heap. It must be called after OSInit() and before the
+              memory is needed, a region can not be removed.
+Input       : pvStart -- start of the region.
+              ulSize -- size of the region in bytes, the part above
+                        OSMEM_REGION_MAX_SIZE is not used.
+              ucAttr -- OSMEM_REGION_FAST, OSMEM_REGION_DMA and OSMEM_REGION_BULK
+                        flags telling what the region is good for.
+Output      : None 
+Return      : OS_TRUE if the region was added, OS_FALSE if all the OSMEM_REGION_NUM
+              regions are used or the region is too small.
+*****************************************************************************/
+#if ( OSMEM_REGION_NUM > 1U )
+uOSBool_t OSMemAddRegion(void *pvStart, uOS32_t ulSize, uOS8_t ucAttr)
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+    if (pvStart == OS_NULL) 
+    {
+        return bReturn;
+    }
+    if (guxOSMemRegionNum == 0U) 
+    {
+        OSMemInit();
+    }
+
+    OSMemLock();
+    if (guxOSMemRegionNum < OSMEM_REGION_NUM) 
+    {
+        if (OSMemHeapInit(guxOSMemRegionNum, pvStart, ulSize) == OS_TRUE) 
+        {
+            gucOSMemRegionAttr[guxOSMemRegionNum] = ucAttr;
+            guxOSMemRegionNum++;
+            bReturn = OS_TRUE;
+        }
+    }
+    OSMemUnlock();
+
+    return bReturn;
+}
+#endif /* OSMEM_REGION_NUM */
+
+/***************************************************************************** 
+Function    : OSMemMallocRegions 
+Description : Allocate from the first region, in the order they were added,
+              which has all the attributes of 'ucHint', without counting the call.
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+*****************************************************************************/ 
+static void* OSMemMallocRegions(uOSMemSize_t size, uOS8_t ucHint)
+{
+    void *pResult = OS_NULL;
+    uOSBase_t uxRegion = 0U;
+
+#if ( OSMEM_REGION_NUM == 1U )
+    (void)ucHint;
+#endif /* OSMEM_REGION_NUM */
+
+    if (guxOSMemRegionNum == 0U) 
+    {
+        OSMemInit();
+    }
+
+    for (uxRegion = 0U; (pResult == OS_NULL) && (uxRegion < guxOSMemRegionNum); uxRegion++) 
+    {
+#if ( OSMEM_REGION_NUM > 1U )
+        if ((gucOSMemRegionAttr[uxRegion] & ucHint) != ucHint) 
+        {
+            continue;
+        }
+#endif /* OSMEM_REGION_NUM */
+        pResult = OSMemHeapMalloc(uxRegion, size);
+    }
+
+    return pResult;
+}
+
+/***************************************************************************** 
+Function    : OSMemMallocCount 
+Description : Count an allocation call once it has ultimately succeeded or failed.
+*****************************************************************************/ 
+static void OSMemMallocCount(void *pResult)
+{
+#if ( OS_MEM_STATS_ON!=0 )
+    OSMemLock();
+    if (pResult != OS_NULL) 
+    {
+        gulOSMemAllocCount++;
+    }
+    else 
+    {
+        gulOSMemFailCount++;
+    }
+    OSMemUnlock();
+#else
+    (void)pResult;
+#endif /* OS_MEM_STATS_ON */
+}
+
+/***************************************************************************** 
+Function    : OSMemMallocHint 
+Description : Allocate a block of memory with a minimum of 'size' bytes from the
+              first region, in the order they were added, which has all the
+              attributes of 'ucHint'.
+Input       : size -- the minimum size of the requested block in bytes.
+              ucHint -- OSMEM_REGION_FAST, OSMEM_REGION_DMA, OSMEM_REGION_BULK
+                        or OSMEM_REGION_ANY for any region.
+Output      : None 
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+*****************************************************************************/ 
+void* OSMemMallocHint(uOSMemSize_t size, uOS8_t ucHint)
+{
+    void *pResult = OSMemMallocRegions(size, ucHint);
+
+    OSMemMallocCount(pResult);
+
+    return pResult;
+}
+
+/***************************************************************************** 
+Function    : OSMemMallocPrefer 
+Description : Allocate like OSMemMallocHint, but from any region when none of
+              those with the attributes of 'ucHint' has room. The call is
+              counted as failed only when no region has room.
+Input       : size -- the minimum size of the requested block in bytes.
+              ucHint -- OSMEM_REGION_FAST, OSMEM_REGION_DMA, OSMEM_REGION_BULK
+                        or OSMEM_REGION_ANY for any region.
+Output      : None 
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+*****************************************************************************/ 
+void* OSMemMallocPrefer(uOSMemSize_t size, uOS8_t ucHint)
+{
+    void *pResult = OSMemMallocRegions(size, ucHint);
+
+#if ( OSMEM_REGION_NUM > 1U )
+    if ((pResult == OS_NULL) && (ucHint != (uOS8_t)OSMEM_REGION_ANY)) 
+    {
+        pResult = OSMemMallocRegions(size, (uOS8_t)OSMEM_REGION_ANY);
+    }
+#endif /* OSMEM_REGION_NUM */
+
+    OSMemMallocCount(pResult);
 
     return pResult;
 }
 
+/***************************************************************************** 
+Function    : OSMemMalloc 
+Description : Allocate a block of memory with a minimum of 'size' bytes from
+              any region.
+Input       : size -- the minimum size of the requested block in bytes.
+Output      : None 
+Return      : pointer to allocated memory or OS_NULL if no free memory was found.
+              the returned value will always be aligned (as defined by OSMEM_ALIGNMENT).
+*****************************************************************************/ 
+void* OSMemMalloc(uOSMemSize_t size)
+{
+    return OSMemMallocHint(size, OSMEM_REGION_ANY);
+}
+
+#if ( OS_MEMFREE_ON != 0 )
+/***************************************************************************** 
+Function    : OSMemFindRegion 
+Description : The region pMem was allocated from.
+Return      : the index of the region, guxOSMemRegionNum if there is none.
+*****************************************************************************/ 
+static uOSBase_t OSMemFindRegion(void *pMem)
+{
+    uOSBase_t uxRegion = 0U;
+
+    for (uxRegion = 0U; uxRegion < guxOSMemRegionNum; uxRegion++) 
+    {
+        if (OSMemHeapContains(uxRegion, pMem) == OS_TRUE) 
+        {
+            break;
+        }
+    }
+    return uxRegion;
+}
+
+/***************************************************************************** 
+Function    : OSMemFree 
+Description : Put memory returned by OSMemMalloc() back on its region.
+Input       : pMem -- the pointer returned by OSMemMalloc().
+Output      : None 
+Return      : None 
+*****************************************************************************/ 
+void OSMemFree(void *pMem)
+{
+    uOSBase_t uxRegion = 0U;
+
+    if (pMem == OS_NULL) 
+    {
+        return;
+    }
+
+    uxRegion = OSMemFindRegion(pMem);
+    if (uxRegion < guxOSMemRegionNum) 
+    {
+        OSMemHeapFree(uxRegion, pMem);
+#if ( OS_MEM_STATS_ON!=0 )
+        OSMemLock();
+        gulOSMemFreeCount++;
+        OSMemUnlock();
+#endif /* OS_MEM_STATS_ON */
+    }
+}
+
+/***************************************************************************** 
+Function    : OSMemTrim 
+Description : Shrink memory returned by OSMemMalloc().
+Input       : pMem -- the pointer to memory allocated by OSMemMalloc is to be shrinked
+              newsize -- required size after shrinking (needs to be smaller than or
+                         equal to the previous size)
+Output      : None 
+Return      : for compatibility reasons: is always == pMem, at the moment
+              or OS_NULL if newsize is > old size, in which case pMem is NOT touched
+              or freed!
+*****************************************************************************/ 
+void* OSMemTrim(void *pMem, uOSMemSize_t newsize)
+{
+    uOSBase_t uxRegion = OSMemFindRegion(pMem);
+
+    if (uxRegion >= guxOSMemRegionNum) 
+    {
+        return pMem;
+    }
+    return OSMemHeapTrim(uxRegion, pMem, newsize);
+}
+
+/***************************************************************************** 
+Function    : OSMemRealloc 
+Description : Change the size of memory returned by OSMemMalloc(). It shrinks
+              like OSMemTrim(), grows in place when the memory after it is
+              free, and only else moves it to a new block of the same kind of
+              region and frees the old one.
+Input       : pMem -- the pointer to memory allocated by OSMemMalloc, or OS_NULL
+                      to allocate new memory.
+              newsize -- required size, 0 frees pMem.
+Output      : None 
+Return      : pointer to the memory, which may have moved, or OS_NULL if there
+              is not enough free memory, in which case pMem is NOT touched or freed!
+*****************************************************************************/ 
+void* OSMemRealloc(void *pMem, uOSMemSize_t newsize)
+{
+    void *pNewMem = OS_NULL;
+    uOSBase_t uxRegion = 0U;
+    uOSMemSize_t size = 0U;
+    uOS8_t ucHint = OSMEM_REGION_ANY;
+
+    if (pMem == OS_NULL) 
+    {
+        return OSMemMalloc(newsize);
+    }
+    if (newsize == 0U) 
+    {
+        OSMemFree(pMem);
+        return OS_NULL;
+    }
+
+    uxRegion = OSMemFindRegion(pMem);
+    if (uxRegion >= guxOSMemRegionNum) 
+    {
+        return OS_NULL;
+    }
+
+    size = OSMemHeapGetSize(uxRegion, pMem);
+    if (newsize <= size) 
+    {
+        return OSMemHeapTrim(uxRegion, pMem, newsize);
+    }
+    if (OSMemHeapGrow(uxRegion, pMem, newsize) == OS_TRUE) 
+    {
+        return pMem;
+    }
+
+#if ( OSMEM_REGION_NUM > 1U )
+    ucHint = gucOSMemRegionAttr[uxRegion];
+#endif /* OSMEM_REGION_NUM */
+    pNewMem = OSMemMallocHint(newsize, ucHint);
+    if (pNewMem != OS_NULL) 
+    {
+        memcpy(pNewMem, pMem, size);
+        OSMemFree(pMem);
+    }
+    return pNewMem;
+}
+#endif /* OS_MEMFREE_ON */
+
+/***************************************************************************** 
+Function    : OSMemGetStats 
+Description : Get the usage of the heap, summed over all the regions. The
+              blocks are counted a few at a time, so the heap lock is not
+              kept for the whole heap.
+Input       : None
+Output      : ptStats -- the statistics.
+Return      : None 
+*****************************************************************************/ 
+#if ( OS_MEM_STATS_ON!=0 )
+void OSMemGetStats(tOSMemStats_t *ptStats)
+{
+    uOSBase_t uxRegion = 0U;
+
+    if (ptStats == OS_NULL) 
+    {
+        return;
+    }
+    if (guxOSMemRegionNum == 0U) 
+    {
+        OSMemInit();
+    }
+
+    memset(ptStats, 0U, sizeof(tOSMemStats_t));
+    for (uxRegion = 0U; uxRegion < guxOSMemRegionNum; uxRegion++) 
+    {
+        OSMemHeapWalk(uxRegion, ptStats);
+    }
+
+    OSMemLock();
+    ptStats->ulAllocCount = gulOSMemAllocCount;
+    ptStats->ulFreeCount = gulOSMemFreeCount;
+    ptStats->ulFailCount = gulOSMemFailCount;
+    OSMemUnlock();
+}
+#endif /* OS_MEM_STATS_ON */
+
 /***************************************************************************** 
 Function    : OSMemCalloc 
 Description : Contiguously allocates enough space for count objects that are size bytes
@@ -46,22 +46,94 @@ extern "C" {
 
 #define OSMEM_SIZE            OSTOTAL_HEAP_SIZE
 
-/** OSMEM_SIZE would have to be aligned, but using 64000 here instead of
+/** Placement attributes of a heap region, also used as hints by OSMemMallocHint(). */
+#define OSMEM_REGION_ANY      ( 0x00U )   /** no requirement */
+#define OSMEM_REGION_FAST     ( 0x01U )   /** zero wait state memory, CCM/DTCM */
+#define OSMEM_REGION_DMA      ( 0x02U )   /** memory the DMA controllers can reach */
+#define OSMEM_REGION_BULK     ( 0x04U )   /** large and slow memory, external SDRAM */
+
+/** The largest region, it sets the size of uOSMemSize_t. */
+#if ( OSMEM_REGION_NUM > 1U ) && ( OSMEM_REGION_MAX_SIZE > OSMEM_SIZE )
+#define OSMEM_MAX_SIZE        OSMEM_REGION_MAX_SIZE
+#else
+#define OSMEM_MAX_SIZE        OSMEM_SIZE
+#endif
+
+/** OSMEM_MAX_SIZE would have to be aligned, but using 64000 here instead of
  * 65535 leaves some room for alignment. */
-#if OSMEM_SIZE > 64000L
+#if OSMEM_MAX_SIZE > 64000L
 typedef uOS32_t uOSMemSize_t;
 #else
 typedef uOS16_t uOSMemSize_t;
-#endif /* OSMEM_SIZE > 64000 */
+#endif /* OSMEM_MAX_SIZE > 64000 */
 
 uOSBase_t  OSMemInit(void);
+#if ( OSMEM_REGION_NUM > 1U )
+uOSBool_t OSMemAddRegion(void *pvStart, uOS32_t ulSize, uOS8_t ucAttr);
+#endif /* OSMEM_REGION_NUM */
 void *OSMemMalloc(uOSMemSize_t size);
+void *OSMemMallocHint(uOSMemSize_t size, uOS8_t ucHint);
+void *OSMemMallocPrefer(uOSMemSize_t size, uOS8_t ucHint);
 void *OSMemCalloc(uOSMemSize_t count, uOSMemSize_t size);
 
+#if ( OS_MEM_STATS_ON!=0 )
+/** Usage of the heap, see OSMemGetStats(). A block is counted with its header. */
+typedef struct tOSMemStats
+{
+    uOS32_t                     ulTotalSize;            // Size of all the regions;
+    uOS32_t                     ulFreeSize;             // Bytes which are not in used blocks;
+    uOS32_t                     ulMinFreeSize;          // Lowest ulFreeSize since OSMemInit, added up over the regions;
+    uOS32_t                     ulLargestFreeBlock;     // Data size of the largest free block;
+    uOS32_t                     ulFreeBlocks;           // Number of free blocks;
+    uOS32_t                     ulUsedBlocks;           // Number of used blocks;
+    uOS32_t                     ulAllocCount;           // Number of OSMemMalloc calls which succeeded;
+    uOS32_t                     ulFreeCount;            // Number of OSMemFree calls;
+    uOS32_t                     ulFailCount;            // Number of OSMemMalloc calls which returned OS_NULL;
+} tOSMemStats_t;
+
+void OSMemGetStats(tOSMemStats_t *ptStats);
+#endif /* OS_MEM_STATS_ON */
+
 #if ( OS_MEMFREE_ON != 0 )
 void *OSMemTrim(void *pMem, uOSMemSize_t size);
+void *OSMemRealloc(void *pMem, uOSMemSize_t size);
 void  OSMemFree(void *pMem);
+
+/** Free a kernel object, unless it was created on memory given by the application. */
+#if ( OS_STATIC_ALLOC_ON != 0 )
+#define OSMemFreeObject( ptObject )     do { if( ( ptObject )->ucStaticAlloc == OS_FALSE ) { OSMemFree( ptObject ); } } while( 0 )
+#else
+#define OSMemFreeObject( ptObject )     OSMemFree( ptObject )
+#endif /* OS_STATIC_ALLOC_ON */
+#endif /* OS_MEMFREE_ON */
+
+/** Lock of the heap: the scheduler lock with SETOS_MEM_SCHEDULE_LOCK, which keeps
+ * the interrupts on but forbids the heap in ISRs, otherwise the interrupt lock. */
+#if ( OS_MEM_SCHEDULE_LOCK_ON!=0 )
+void  OSMemLock(void);
+void  OSMemUnlock(void);
+#else
+#define OSMemLock()           OSIntLock()
+#define OSMemUnlock()         OSIntUnlock()
+#endif /* OS_MEM_SCHEDULE_LOCK_ON */
+
+/** One heap region of the allocator (first-fit or TLSF), only used by OSMemory.c. */
+uOSBool_t OSMemHeapInit(uOSBase_t uxRegion, void *pvStart, uOS32_t ulSize);
+uOSBool_t OSMemHeapContains(uOSBase_t uxRegion, void *pMem);
+void *OSMemHeapMalloc(uOSBase_t uxRegion, uOSMemSize_t size);
+#if ( OS_MEMFREE_ON != 0 )
+void *OSMemHeapTrim(uOSBase_t uxRegion, void *pMem, uOSMemSize_t size);
+uOSBool_t OSMemHeapGrow(uOSBase_t uxRegion, void *pMem, uOSMemSize_t size);
+uOSMemSize_t OSMemHeapGetSize(uOSBase_t uxRegion, void *pMem);
+void  OSMemHeapFree(uOSBase_t uxRegion, void *pMem);
 #endif /* OS_MEMFREE_ON */
+#if ( OS_MEM_STATS_ON!=0 )
+/** OSMemHeapWalk lets the pending interrupts (or tasks) in every OSMEM_WALK_STEP blocks and starts
+ * again, at most OSMEM_WALK_RETRY times, when the region changed meanwhile. */
+#define OSMEM_WALK_STEP       ( 16U )
+#define OSMEM_WALK_RETRY      ( 4U )
+void  OSMemHeapWalk(uOSBase_t uxRegion, tOSMemStats_t *ptStats);
+#endif /* OS_MEM_STATS_ON */
 
 
 /** Calculate memory size for an aligned buffer - returns the next highest
@@ -81,7 +153,7 @@ void  OSMemFree(void *pMem);
 /** Align a memory pointer to the alignment defined by OSMEM_ALIGNMENT
  * so that ADDR % OSMEM_ALIGNMENT == 0 */
 #ifndef OSMEM_ALIGN_ADDR
-#define OSMEM_ALIGN_ADDR(addr) ((void *)(((uOS32_t)(addr) + OSMEM_ALIGNMENT - 1) & ~(uOS32_t)(OSMEM_ALIGNMENT-1)))
+#define OSMEM_ALIGN_ADDR(addr) ((void *)(((uOSAddr_t)(addr) + OSMEM_ALIGNMENT - 1) & ~(uOSAddr_t)(OSMEM_ALIGNMENT-1)))
 #endif
 
 #ifdef __cplusplus
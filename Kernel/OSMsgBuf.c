@@ -0,0 +1,485 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include <string.h>
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MSGBUF_ON!=0 )
+
+/* Every message is stored behind its length. */
+typedef uOS16_t                 uOSMsgBufLen_t;
+
+TINIUX_DATA static uOSBase_t const OSMSGBUF_HEADER_SIZE     = ( ( uOSBase_t ) sizeof( uOSMsgBufLen_t ) );
+TINIUX_DATA static uOS32_t const OSMSGBUF_MAX_MSG_LEN       = ( ( uOS32_t ) 0xFFFFU );
+
+static void OSMsgBufCopyIn( tOSMsgBuf_t * const ptMsgBuf, const void * pvData, uOSBase_t uxDataLen )
+{
+    const uOS8_t *pucData = ( const uOS8_t * ) pvData;
+    uOSBase_t uxFirst = ptMsgBuf->uxLength - ptMsgBuf->uxHead;
+
+    if( uxFirst > uxDataLen )
+    {
+        uxFirst = uxDataLen;
+    }
+    ( void ) memcpy( ( void * ) &( ptMsgBuf->pucBuffer[ ptMsgBuf->uxHead ] ), ( const void * ) pucData, ( size_t ) uxFirst );
+    if( uxDataLen > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) ptMsgBuf->pucBuffer, ( const void * ) &( pucData[ uxFirst ] ), ( size_t ) ( uxDataLen - uxFirst ) );
+    }
+
+    ptMsgBuf->uxHead += uxDataLen;
+    if( ptMsgBuf->uxHead >= ptMsgBuf->uxLength )
+    {
+        ptMsgBuf->uxHead -= ptMsgBuf->uxLength;
+    }
+}
+
+static void OSMsgBufCopyOut( const tOSMsgBuf_t *ptMsgBuf, uOSBase_t uxFrom, void * pvBuffer, uOSBase_t uxBufferLen )
+{
+    uOS8_t *pucBuffer = ( uOS8_t * ) pvBuffer;
+    uOSBase_t uxFirst = ptMsgBuf->uxLength - uxFrom;
+
+    if( uxFirst > uxBufferLen )
+    {
+        uxFirst = uxBufferLen;
+    }
+    ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) &( ptMsgBuf->pucBuffer[ uxFrom ] ), ( size_t ) uxFirst );
+    if( uxBufferLen > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) &( pucBuffer[ uxFirst ] ), ( const void * ) ptMsgBuf->pucBuffer, ( size_t ) ( uxBufferLen - uxFirst ) );
+    }
+}
+
+static uOSBase_t OSMsgBufNextLen( const tOSMsgBuf_t *ptMsgBuf )
+{
+    uOSMsgBufLen_t uxMsgLen = ( uOSMsgBufLen_t ) 0U;
+
+    if( ptMsgBuf->uxCurNum != ( uOSBase_t ) 0U )
+    {
+        OSMsgBufCopyOut( ptMsgBuf, ptMsgBuf->uxTail, ( void * ) &uxMsgLen, OSMSGBUF_HEADER_SIZE );
+    }
+
+    return ( uOSBase_t ) uxMsgLen;
+}
+
+/* Must be called with the interrupts locked or masked. */
+static uOSBool_t OSMsgBufWrite( tOSMsgBuf_t * const ptMsgBuf, const void * pvData, uOSBase_t uxDataLen )
+{
+    const uOSMsgBufLen_t uxMsgLen = ( uOSMsgBufLen_t ) uxDataLen;
+
+    if( ( ptMsgBuf->uxLength - ptMsgBuf->uxUsed ) < ( uxDataLen + OSMSGBUF_HEADER_SIZE ) )
+    {
+        return OS_FALSE;
+    }
+
+    OSMsgBufCopyIn( ptMsgBuf, ( const void * ) &uxMsgLen, OSMSGBUF_HEADER_SIZE );
+    OSMsgBufCopyIn( ptMsgBuf, pvData, uxDataLen );
+
+    ptMsgBuf->uxUsed += uxDataLen + OSMSGBUF_HEADER_SIZE;
+    ptMsgBuf->uxCurNum++;
+
+    return OS_TRUE;
+}
+
+/* Must be called with the interrupts locked or masked. A message which does
+not fit into the buffer is left where it is. */
+static uOSBase_t OSMsgBufRead( tOSMsgBuf_t * const ptMsgBuf, void * pvBuffer, uOSBase_t uxBufferLen )
+{
+    uOSBase_t uxMsgLen = OSMsgBufNextLen( ptMsgBuf );
+    uOSBase_t uxFrom = ( uOSBase_t ) 0U;
+
+    if( ( uxMsgLen == ( uOSBase_t ) 0U ) || ( uxMsgLen > uxBufferLen ) )
+    {
+        return ( uOSBase_t ) 0U;
+    }
+
+    uxFrom = ptMsgBuf->uxTail + OSMSGBUF_HEADER_SIZE;
+    if( uxFrom >= ptMsgBuf->uxLength )
+    {
+        uxFrom -= ptMsgBuf->uxLength;
+    }
+    OSMsgBufCopyOut( ptMsgBuf, uxFrom, pvBuffer, uxMsgLen );
+
+    ptMsgBuf->uxTail = uxFrom + uxMsgLen;
+    if( ptMsgBuf->uxTail >= ptMsgBuf->uxLength )
+    {
+        ptMsgBuf->uxTail -= ptMsgBuf->uxLength;
+    }
+    ptMsgBuf->uxUsed -= uxMsgLen + OSMSGBUF_HEADER_SIZE;
+    ptMsgBuf->uxCurNum--;
+
+    return uxMsgLen;
+}
+
+/* Wake every blocked sender whose message fits into the free room, must be
+called with the interrupts locked or masked. */
+static uOSBool_t OSMsgBufWakeSenders( tOSMsgBuf_t * const ptMsgBuf )
+{
+    return OSTaskListEventRemoveFit( &( ptMsgBuf->tTaskListEventMsgBufV ), ( uOS32_t ) ( ptMsgBuf->uxLength - ptMsgBuf->uxUsed ) );
+}
+
+static void OSMsgBufInitNew( tOSMsgBuf_t * const ptNewMsgBuf, uOS8_t * const pucStorage, const uOSBase_t uxBufferSize )
+{
+    ptNewMsgBuf->pcMsgBufName[ 0 ] = '\0';
+    ptNewMsgBuf->pucBuffer = pucStorage;
+    ptNewMsgBuf->uxLength = uxBufferSize;
+    ptNewMsgBuf->uxHead = ( uOSBase_t ) 0U;
+    ptNewMsgBuf->uxTail = ( uOSBase_t ) 0U;
+
+    OSListInit( &( ptNewMsgBuf->tTaskListEventMsgBufV ) );
+    OSListInit( &( ptNewMsgBuf->tTaskListEventMsgBufP ) );
+
+    ptNewMsgBuf->uxUsed = ( uOSBase_t ) 0U;
+    ptNewMsgBuf->uxCurNum = ( uOSBase_t ) 0U;
+    ptNewMsgBuf->xID = 0;
+}
+
+OSMsgBufHandle_t OSMsgBufCreate( const uOSBase_t uxBufferSize )
+{
+    tOSMsgBuf_t *ptNewMsgBuf = OS_NULL;
+
+    if( uxBufferSize <= OSMSGBUF_HEADER_SIZE )
+    {
+        return ptNewMsgBuf;
+    }
+
+    ptNewMsgBuf = ( tOSMsgBuf_t * ) OSMemMalloc( sizeof( tOSMsgBuf_t ) + ( uOS32_t ) uxBufferSize );
+
+    if( ptNewMsgBuf != OS_NULL )
+    {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewMsgBuf->ucStaticAlloc = OS_FALSE;
+#endif
+        OSMsgBufInitNew( ptNewMsgBuf, ( ( uOS8_t * ) ptNewMsgBuf ) + sizeof( tOSMsgBuf_t ), uxBufferSize );
+    }
+
+    return ptNewMsgBuf;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMsgBufHandle_t OSMsgBufCreateStatic( const uOSBase_t uxBufferSize, uOS8_t * const pucStorage, tOSMsgBuf_t * const ptMsgBufBuffer )
+{
+    if( ( uxBufferSize <= OSMSGBUF_HEADER_SIZE ) || ( pucStorage == OS_NULL ) || ( ptMsgBufBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    ptMsgBufBuffer->ucStaticAlloc = OS_TRUE;
+    OSMsgBufInitNew( ptMsgBufBuffer, pucStorage, uxBufferSize );
+
+    return ptMsgBufBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSMsgBufDelete( OSMsgBufHandle_t MsgBufHandle )
+{
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    OSMemFreeObject( ptMsgBuf );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSMsgBufSetID(OSMsgBufHandle_t MsgBufHandle, sOSBase_t xID)
+{
+    if(MsgBufHandle == OS_NULL)
+    {
+        return (sOSBase_t)1;
+    }
+    OSIntLock();
+    {
+        MsgBufHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return (sOSBase_t)0;
+}
+
+sOSBase_t OSMsgBufGetID(OSMsgBufHandle_t const MsgBufHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(MsgBufHandle != OS_NULL)
+    {
+        xID = MsgBufHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+uOSBool_t OSMsgBufSend( OSMsgBufHandle_t MsgBufHandle, const void * pvData, uOSBase_t uxDataLen, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    if( ( uxDataLen == ( uOSBase_t ) 0U ) || ( ( uOS32_t ) uxDataLen > OSMSGBUF_MAX_MSG_LEN ) ||
+        ( uxDataLen > ( ptMsgBuf->uxLength - OSMSGBUF_HEADER_SIZE ) ) )
+    {
+        return OS_FALSE;
+    }
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( OSMsgBufWrite( ptMsgBuf, pvData, uxDataLen ) != OS_FALSE )
+            {
+                if( OSListIsEmpty( &( ptMsgBuf->tTaskListEventMsgBufP ) ) == OS_FALSE )
+                {
+                    if( OSTaskListEventRemove( &( ptMsgBuf->tTaskListEventMsgBufP ) ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+                }
+
+                OSIntUnlock();
+                return OS_TRUE;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //the MsgBuf is full
+                return OS_FALSE;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else
+            {
+                /* Woken up but the message still does not fit, hand the room
+                over to the senders whose messages do. */
+                if( OSMsgBufWakeSenders( ptMsgBuf ) != OS_FALSE )
+                {
+                    OSSchedule();
+                }
+                if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+                {
+                    OSIntUnlock();
+                    //the MsgBuf is full
+                    return OS_FALSE;
+                }
+            }
+
+            /* Try again once a receiver has made room or the time is up. */
+            OSTaskListEventAddNeed( &( ptMsgBuf->tTaskListEventMsgBufV ), ( uOS32_t ) ( uxDataLen + OSMSGBUF_HEADER_SIZE ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+uOSBool_t OSMsgBufSendFromISR( OSMsgBufHandle_t MsgBufHandle, const void * pvData, uOSBase_t uxDataLen )
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    if( ( uxDataLen == ( uOSBase_t ) 0U ) || ( ( uOS32_t ) uxDataLen > OSMSGBUF_MAX_MSG_LEN ) )
+    {
+        return OS_FALSE;
+    }
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        bReturn = OSMsgBufWrite( ptMsgBuf, pvData, uxDataLen );
+        if( bReturn != OS_FALSE )
+        {
+            if( OSListIsEmpty( &( ptMsgBuf->tTaskListEventMsgBufP ) ) == OS_FALSE )
+            {
+                bNeedSchedule = OSTaskListEventRemove( &( ptMsgBuf->tTaskListEventMsgBufP ) );
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+uOSBase_t OSMsgBufReceive( OSMsgBufHandle_t MsgBufHandle, void * pvBuffer, uOSBase_t uxBufferLen, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    uOSBase_t uxMsgLen = ( uOSBase_t ) 0U;
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( ptMsgBuf->uxCurNum != ( uOSBase_t ) 0U )
+            {
+                /* Zero is returned without waiting if the message is longer than the buffer. */
+                uxMsgLen = OSMsgBufRead( ptMsgBuf, pvBuffer, uxBufferLen );
+                if( uxMsgLen != ( uOSBase_t ) 0U )
+                {
+                    if( OSMsgBufWakeSenders( ptMsgBuf ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+                }
+
+                OSIntUnlock();
+                return uxMsgLen;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //the MsgBuf is empty
+                return uxMsgLen;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+            {
+                OSIntUnlock();
+                //the MsgBuf is empty
+                return uxMsgLen;
+            }
+
+            OSTaskListEventAdd( &( ptMsgBuf->tTaskListEventMsgBufP ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+uOSBase_t OSMsgBufReceiveFromISR( OSMsgBufHandle_t MsgBufHandle, void * pvBuffer, uOSBase_t uxBufferLen )
+{
+    uOSBase_t uxMsgLen = ( uOSBase_t ) 0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uxMsgLen = OSMsgBufRead( ptMsgBuf, pvBuffer, uxBufferLen );
+        if( uxMsgLen != ( uOSBase_t ) 0U )
+        {
+            bNeedSchedule = OSMsgBufWakeSenders( ptMsgBuf );
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return uxMsgLen;
+}
+
+uOSBase_t OSMsgBufGetNextLen( const OSMsgBufHandle_t MsgBufHandle )
+{
+    uOSBase_t uxReturn = (uOSBase_t)0U;
+
+    OSIntLock();
+    {
+        uxReturn = OSMsgBufNextLen( ( tOSMsgBuf_t * ) MsgBufHandle );
+    }
+    OSIntUnlock();
+
+    return uxReturn;
+}
+
+uOSBase_t OSMsgBufGetSpace( const OSMsgBufHandle_t MsgBufHandle )
+{
+    uOSBase_t uxReturn = (uOSBase_t)0U;
+    tOSMsgBuf_t * const ptMsgBuf = ( tOSMsgBuf_t * ) MsgBufHandle;
+
+    OSIntLock();
+    {
+        uxReturn = ptMsgBuf->uxLength - ptMsgBuf->uxUsed;
+    }
+    OSIntUnlock();
+
+    /* The room for the longest message which fits now. */
+    if( uxReturn > OSMSGBUF_HEADER_SIZE )
+    {
+        uxReturn -= OSMSGBUF_HEADER_SIZE;
+    }
+    else
+    {
+        uxReturn = ( uOSBase_t ) 0U;
+    }
+
+    return uxReturn;
+}
+
+uOSBase_t OSMsgBufGetMsgNum( const OSMsgBufHandle_t MsgBufHandle )
+{
+    uOSBase_t uxReturn = (uOSBase_t)0U;
+
+    OSIntLock();
+    {
+        uxReturn = ( ( tOSMsgBuf_t * ) MsgBufHandle )->uxCurNum;
+    }
+    OSIntUnlock();
+
+    return uxReturn;
+}
+
+uOSBase_t OSMsgBufGetMsgNumFromISR( const OSMsgBufHandle_t MsgBufHandle )
+{
+    return ( ( tOSMsgBuf_t * ) MsgBufHandle )->uxCurNum;
+}
+
+#endif //( OS_MSGBUF_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,103 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_MSGBUF_H_
+#define __OS_MSGBUF_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_MSGBUF_ON!=0 )
+
+/* Variable-length messages kept back to back in one ring, each one behind
+   a two-byte length, so a short message only takes the room it needs. */
+typedef struct tOSMsgBuf
+{
+    char                        pcMsgBufName[ OSNAME_MAX_LEN ];
+
+    uOS8_t *                    pucBuffer;
+    uOSBase_t                   uxLength;              // Size of the storage in bytes;
+    uOSBase_t                   uxHead;                // Next byte to write;
+    uOSBase_t                   uxTail;                // Next byte to read;
+
+    tOSList_t                   tTaskListEventMsgBufV;   // MsgBuf Send TaskList;
+    tOSList_t                   tTaskListEventMsgBufP;   // MsgBuf Recv TaskList;
+
+    volatile uOSBase_t          uxUsed;                // Bytes in use, including the length of each message;
+    volatile uOSBase_t          uxCurNum;
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;         // OS_TRUE if the memory was given by the application
+#endif
+
+    sOSBase_t                   xID;
+} tOSMsgBuf_t;
+
+typedef tOSMsgBuf_t*            OSMsgBufHandle_t;
+
+OSMsgBufHandle_t  OSMsgBufCreate( const uOSBase_t uxBufferSize ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMsgBufHandle_t  OSMsgBufCreateStatic( const uOSBase_t uxBufferSize, uOS8_t * const pucStorage, tOSMsgBuf_t * const ptMsgBufBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_MEMFREE_ON != 0 )
+void              OSMsgBufDelete( OSMsgBufHandle_t MsgBufHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSMsgBufSetID(OSMsgBufHandle_t MsgBufHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSMsgBufGetID(OSMsgBufHandle_t const MsgBufHandle) TINIUX_FUNCTION;
+
+uOSBool_t         OSMsgBufSend( OSMsgBufHandle_t MsgBufHandle, const void * pvData, uOSBase_t uxDataLen, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t         OSMsgBufSendFromISR( OSMsgBufHandle_t MsgBufHandle, const void * pvData, uOSBase_t uxDataLen ) TINIUX_FUNCTION;
+
+uOSBase_t         OSMsgBufReceive( OSMsgBufHandle_t MsgBufHandle, void * pvBuffer, uOSBase_t uxBufferLen, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBase_t         OSMsgBufReceiveFromISR( OSMsgBufHandle_t MsgBufHandle, void * pvBuffer, uOSBase_t uxBufferLen ) TINIUX_FUNCTION;
+
+uOSBase_t         OSMsgBufGetNextLen( const OSMsgBufHandle_t MsgBufHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSMsgBufGetSpace( const OSMsgBufHandle_t MsgBufHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSMsgBufGetMsgNum( const OSMsgBufHandle_t MsgBufHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSMsgBufGetMsgNumFromISR( const OSMsgBufHandle_t MsgBufHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_MSGBUF_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_MSGBUF_H_
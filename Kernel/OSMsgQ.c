@@ -55,6 +55,42 @@ TINIUX_DATA static sOSBase_t const OSMSGQ_LOCKED            = ( ( sOSBase_t ) 0
 TINIUX_DATA static sOSBase_t const OSMSGQ_SEND_TO_BACK      = ( ( sOSBase_t ) 0 );
 TINIUX_DATA static sOSBase_t const OSMSGQ_SEND_TO_FRONT     = ( ( sOSBase_t ) 1 );
 TINIUX_DATA static sOSBase_t const OSMSGQ_SEND_OVERWRITE    = ( ( sOSBase_t ) 2 );
+TINIUX_DATA static sOSBase_t const OSMSGQ_SEND_RESERVE      = ( ( sOSBase_t ) 3 );
+
+static sOS8_t * OSMsgQNextSlot( const tOSMsgQ_t *ptMsgQ, sOS8_t *pcSlot )
+{
+    pcSlot += ptMsgQ->uxItemSize;
+    if( pcSlot >= ptMsgQ->pcTail )
+    {
+        pcSlot = ptMsgQ->pcHead;
+    }
+
+    return pcSlot;
+}
+
+static uOSBool_t OSMsgQHasSpace( const tOSMsgQ_t *ptMsgQ, const sOSBase_t xPosition )
+{
+    /* A copy to the front lands in the slot just before the oldest message,
+    which must not be one that a receiver still holds. */
+    if( ( xPosition == OSMSGQ_SEND_TO_FRONT ) || ( xPosition == OSMSGQ_SEND_OVERWRITE ) )
+    {
+        if( ptMsgQ->uxAcquired != ( uOSBase_t ) 0 )
+        {
+            return OS_FALSE;
+        }
+    }
+    if( xPosition == OSMSGQ_SEND_OVERWRITE )
+    {
+        return ( ptMsgQ->uxReserved == ( uOSBase_t ) 0 ) ? OS_TRUE : OS_FALSE;
+    }
+
+    if( ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired ) < ptMsgQ->uxMaxNum )
+    {
+        return OS_TRUE;
+    }
+
+    return OS_FALSE;
+}
 
 static uOSBool_t OSMsgQIsEmpty( const tOSMsgQ_t *ptMsgQ )
 {
@@ -93,13 +129,13 @@ uOSBool_t OSMsgQIsEmptyFromISR( const tOSMsgQ_t *ptMsgQ )
     return bReturn;
 }
 
-static uOSBool_t OSMsgQIsFull( const tOSMsgQ_t *ptMsgQ )
+static uOSBool_t OSMsgQIsFull( const tOSMsgQ_t *ptMsgQ, const sOSBase_t xPosition )
 {
     uOSBool_t bReturn = OS_FALSE;
 
     OSIntLock();
     {
-        if( ptMsgQ->uxCurNum == ptMsgQ->uxMaxNum )
+        if( OSMsgQHasSpace( ptMsgQ, xPosition ) == OS_FALSE )
         {
             bReturn = OS_TRUE;
         }
@@ -118,7 +154,7 @@ uOSBool_t OSMsgQIsFullFromISR( const tOSMsgQ_t *ptMsgQ )
     uOSBool_t bReturn = OS_FALSE;
     tOSMsgQ_t *const ptMsgQTemp = (tOSMsgQ_t *)ptMsgQ;
 
-    if( ptMsgQTemp->uxCurNum == ptMsgQTemp->uxMaxNum )
+    if( ( ptMsgQTemp->uxCurNum + ptMsgQTemp->uxReserved + ptMsgQTemp->uxAcquired ) == ptMsgQTemp->uxMaxNum )
     {
         bReturn = OS_TRUE;
     }
@@ -201,11 +237,133 @@ static void OSMsgQUnlock( tOSMsgQ_t * const ptMsgQ )
     OSIntUnlock();
 }
 
+static uOSBool_t OSMsgQMarkSlot( tOSMsgQ_t * const ptMsgQ, const sOS8_t *pcFirst, uOSBase_t uxCount, const void *pvItem )
+{
+    const sOS8_t *pcItem = ( const sOS8_t * ) pvItem;
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+    uOSBase_t uxOffset = (uOSBase_t)0U;
+
+    if( ( pcItem < ptMsgQ->pcHead ) || ( pcItem >= ptMsgQ->pcTail ) ||
+        ( ( ( uOSBase_t ) ( pcItem - ptMsgQ->pcHead ) % ptMsgQ->uxItemSize ) != ( uOSBase_t ) 0 ) )
+    {
+        return OS_FALSE;
+    }
+
+    uxIndex = ( uOSBase_t ) ( pcItem - ptMsgQ->pcHead ) / ptMsgQ->uxItemSize;
+    uxOffset = ( uxIndex + ptMsgQ->uxMaxNum - ( ( uOSBase_t ) ( pcFirst - ptMsgQ->pcHead ) / ptMsgQ->uxItemSize ) ) % ptMsgQ->uxMaxNum;
+    if( ( uxOffset >= uxCount ) || ( ( ptMsgQ->pucSlotDone[ uxIndex >> 3 ] & ( uOS8_t ) ( 1U << ( uxIndex & 7U ) ) ) != 0U ) )
+    {
+        return OS_FALSE;
+    }
+
+    ptMsgQ->pucSlotDone[ uxIndex >> 3 ] |= ( uOS8_t ) ( 1U << ( uxIndex & 7U ) );
+
+    return OS_TRUE;
+}
+
+static uOSBool_t OSMsgQTakeMark( tOSMsgQ_t * const ptMsgQ, const sOS8_t *pcSlot )
+{
+    uOSBase_t uxIndex = ( uOSBase_t ) ( pcSlot - ptMsgQ->pcHead ) / ptMsgQ->uxItemSize;
+    uOS8_t ucMask = ( uOS8_t ) ( 1U << ( uxIndex & 7U ) );
+
+    if( ( ptMsgQ->pucSlotDone[ uxIndex >> 3 ] & ucMask ) == 0U )
+    {
+        return OS_FALSE;
+    }
+    ptMsgQ->pucSlotDone[ uxIndex >> 3 ] &= ( uOS8_t ) ~ucMask;
+
+    return OS_TRUE;
+}
+
+static void * OSMsgQReserveSlot( tOSMsgQ_t * const ptMsgQ )
+{
+    sOS8_t *pcSlot = ptMsgQ->pcWriteTo;
+
+    if( ptMsgQ->uxReserved == ( uOSBase_t ) 0 )
+    {
+        ptMsgQ->pcReserveFrom = pcSlot;
+    }
+    ptMsgQ->pcWriteTo = OSMsgQNextSlot( ptMsgQ, pcSlot );
+    ptMsgQ->uxReserved++;
+
+    return ( void * ) pcSlot;
+}
+
+static uOSBool_t OSMsgQCommitSlot( tOSMsgQ_t * const ptMsgQ, const void *pvItem )
+{
+    if( ptMsgQ->uxReserved == ( uOSBase_t ) 0 )
+    {
+        return OS_FALSE;
+    }
+
+    /* A slot committed ahead of an older reservation is only marked; it becomes
+    readable when the older one is committed, so messages keep their order. */
+    if( ptMsgQ->pcReserveFrom != ( const sOS8_t * ) pvItem )
+    {
+        return OSMsgQMarkSlot( ptMsgQ, ptMsgQ->pcReserveFrom, ptMsgQ->uxReserved, pvItem );
+    }
+
+    do
+    {
+        ptMsgQ->pcReserveFrom = OSMsgQNextSlot( ptMsgQ, ptMsgQ->pcReserveFrom );
+        ptMsgQ->uxReserved--;
+        ptMsgQ->uxCurNum++;
+    } while( ( ptMsgQ->uxReserved != ( uOSBase_t ) 0 ) && ( OSMsgQTakeMark( ptMsgQ, ptMsgQ->pcReserveFrom ) != OS_FALSE ) );
+
+    return OS_TRUE;
+}
+
+static void * OSMsgQAcquireSlot( tOSMsgQ_t * const ptMsgQ )
+{
+    ptMsgQ->pcReadFrom = OSMsgQNextSlot( ptMsgQ, ptMsgQ->pcReadFrom );
+    if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
+    {
+        ptMsgQ->pcAcquireFrom = ptMsgQ->pcReadFrom;
+    }
+    ptMsgQ->uxCurNum--;
+    ptMsgQ->uxAcquired++;
+
+    return ( void * ) ptMsgQ->pcReadFrom;
+}
+
+static uOSBool_t OSMsgQReleaseSlot( tOSMsgQ_t * const ptMsgQ, const void *pvItem )
+{
+    if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
+    {
+        return OS_FALSE;
+    }
+
+    /* The space of a slot released ahead of an older one is reclaimed with it. */
+    if( ptMsgQ->pcAcquireFrom != ( const sOS8_t * ) pvItem )
+    {
+        return OSMsgQMarkSlot( ptMsgQ, ptMsgQ->pcAcquireFrom, ptMsgQ->uxAcquired, pvItem );
+    }
+
+    do
+    {
+        ptMsgQ->pcAcquireFrom = OSMsgQNextSlot( ptMsgQ, ptMsgQ->pcAcquireFrom );
+        ptMsgQ->uxAcquired--;
+    } while( ( ptMsgQ->uxAcquired != ( uOSBase_t ) 0 ) && ( OSMsgQTakeMark( ptMsgQ, ptMsgQ->pcAcquireFrom ) != OS_FALSE ) );
+
+    return OS_TRUE;
+}
+
 static uOSBool_t OSMsgQCopyDataIn( tOSMsgQ_t * const ptMsgQ, const void *pvItemToQueue, const sOSBase_t xPosition )
 {
     uOSBool_t bReturn = OS_FALSE;
     uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
+    void *pvSlot = OS_NULL;
     
+    if( ( xPosition == OSMSGQ_SEND_TO_BACK ) && ( ptMsgQ->uxReserved != ( uOSBase_t ) 0 ) )
+    {
+        /* Queue up behind the pending reservations. */
+        pvSlot = OSMsgQReserveSlot( ptMsgQ );
+        ( void ) memcpy( pvSlot, pvItemToQueue, ( size_t ) ptMsgQ->uxItemSize );
+        ( void ) OSMsgQCommitSlot( ptMsgQ, pvSlot );
+
+        return bReturn;
+    }
+
     if( xPosition == OSMSGQ_SEND_TO_BACK )
     {
         ( void ) memcpy( ( void * ) ptMsgQ->pcWriteTo, pvItemToQueue, ( size_t ) ptMsgQ->uxItemSize );
@@ -249,6 +407,106 @@ static void OSMsgQCopyDataOut( tOSMsgQ_t * const ptMsgQ, void * const pvBuffer )
     ( void ) memcpy( ( void * ) pvBuffer, ( void * ) ptMsgQ->pcReadFrom, ( size_t ) ptMsgQ->uxItemSize );
 }
 
+static void OSMsgQCopyDataFree( tOSMsgQ_t * const ptMsgQ )
+{
+    /* The slot just copied out sits behind slots that receivers still hold,
+    so it is handed back as a released slot rather than freed at once. */
+    if( ptMsgQ->uxAcquired != ( uOSBase_t ) 0 )
+    {
+        ptMsgQ->uxAcquired++;
+        ( void ) OSMsgQMarkSlot( ptMsgQ, ptMsgQ->pcAcquireFrom, ptMsgQ->uxAcquired, ptMsgQ->pcReadFrom );
+    }
+}
+
+/* Copy a batch of items to the back, there must be room for all of them. */
+static void OSMsgQCopyMultiIn( tOSMsgQ_t * const ptMsgQ, const void *pvItems, const uOSBase_t uxItemNum )
+{
+    const sOS8_t *pcItems = ( const sOS8_t * ) pvItems;
+    uOS32_t uxBytes = ( uOS32_t ) uxItemNum * ( uOS32_t ) ptMsgQ->uxItemSize;
+    uOS32_t uxFirst = ( uOS32_t ) ( ptMsgQ->pcTail - ptMsgQ->pcWriteTo );
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    if( ptMsgQ->uxReserved != ( uOSBase_t ) 0 )
+    {
+        /* Queue up item by item behind the pending reservations. */
+        for( uxIndex = 0U; uxIndex < uxItemNum; uxIndex++ )
+        {
+            ( void ) OSMsgQCopyDataIn( ptMsgQ, ( const void * ) &( pcItems[ uxIndex * ptMsgQ->uxItemSize ] ), OSMSGQ_SEND_TO_BACK );
+        }
+        return;
+    }
+
+    if( uxFirst > uxBytes )
+    {
+        uxFirst = uxBytes;
+    }
+    ( void ) memcpy( ( void * ) ptMsgQ->pcWriteTo, ( const void * ) pcItems, ( size_t ) uxFirst );
+    ptMsgQ->pcWriteTo += uxFirst;
+    if( uxBytes > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) ptMsgQ->pcHead, ( const void * ) &( pcItems[ uxFirst ] ), ( size_t ) ( uxBytes - uxFirst ) );
+        ptMsgQ->pcWriteTo = ptMsgQ->pcHead + ( uxBytes - uxFirst );
+    }
+    if( ptMsgQ->pcWriteTo >= ptMsgQ->pcTail )
+    {
+        ptMsgQ->pcWriteTo = ptMsgQ->pcHead;
+    }
+
+    ptMsgQ->uxCurNum += uxItemNum;
+}
+
+/* Copy out and remove a batch of items, there must be as many queued. */
+static void OSMsgQCopyMultiOut( tOSMsgQ_t * const ptMsgQ, void * const pvBuffer, const uOSBase_t uxItemNum )
+{
+    sOS8_t *pcBuffer = ( sOS8_t * ) pvBuffer;
+    sOS8_t *pcReadFrom = OSMsgQNextSlot( ptMsgQ, ptMsgQ->pcReadFrom );
+    uOS32_t uxBytes = ( uOS32_t ) uxItemNum * ( uOS32_t ) ptMsgQ->uxItemSize;
+    uOS32_t uxFirst = ( uOS32_t ) ( ptMsgQ->pcTail - pcReadFrom );
+    uOSBase_t uxIndex = (uOSBase_t)0U;
+
+    if( ptMsgQ->uxAcquired != ( uOSBase_t ) 0 )
+    {
+        for( uxIndex = 0U; uxIndex < uxItemNum; uxIndex++ )
+        {
+            OSMsgQCopyDataOut( ptMsgQ, ( void * ) &( pcBuffer[ uxIndex * ptMsgQ->uxItemSize ] ) );
+            OSMsgQCopyDataFree( ptMsgQ );
+        }
+        ptMsgQ->uxCurNum -= uxItemNum;
+        return;
+    }
+
+    if( uxFirst > uxBytes )
+    {
+        uxFirst = uxBytes;
+    }
+    ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, ( size_t ) uxFirst );
+    pcReadFrom += uxFirst;
+    if( uxBytes > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) &( pcBuffer[ uxFirst ] ), ( const void * ) ptMsgQ->pcHead, ( size_t ) ( uxBytes - uxFirst ) );
+        pcReadFrom = ptMsgQ->pcHead + ( uxBytes - uxFirst );
+    }
+
+    /* The read pointer is left on the last item read. */
+    ptMsgQ->pcReadFrom = pcReadFrom - ptMsgQ->uxItemSize;
+    ptMsgQ->uxCurNum -= uxItemNum;
+}
+
+/* Wake every blocked receiver whose minimum the items in the MsgQ meet,
+must be called with the interrupts locked or masked. */
+static uOSBool_t OSMsgQWakeReceivers( tOSMsgQ_t * const ptMsgQ )
+{
+    return OSTaskListEventRemoveFit( &( ptMsgQ->tTaskListEventMsgQP ), ( uOS32_t ) ptMsgQ->uxCurNum );
+}
+
+/* Wake every blocked sender whose minimum the free slots meet, must be
+called with the interrupts locked or masked. */
+static uOSBool_t OSMsgQWakeSenders( tOSMsgQ_t * const ptMsgQ )
+{
+    return OSTaskListEventRemoveFit( &( ptMsgQ->tTaskListEventMsgQV ),
+                                     ( uOS32_t ) ( ptMsgQ->uxMaxNum - ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired ) ) );
+}
+
 sOSBase_t OSMsgQReset( OSMsgQHandle_t MsgQHandle, uOSBool_t bNewQueue )
 {
     tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
@@ -257,8 +515,13 @@ sOSBase_t OSMsgQReset( OSMsgQHandle_t MsgQHandle, uOSBool_t bNewQueue )
     {
         ptMsgQ->pcTail = ptMsgQ->pcHead + ( ptMsgQ->uxMaxNum * ptMsgQ->uxItemSize );
         ptMsgQ->uxCurNum = ( uOSBase_t ) 0U;
+        ptMsgQ->uxReserved = ( uOSBase_t ) 0U;
+        ptMsgQ->uxAcquired = ( uOSBase_t ) 0U;
         ptMsgQ->pcWriteTo = ptMsgQ->pcHead;
         ptMsgQ->pcReadFrom = ptMsgQ->pcHead + ( ( ptMsgQ->uxMaxNum - ( uOSBase_t ) 1U ) * ptMsgQ->uxItemSize );
+        ptMsgQ->pcReserveFrom = ptMsgQ->pcWriteTo;
+        ptMsgQ->pcAcquireFrom = ptMsgQ->pcWriteTo;
+        ( void ) memset( ( void * ) ptMsgQ->pucSlotDone, 0, ( size_t ) ( ( ptMsgQ->uxMaxNum + 7U ) >> 3 ) );
         ptMsgQ->xMsgQPLock = OSMSGQ_UNLOCKED;
         ptMsgQ->xMsgQVLock = OSMSGQ_UNLOCKED;
 
@@ -283,10 +546,25 @@ sOSBase_t OSMsgQReset( OSMsgQHandle_t MsgQHandle, uOSBool_t bNewQueue )
     return OS_TRUE;
 }
 
+/* The storage holds the items followed by the slot bitmap, see OSMSGQ_STORAGE_SIZE. */
+static void OSMsgQInitNew( tOSMsgQ_t * const ptNewMsgQ, uOS8_t * const pucStorage, const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize )
+{
+    ptNewMsgQ->pcHead = ( sOS8_t * ) pucStorage;
+    ptNewMsgQ->pucSlotDone = pucStorage + ( ( uOS32_t ) ( uxQueueLength * uxItemSize ) + ( uOS32_t ) 1U );
+
+    ptNewMsgQ->uxMaxNum = uxQueueLength;
+    ptNewMsgQ->uxItemSize = uxItemSize;
+#if ( OS_SELECT_ON!=0 )
+    ptNewMsgQ->ptSelect = OS_NULL;
+#endif
+    ( void ) OSMsgQReset( ptNewMsgQ, OS_TRUE );
+}
+
 OSMsgQHandle_t OSMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize )
 {
     tOSMsgQ_t *ptNewMsgQ = OS_NULL;
     uOS32_t uxQSizeInBytes = (uOS32_t)0U;
+    uOS32_t uxDoneSizeInBytes = (uOS32_t)0U;
     OSMsgQHandle_t xReturn = OS_NULL;
 
     if( uxItemSize == ( uOSBase_t ) 0 )
@@ -296,17 +574,17 @@ OSMsgQHandle_t OSMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxIt
     else
     {
         uxQSizeInBytes = ( uOS32_t ) ( uxQueueLength * uxItemSize ) + ( uOS32_t ) 1U;
+        uxDoneSizeInBytes = ( ( uOS32_t ) uxQueueLength + ( uOS32_t ) 7U ) >> 3;
     }
 
-    ptNewMsgQ = ( tOSMsgQ_t * ) OSMemMalloc( sizeof( tOSMsgQ_t ) + uxQSizeInBytes );
+    ptNewMsgQ = ( tOSMsgQ_t * ) OSMemMalloc( sizeof( tOSMsgQ_t ) + uxQSizeInBytes + uxDoneSizeInBytes );
 
     if( ptNewMsgQ != OS_NULL )
     {
-        ptNewMsgQ->pcHead = ( ( sOS8_t * ) ptNewMsgQ ) + sizeof( tOSMsgQ_t );
-
-        ptNewMsgQ->uxMaxNum = uxQueueLength;
-        ptNewMsgQ->uxItemSize = uxItemSize;
-        ( void ) OSMsgQReset( ptNewMsgQ, OS_TRUE );
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewMsgQ->ucStaticAlloc = OS_FALSE;
+#endif
+        OSMsgQInitNew( ptNewMsgQ, ( ( uOS8_t * ) ptNewMsgQ ) + sizeof( tOSMsgQ_t ), uxQueueLength, uxItemSize );
 
         xReturn = ptNewMsgQ;
     }
@@ -314,12 +592,27 @@ OSMsgQHandle_t OSMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxIt
     return xReturn;
 }
 
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMsgQHandle_t OSMsgQCreateStatic( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize, uOS8_t * const pucStorage, tOSMsgQ_t * const ptMsgQBuffer )
+{
+    if( ( uxItemSize == ( uOSBase_t ) 0 ) || ( pucStorage == OS_NULL ) || ( ptMsgQBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    ptMsgQBuffer->ucStaticAlloc = OS_TRUE;
+    OSMsgQInitNew( ptMsgQBuffer, pucStorage, uxQueueLength, uxItemSize );
+
+    return ptMsgQBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
 #if ( OS_MEMFREE_ON != 0 )
 void OSMsgQDelete( OSMsgQHandle_t MsgQHandle )
 {
     tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
 
-    OSMemFree( ptMsgQ );
+    OSMemFreeObject( ptMsgQ );
 }
 #endif /* OS_MEMFREE_ON */
 
@@ -362,18 +655,28 @@ static uOSBool_t OSMsgQSendGeneral( OSMsgQHandle_t MsgQHandle, const void * cons
     {
         OSIntLock();
         {
-            if( ( ptMsgQ->uxCurNum < ptMsgQ->uxMaxNum ) || ( xCopyPosition == OSMSGQ_SEND_OVERWRITE ) )
+            if( OSMsgQHasSpace( ptMsgQ, xCopyPosition ) != OS_FALSE )
             {
+                const uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
+
                 bNeedSchedule = OSMsgQCopyDataIn( ptMsgQ, pvItemToQueue, xCopyPosition );
 
-                if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQP ) ) == OS_FALSE )
+                /* An item queued behind a pending reservation is only marked,
+                the receivers are woken when the reservation is committed. */
+                if( ptMsgQ->uxCurNum != uxCurNum )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
+                    if( OSMsgQWakeReceivers( ptMsgQ ) != OS_FALSE )
                     {
-                        OSSchedule();
+                        bNeedSchedule = OS_TRUE;
+                    }
+#if ( OS_SELECT_ON!=0 )
+                    if( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE )
+                    {
+                        bNeedSchedule = OS_TRUE;
                     }
+#endif /* OS_SELECT_ON */
                 }
-                else if( bNeedSchedule != OS_FALSE )
+                if( bNeedSchedule != OS_FALSE )
                 {
                     OSSchedule();
                 }
@@ -405,9 +708,9 @@ static uOSBool_t OSMsgQSendGeneral( OSMsgQHandle_t MsgQHandle, const void * cons
 
         if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
         {
-            if( OSMsgQIsFull( ptMsgQ ) != OS_FALSE )
+            if( OSMsgQIsFull( ptMsgQ, xCopyPosition ) != OS_FALSE )
             {
-                OSTaskListEventAdd( &( ptMsgQ->tTaskListEventMsgQV ), uxTicksToWait );
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQV ), 1UL, uxTicksToWait );
 
                 OSMsgQUnlock( ptMsgQ );
 
@@ -457,28 +760,32 @@ static uOSBool_t OSMsgQSendGeneralFromISR( OSMsgQHandle_t MsgQHandle, const void
 
     uxIntSave = OSIntMaskFromISR();
     {
-        if( ( ptMsgQ->uxCurNum < ptMsgQ->uxMaxNum ) || ( xCopyPosition == OSMSGQ_SEND_OVERWRITE ) )
+        if( OSMsgQHasSpace( ptMsgQ, xCopyPosition ) != OS_FALSE )
         {
             const sOSBase_t xMsgQVLock = ptMsgQ->xMsgQVLock;
+            const uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
     
             ( void ) OSMsgQCopyDataIn( ptMsgQ, pvItemToQueue, xCopyPosition );
 
-            if( xMsgQVLock == OSMSGQ_UNLOCKED )
+            if( ptMsgQ->uxCurNum != uxCurNum )
             {
-                if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQP ) ) == OS_FALSE )
+                if( xMsgQVLock == OSMSGQ_UNLOCKED )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQP ) ) != OS_FALSE )
+                    if( ( OSMsgQWakeReceivers( ptMsgQ ) != OS_FALSE ) && ( pbNeedSchedule != OS_NULL ) )
                     {
-                        if( pbNeedSchedule != OS_NULL )
-                        {
-                            *pbNeedSchedule = OS_TRUE;
-                        }
+                        *pbNeedSchedule = OS_TRUE;
                     }
                 }
-            }
-            else
-            {
-                ptMsgQ->xMsgQVLock = ( sOSBase_t )(xMsgQVLock + 1);
+                else
+                {
+                    ptMsgQ->xMsgQVLock = ( sOSBase_t )( xMsgQVLock + ( sOSBase_t ) ( ptMsgQ->uxCurNum - uxCurNum ) );
+                }
+#if ( OS_SELECT_ON!=0 )
+                if( ( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE ) && ( pbNeedSchedule != OS_NULL ) )
+                {
+                    *pbNeedSchedule = OS_TRUE;
+                }
+#endif /* OS_SELECT_ON */
             }
 
             bReturn = OS_TRUE;
@@ -551,12 +858,14 @@ uOSBool_t OSMsgQReceive( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSTi
             if( uxCurNum > ( uOSBase_t ) 0 )
             {
                 OSMsgQCopyDataOut( ptMsgQ, pvBuffer );
+                OSMsgQCopyDataFree( ptMsgQ );
 
                 ptMsgQ->uxCurNum = uxCurNum - ( uOSBase_t ) 1U;
 
-                if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQV ) ) == OS_FALSE )
+                /* A slot read behind acquired ones is freed when they are released. */
+                if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQV ) ) != OS_FALSE )
+                    if( OSMsgQWakeSenders( ptMsgQ ) != OS_FALSE )
                     {
                         OSSchedule();
                     }
@@ -591,7 +900,7 @@ uOSBool_t OSMsgQReceive( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSTi
         {
             if( OSMsgQIsEmpty( ptMsgQ ) != OS_FALSE )
             {
-                OSTaskListEventAdd( &( ptMsgQ->tTaskListEventMsgQP ), uxTicksToWait );
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQP ), 1UL, uxTicksToWait );
                 OSMsgQUnlock( ptMsgQ );
                 if( OSScheduleUnlock() == OS_FALSE )
                 {
@@ -678,7 +987,7 @@ uOSBool_t OSMsgQPeek( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSTick_
         {
             if( OSMsgQIsEmpty( ptMsgQ ) != OS_FALSE )
             {
-                OSTaskListEventAdd( &( ptMsgQ->tTaskListEventMsgQP ), uxTicksToWait );
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQP ), 1UL, uxTicksToWait );
                 OSMsgQUnlock( ptMsgQ );
                 if( OSScheduleUnlock() == OS_FALSE )
                 {
@@ -722,21 +1031,19 @@ uOSBool_t OSMsgQReceiveFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer
             const sOSBase_t xMsgQPLock = ptMsgQ->xMsgQPLock;
             
             OSMsgQCopyDataOut( ptMsgQ, pvBuffer );
+            OSMsgQCopyDataFree( ptMsgQ );
             ptMsgQ->uxCurNum = uxCurNum - (uOSBase_t) 1U;
 
-            if( xMsgQPLock == OSMSGQ_UNLOCKED )
+            if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
             {
-                if( OSListIsEmpty( &( ptMsgQ->tTaskListEventMsgQV ) ) == OS_FALSE )
+                if( xMsgQPLock == OSMSGQ_UNLOCKED )
                 {
-                    if( OSTaskListEventRemove( &( ptMsgQ->tTaskListEventMsgQV ) ) != OS_FALSE )
-                    {
-                        bNeedSchedule = OS_TRUE;
-                    }
+                    bNeedSchedule = OSMsgQWakeSenders( ptMsgQ );
+                }
+                else
+                {
+                    ptMsgQ->xMsgQPLock = ( sOSBase_t )(xMsgQPLock + 1);
                 }
-            }
-            else
-            {
-                ptMsgQ->xMsgQPLock = ( sOSBase_t )(xMsgQPLock + 1);
             }
             bReturn = OS_TRUE;
         }
@@ -782,24 +1089,620 @@ uOSBool_t OSMsgQPeekFromISR( OSMsgQHandle_t MsgQHandle,  void * const pvBuffer )
     return bReturn;
 }
 
-#if ( OS_TIMER_ON!=0 )
-void OSMsgQWait( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend )
+uOSBase_t OSMsgQSendMulti( OSMsgQHandle_t MsgQHandle, const void * const pvItems, uOSBase_t uxMinNum, uOSBase_t uxMaxNum, uOSTick_t uxTicksToWait)
 {
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    uOSBool_t bTimeOut = OS_FALSE;
+    uOSBool_t bWait = OS_FALSE;
+    uOSBool_t bBlocked = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    uOSBase_t uxSpaceNum = (uOSBase_t)0U;
     tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
-    if( bNeedSuspend != OS_FALSE )
+
+    if( uxMinNum > uxMaxNum )
     {
-        uxTicksToWait = OSPEND_FOREVER_VALUE;
+        uxMinNum = uxMaxNum;
     }
-    
-    OSMsgQLock( ptMsgQ );
-    if( ptMsgQ->uxCurNum == ( uOSBase_t ) 0U )
+    if( uxMinNum > ptMsgQ->uxMaxNum )
+    {
+        uxMinNum = ptMsgQ->uxMaxNum;
+    }
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            uxSpaceNum = ptMsgQ->uxMaxNum - ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired );
+
+            /* Wait for room for at least uxMinNum items, then send as many as fit. */
+            if( ( uxSpaceNum >= uxMinNum ) || ( uxTicksToWait == ( uOSTick_t ) 0 ) || ( bTimeOut != OS_FALSE ) )
+            {
+                if( uxSpaceNum > uxMaxNum )
+                {
+                    uxSpaceNum = uxMaxNum;
+                }
+                if( uxSpaceNum > ( uOSBase_t ) 0 )
+                {
+                    OSMsgQCopyMultiIn( ptMsgQ, pvItems, uxSpaceNum );
+
+                    /* One pass wakes all the receivers the items can serve. */
+                    if( OSMsgQWakeReceivers( ptMsgQ ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+#if ( OS_SELECT_ON!=0 )
+                    if( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE )
+                    {
+                        OSSchedule();
+                    }
+#endif /* OS_SELECT_ON */
+                }
+
+                OSIntUnlock();
+                return uxSpaceNum;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+        }
+        OSIntUnlock();
+
+        /* Interrupts and other tasks can send to or receive from the MsgQ
+        To avoid confusion, we lock the scheduler and the MsgQ. */
+        OSScheduleLock();
+        OSMsgQLock( ptMsgQ );
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            OSIntLock();
+            {
+                bWait = ( uOSBool_t ) ( ( ptMsgQ->uxMaxNum - ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired ) ) < uxMinNum );
+
+                /* Woken up but still short of room, a single wakeup may have
+                been spent on this task, so hand the room on to the senders
+                it is enough for. */
+                if( ( bWait != OS_FALSE ) && ( bBlocked != OS_FALSE ) )
+                {
+                    ( void ) OSMsgQWakeSenders( ptMsgQ );
+                }
+            }
+            OSIntUnlock();
+
+            if( bWait != OS_FALSE )
+            {
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQV ), ( uOS32_t ) uxMinNum, uxTicksToWait );
+                bBlocked = OS_TRUE;
+
+                OSMsgQUnlock( ptMsgQ );
+
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                OSMsgQUnlock( ptMsgQ );
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            /* The timeout has expired, send what fits now. */
+            OSMsgQUnlock( ptMsgQ );
+            ( void ) OSScheduleUnlock();
+            bTimeOut = OS_TRUE;
+        }
+    }
+}
+
+uOSBase_t OSMsgQReceiveMulti( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSBase_t uxMinNum, uOSBase_t uxMaxNum, uOSTick_t uxTicksToWait)
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    uOSBool_t bTimeOut = OS_FALSE;
+    uOSBool_t bWait = OS_FALSE;
+    uOSBool_t bBlocked = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    uOSBase_t uxMsgNum = (uOSBase_t)0U;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    if( uxMinNum > uxMaxNum )
+    {
+        uxMinNum = uxMaxNum;
+    }
+    if( uxMinNum > ptMsgQ->uxMaxNum )
     {
-        /* There is nothing in the MsgQ, block for the specified period. */
-        OSTaskBlockAndPend( &( ptMsgQ->tTaskListEventMsgQP ), uxTicksToWait, bNeedSuspend );
+        uxMinNum = ptMsgQ->uxMaxNum;
     }
-    OSMsgQUnlock( ptMsgQ );
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            uxMsgNum = ptMsgQ->uxCurNum;
+
+            /* Wait for at least uxMinNum items, then receive as many as there are. */
+            if( ( uxMsgNum >= uxMinNum ) || ( uxTicksToWait == ( uOSTick_t ) 0 ) || ( bTimeOut != OS_FALSE ) )
+            {
+                if( uxMsgNum > uxMaxNum )
+                {
+                    uxMsgNum = uxMaxNum;
+                }
+                if( uxMsgNum > ( uOSBase_t ) 0 )
+                {
+                    OSMsgQCopyMultiOut( ptMsgQ, pvBuffer, uxMsgNum );
+
+                    if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
+                    {
+                        /* One pass wakes all the senders the free slots can serve. */
+                        if( OSMsgQWakeSenders( ptMsgQ ) != OS_FALSE )
+                        {
+                            OSSchedule();
+                        }
+                    }
+                }
+
+                OSIntUnlock();
+                return uxMsgNum;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+        }
+        OSIntUnlock();
+
+        /* Interrupts and other tasks can send to or receive from the MsgQ
+        To avoid confusion, we lock the scheduler and the MsgQ. */
+        OSScheduleLock();
+        OSMsgQLock( ptMsgQ );
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            OSIntLock();
+            {
+                bWait = ( uOSBool_t ) ( ptMsgQ->uxCurNum < uxMinNum );
+
+                /* Woken up but still short of items, hand them on to the
+                receivers they are enough for. */
+                if( ( bWait != OS_FALSE ) && ( bBlocked != OS_FALSE ) )
+                {
+                    ( void ) OSMsgQWakeReceivers( ptMsgQ );
+                }
+            }
+            OSIntUnlock();
+
+            if( bWait != OS_FALSE )
+            {
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQP ), ( uOS32_t ) uxMinNum, uxTicksToWait );
+                bBlocked = OS_TRUE;
+                OSMsgQUnlock( ptMsgQ );
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                OSMsgQUnlock( ptMsgQ );
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            /* The timeout has expired, receive what is there now. */
+            OSMsgQUnlock( ptMsgQ );
+            ( void ) OSScheduleUnlock();
+            bTimeOut = OS_TRUE;
+        }
+    }
+}
+
+uOSBase_t OSMsgQSendMultiFromISR( OSMsgQHandle_t MsgQHandle, const void * const pvItems, uOSBase_t uxMaxNum)
+{
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBase_t uxSpaceNum = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uxSpaceNum = ptMsgQ->uxMaxNum - ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired );
+        if( uxSpaceNum > uxMaxNum )
+        {
+            uxSpaceNum = uxMaxNum;
+        }
+
+        if( uxSpaceNum > ( uOSBase_t ) 0 )
+        {
+            const sOSBase_t xMsgQVLock = ptMsgQ->xMsgQVLock;
+            const uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
+
+            OSMsgQCopyMultiIn( ptMsgQ, pvItems, uxSpaceNum );
+
+            if( xMsgQVLock == OSMSGQ_UNLOCKED )
+            {
+                bNeedSchedule = OSMsgQWakeReceivers( ptMsgQ );
+            }
+            else
+            {
+                /* Only the items not held back by a reservation count. */
+                ptMsgQ->xMsgQVLock = ( sOSBase_t )( xMsgQVLock + ( sOSBase_t ) ( ptMsgQ->uxCurNum - uxCurNum ) );
+            }
+#if ( OS_SELECT_ON!=0 )
+            if( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+#endif /* OS_SELECT_ON */
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return uxSpaceNum;
+}
+
+uOSBase_t OSMsgQReceiveMultiFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSBase_t uxMaxNum)
+{
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBase_t uxMsgNum = (uOSBase_t)0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        uxMsgNum = ptMsgQ->uxCurNum;
+        if( uxMsgNum > uxMaxNum )
+        {
+            uxMsgNum = uxMaxNum;
+        }
+
+        if( uxMsgNum > ( uOSBase_t ) 0 )
+        {
+            const sOSBase_t xMsgQPLock = ptMsgQ->xMsgQPLock;
+
+            OSMsgQCopyMultiOut( ptMsgQ, pvBuffer, uxMsgNum );
+
+            if( ptMsgQ->uxAcquired == ( uOSBase_t ) 0 )
+            {
+                if( xMsgQPLock == OSMSGQ_UNLOCKED )
+                {
+                    bNeedSchedule = OSMsgQWakeSenders( ptMsgQ );
+                }
+                else
+                {
+                    ptMsgQ->xMsgQPLock = ( sOSBase_t )( xMsgQPLock + ( sOSBase_t ) uxMsgNum );
+                }
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return uxMsgNum;
+}
+
+void * OSMsgQReserve( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait)
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    void *pvItem = OS_NULL;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( OSMsgQHasSpace( ptMsgQ, OSMSGQ_SEND_RESERVE ) != OS_FALSE )
+            {
+                pvItem = OSMsgQReserveSlot( ptMsgQ );
+
+                OSIntUnlock();
+                return pvItem;
+            }
+            else
+            {
+                if( uxTicksToWait == ( uOSTick_t ) 0 )
+                {
+                    OSIntUnlock();
+                    //the MsgQ is full
+                    return OS_NULL;
+                }
+                else if( bEntryTimeSet == OS_FALSE )
+                {
+                    OSSetTimeOutState( &tTimeOut );
+                    bEntryTimeSet = OS_TRUE;
+                }
+            }
+        }
+        OSIntUnlock();
+
+        OSScheduleLock();
+        OSMsgQLock( ptMsgQ );
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            if( OSMsgQIsFull( ptMsgQ, OSMSGQ_SEND_RESERVE ) != OS_FALSE )
+            {
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQV ), 1UL, uxTicksToWait );
+
+                OSMsgQUnlock( ptMsgQ );
+
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                OSMsgQUnlock( ptMsgQ );
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            OSMsgQUnlock( ptMsgQ );
+            ( void ) OSScheduleUnlock();
+            //the MsgQ is full
+            return OS_NULL;
+        }
+    }
+}
+
+uOSBool_t OSMsgQCommit( OSMsgQHandle_t MsgQHandle, void * const pvItem)
+{
+    uOSBool_t bReturn = OS_FALSE;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    OSIntLock();
+    {
+        const uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
+
+        bReturn = OSMsgQCommitSlot( ptMsgQ, pvItem );
+
+        /* Committing the oldest reservation also publishes the slots marked
+        behind it, so wake the receivers for all of them. */
+        if( ptMsgQ->uxCurNum != uxCurNum )
+        {
+            if( OSMsgQWakeReceivers( ptMsgQ ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+#if ( OS_SELECT_ON!=0 )
+            if( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+#endif /* OS_SELECT_ON */
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+void * OSMsgQAcquire( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait)
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    void *pvItem = OS_NULL;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            if( ptMsgQ->uxCurNum > ( uOSBase_t ) 0 )
+            {
+                pvItem = OSMsgQAcquireSlot( ptMsgQ );
+
+                OSIntUnlock();
+                return pvItem;
+            }
+            else
+            {
+                if( uxTicksToWait == ( uOSTick_t ) 0 )
+                {
+                    OSIntUnlock();
+                    //the MsgQ is empty
+                    return OS_NULL;
+                }
+                else if( bEntryTimeSet == OS_FALSE )
+                {
+                    OSSetTimeOutState( &tTimeOut );
+                    bEntryTimeSet = OS_TRUE;
+                }
+            }
+        }
+        OSIntUnlock();
+
+        OSScheduleLock();
+        OSMsgQLock( ptMsgQ );
+
+        if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) == OS_FALSE )
+        {
+            if( OSMsgQIsEmpty( ptMsgQ ) != OS_FALSE )
+            {
+                OSTaskListEventAddNeed( &( ptMsgQ->tTaskListEventMsgQP ), 1UL, uxTicksToWait );
+                OSMsgQUnlock( ptMsgQ );
+                if( OSScheduleUnlock() == OS_FALSE )
+                {
+                    OSSchedule();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                OSMsgQUnlock( ptMsgQ );
+                ( void ) OSScheduleUnlock();
+            }
+        }
+        else
+        {
+            OSMsgQUnlock( ptMsgQ );
+            ( void ) OSScheduleUnlock();
+
+            if( OSMsgQIsEmpty( ptMsgQ ) != OS_FALSE )
+            {
+                //the MsgQ is empty
+                return OS_NULL;
+            }
+        }
+    }
+}
+
+uOSBool_t OSMsgQRelease( OSMsgQHandle_t MsgQHandle, void * const pvItem)
+{
+    uOSBool_t bReturn = OS_FALSE;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    OSIntLock();
+    {
+        const uOSBase_t uxAcquired = ptMsgQ->uxAcquired;
+
+        bReturn = OSMsgQReleaseSlot( ptMsgQ, pvItem );
+
+        /* Releasing the oldest slot also frees the ones released behind it. */
+        if( ptMsgQ->uxAcquired != uxAcquired )
+        {
+            if( OSMsgQWakeSenders( ptMsgQ ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+void * OSMsgQReserveFromISR( OSMsgQHandle_t MsgQHandle )
+{
+    void *pvItem = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        if( OSMsgQHasSpace( ptMsgQ, OSMSGQ_SEND_RESERVE ) != OS_FALSE )
+        {
+            pvItem = OSMsgQReserveSlot( ptMsgQ );
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return pvItem;
+}
+
+uOSBool_t OSMsgQCommitFromISR( OSMsgQHandle_t MsgQHandle, void * const pvItem)
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        const uOSBase_t uxCurNum = ptMsgQ->uxCurNum;
+        const sOSBase_t xMsgQVLock = ptMsgQ->xMsgQVLock;
+
+        bReturn = OSMsgQCommitSlot( ptMsgQ, pvItem );
+        if( ptMsgQ->uxCurNum != uxCurNum )
+        {
+            if( xMsgQVLock == OSMSGQ_UNLOCKED )
+            {
+                bNeedSchedule = OSMsgQWakeReceivers( ptMsgQ );
+            }
+            else
+            {
+                ptMsgQ->xMsgQVLock = ( sOSBase_t )( xMsgQVLock + ( sOSBase_t ) ( ptMsgQ->uxCurNum - uxCurNum ) );
+            }
+#if ( OS_SELECT_ON!=0 )
+            if( OSSelectNotify( ptMsgQ->ptSelect ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+#endif /* OS_SELECT_ON */
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
+}
+
+void * OSMsgQAcquireFromISR( OSMsgQHandle_t MsgQHandle )
+{
+    void *pvItem = OS_NULL;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        if( ptMsgQ->uxCurNum > ( uOSBase_t ) 0 )
+        {
+            pvItem = OSMsgQAcquireSlot( ptMsgQ );
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    return pvItem;
+}
+
+uOSBool_t OSMsgQReleaseFromISR( OSMsgQHandle_t MsgQHandle, void * const pvItem)
+{
+    uOSBool_t bReturn = OS_FALSE;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    tOSMsgQ_t * const ptMsgQ = ( tOSMsgQ_t * ) MsgQHandle;
+
+    uxIntSave = OSIntMaskFromISR();
+    {
+        const uOSBase_t uxAcquired = ptMsgQ->uxAcquired;
+        const sOSBase_t xMsgQPLock = ptMsgQ->xMsgQPLock;
+
+        bReturn = OSMsgQReleaseSlot( ptMsgQ, pvItem );
+        if( ptMsgQ->uxAcquired != uxAcquired )
+        {
+            if( xMsgQPLock == OSMSGQ_UNLOCKED )
+            {
+                bNeedSchedule = OSMsgQWakeSenders( ptMsgQ );
+            }
+            else
+            {
+                ptMsgQ->xMsgQPLock = ( sOSBase_t )( xMsgQPLock + ( sOSBase_t ) ( uxAcquired - ptMsgQ->uxAcquired ) );
+            }
+        }
+    }
+    OSIntUnmaskFromISR( uxIntSave );
+
+    if(SCHEDULER_RUNNING == OSScheduleGetState())
+    {
+        OSScheduleFromISR( bNeedSchedule );
+    }
+
+    return bReturn;
 }
-#endif /* ( OS_TIMER_ON!=0 ) */
 
 uOSBase_t OSMsgQGetSpaceNum( const OSMsgQHandle_t MsgQHandle )
 {
@@ -808,7 +1711,7 @@ uOSBase_t OSMsgQGetSpaceNum( const OSMsgQHandle_t MsgQHandle )
 
     OSIntLock();
     {
-        uxReturn = ptMsgQ->uxMaxNum - ptMsgQ->uxCurNum;
+        uxReturn = ptMsgQ->uxMaxNum - ( ptMsgQ->uxCurNum + ptMsgQ->uxReserved + ptMsgQ->uxAcquired );
     }
     OSIntUnlock();
 
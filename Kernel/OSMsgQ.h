@@ -54,23 +54,42 @@ typedef struct tOSMsgQ
     sOS8_t *                    pcTail;    
     sOS8_t *                    pcWriteTo;
     sOS8_t *                    pcReadFrom;
+    sOS8_t *                    pcReserveFrom;         // Oldest slot reserved but not yet committed;
+    sOS8_t *                    pcAcquireFrom;         // Oldest slot acquired but not yet released;
+    uOS8_t *                    pucSlotDone;           // One bit per slot committed or released ahead of an older one;
     
     tOSList_t                   tTaskListEventMsgQV;   // MsgQ Send TaskList;
     tOSList_t                   tTaskListEventMsgQP;   // MsgQ Recv TaskList;
 
     volatile uOSBase_t          uxCurNum;    
+    volatile uOSBase_t          uxReserved;            // Slots held by senders between Reserve and Commit;
+    volatile uOSBase_t          uxAcquired;            // Slots held by receivers between Acquire and Release;
     uOSBase_t                   uxMaxNum;
     uOSBase_t                   uxItemSize;
 
     volatile sOSBase_t          xMsgQPLock;            // Record the number of task which received msg from the MsgQ while it was locked.
     volatile sOSBase_t          xMsgQVLock;            // Record the number of task which send msg to the MsgQ while it was locked.
 
+#if ( OS_SELECT_ON!=0 )
+    struct tOSSelect *          ptSelect;              // The select this MsgQ belongs to;
+#endif
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;         // OS_TRUE if the memory was given by the application;
+#endif
+
     sOSBase_t                   xID;
 } tOSMsgQ_t;
 
 typedef tOSMsgQ_t*              OSMsgQHandle_t;
 
+// Bytes of storage OSMsgQCreateStatic needs: the items, one spare byte and a bit per slot
+#define OSMSGQ_STORAGE_SIZE( uxQueueLength, uxItemSize )    ( ( ( uxQueueLength ) * ( uxItemSize ) ) + 1U + ( ( ( uxQueueLength ) + 7U ) >> 3 ) )
+
 OSMsgQHandle_t    OSMsgQCreate( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMsgQHandle_t    OSMsgQCreateStatic( const uOSBase_t uxQueueLength, const uOSBase_t uxItemSize, uOS8_t * const pucStorage, tOSMsgQ_t * const ptMsgQBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
 #if ( OS_MEMFREE_ON != 0 )
 void             OSMsgQDelete( OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
@@ -96,16 +115,34 @@ uOSBool_t         OSMsgQReceive( OSMsgQHandle_t MsgQHandle, void * const pvBuffe
 uOSBool_t         OSMsgQPeekFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer ) TINIUX_FUNCTION;
 uOSBool_t         OSMsgQReceiveFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer) TINIUX_FUNCTION;
 
+/* Move up to uxMaxNum items in one go, waiting until at least uxMinNum can be moved or the time
+   is up. Return the number of items moved, which is less than uxMinNum after a timeout. */
+uOSBase_t         OSMsgQSendMulti( OSMsgQHandle_t MsgQHandle, const void * const pvItems, uOSBase_t uxMinNum, uOSBase_t uxMaxNum, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+uOSBase_t         OSMsgQReceiveMulti( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSBase_t uxMinNum, uOSBase_t uxMaxNum, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+
+uOSBase_t         OSMsgQSendMultiFromISR( OSMsgQHandle_t MsgQHandle, const void * const pvItems, uOSBase_t uxMaxNum) TINIUX_FUNCTION;
+uOSBase_t         OSMsgQReceiveMultiFromISR( OSMsgQHandle_t MsgQHandle, void * const pvBuffer, uOSBase_t uxMaxNum) TINIUX_FUNCTION;
+
+/* Zero-copy access to the MsgQ storage. A sender reserves a slot, fills it in place and commits it;
+   a receiver acquires the oldest committed slot, reads it in place and releases it. Slots may be
+   committed or released in any order, but a message only becomes visible once every slot reserved
+   before it has been committed. */
+void *            OSMsgQReserve( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+uOSBool_t         OSMsgQCommit( OSMsgQHandle_t MsgQHandle, void * const pvItem) TINIUX_FUNCTION;
+void *            OSMsgQAcquire( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait) TINIUX_FUNCTION;
+uOSBool_t         OSMsgQRelease( OSMsgQHandle_t MsgQHandle, void * const pvItem) TINIUX_FUNCTION;
+
+void *            OSMsgQReserveFromISR( OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
+uOSBool_t         OSMsgQCommitFromISR( OSMsgQHandle_t MsgQHandle, void * const pvItem) TINIUX_FUNCTION;
+void *            OSMsgQAcquireFromISR( OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
+uOSBool_t         OSMsgQReleaseFromISR( OSMsgQHandle_t MsgQHandle, void * const pvItem) TINIUX_FUNCTION;
+
 uOSBase_t         OSMsgQGetSpaceNum( const OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
 uOSBase_t         OSMsgQGetMsgNum( const OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
 uOSBase_t         OSMsgQGetMsgNumFromISR( const OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
 
 sOSBase_t        OSMsgQReset( OSMsgQHandle_t MsgQHandle, uOSBool_t bNewQueue ) TINIUX_FUNCTION;
 
-#if ( OS_TIMER_ON!=0 )
-void             OSMsgQWait( OSMsgQHandle_t MsgQHandle, uOSTick_t uxTicksToWait, uOSBool_t bNeedSuspend ) TINIUX_FUNCTION;
-#endif /* ( OS_TIMER_ON!=0 ) */
-
 #endif //( OS_MSGQ_ON!=0 )
 
 #ifdef __cplusplus
@@ -161,6 +161,27 @@ static void OSMutexStatusUnlock( tOSMutex_t * const ptMutex )
 }
 
 
+static void OSMutexInitNew( tOSMutex_t * const ptNewMutex )
+{
+    /* Information required for priority inheritance. */
+    ptNewMutex->MutexHolderHandle = OS_NULL;
+
+    ptNewMutex->uxCurNum = ( uOSBase_t ) 1U;
+    ptNewMutex->uxMaxNum = ( uOSBase_t ) 1U;
+    
+    ptNewMutex->uxMutexLocked = ( uOSBase_t ) OS_FALSE;
+    
+    ptNewMutex->xMutexPLock = MUTEX_STATUS_UNLOCKED;
+    ptNewMutex->xMutexVLock = MUTEX_STATUS_UNLOCKED;
+#if ( OS_SELECT_ON!=0 )
+    ptNewMutex->ptSelect = OS_NULL;
+#endif
+
+    /* Ensure the event queues start with the correct state. */
+    OSListInit( &( ptNewMutex->tTaskListEventMutexV ) );
+    OSListInit( &( ptNewMutex->tTaskListEventMutexP ) );
+}
+
 OSMutexHandle_t OSMutexCreate( void )
 {
     tOSMutex_t *ptNewMutex = OS_NULL;
@@ -169,30 +190,32 @@ OSMutexHandle_t OSMutexCreate( void )
     ptNewMutex = ( tOSMutex_t * ) OSMemMalloc( sizeof( tOSMutex_t ) );
     if( ptNewMutex != OS_NULL )
     {
-        /* Information required for priority inheritance. */
-        ptNewMutex->MutexHolderHandle = OS_NULL;
-
-        ptNewMutex->uxCurNum = ( uOSBase_t ) 1U;
-        ptNewMutex->uxMaxNum = ( uOSBase_t ) 1U;
-        
-        ptNewMutex->uxMutexLocked = ( uOSBase_t ) OS_FALSE;
-        
-        ptNewMutex->xMutexPLock = MUTEX_STATUS_UNLOCKED;
-        ptNewMutex->xMutexVLock = MUTEX_STATUS_UNLOCKED;
-
-        /* Ensure the event queues start with the correct state. */
-        OSListInit( &( ptNewMutex->tTaskListEventMutexV ) );
-        OSListInit( &( ptNewMutex->tTaskListEventMutexP ) );
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewMutex->ucStaticAlloc = OS_FALSE;
+#endif
+        OSMutexInitNew( ptNewMutex );
     }
     return (OSMutexHandle_t)ptNewMutex;
 }
 
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMutexHandle_t OSMutexCreateStatic( tOSMutex_t * const ptMutexBuffer )
+{
+    if( ptMutexBuffer != OS_NULL )
+    {
+        ptMutexBuffer->ucStaticAlloc = OS_TRUE;
+        OSMutexInitNew( ptMutexBuffer );
+    }
+    return (OSMutexHandle_t)ptMutexBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
 #if ( OS_MEMFREE_ON != 0 )
 void OSMutexDelete( OSMutexHandle_t MutexHandle )
 {
     tOSMutex_t * const ptMutex = ( tOSMutex_t * ) MutexHandle;
 
-    OSMemFree( ptMutex );
+    OSMemFreeObject( ptMutex );
 }
 #endif /* OS_MEMFREE_ON */
 
@@ -432,6 +455,12 @@ uOSBool_t OSMutexUnlock( OSMutexHandle_t MutexHandle )
                 {
                     OSSchedule();
                 }
+#if ( OS_SELECT_ON!=0 )
+                if( OSSelectNotify( ptMutex->ptSelect ) != OS_FALSE )
+                {
+                    OSSchedule();
+                }
+#endif /* OS_SELECT_ON */
 
                 OSIntUnlock();
                 return OS_TRUE;
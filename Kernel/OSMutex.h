@@ -62,12 +62,23 @@ typedef struct tOSMutex
     volatile sOSBase_t          xMutexPLock;            // Record the number of task which lock from the mutex while it was locked.
     volatile sOSBase_t          xMutexVLock;            // Record the number of task which unlock to the mutex while it was locked.
 
+#if ( OS_SELECT_ON!=0 )
+    struct tOSSelect *          ptSelect;               // The select this mutex belongs to;
+#endif
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;          // OS_TRUE if the memory was given by the application;
+#endif
+
     sOSBase_t                   xID;
 } tOSMutex_t;
 
 typedef    tOSMutex_t*          OSMutexHandle_t;
 
 OSMutexHandle_t   OSMutexCreate( void ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSMutexHandle_t   OSMutexCreateStatic( tOSMutex_t * const ptMutexBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
 #if ( OS_MEMFREE_ON != 0 )
 void              OSMutexDelete( OSMutexHandle_t MutexHandle ) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
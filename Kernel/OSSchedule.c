@@ -41,57 +41,50 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-#if ( FITQUICK_GET_PRIORITY == 1U )
-    TINIUX_DATA static volatile  uOSBase_t guxTopReadyPriority  = OSLOWEAST_PRIORITY;
-#else
-    #if ( OSQUICK_GET_PRIORITY != 0U )
-        #if ( OSQUICK_GET_PRIORITY == 1U )
-            #define SUBPRI_MAXNUM                       ( 2 )
-            #define SUBPRI_TOPPRI                       ( 1 )
-            #define SUBPRI_MASK_WIDTH                   ( 1 )
-            #define SUBPRI_MASK_VALUE                   ( 1 )
-            #define SUBPRI_BITMAP_WIDTH                 ( 2 )
-            #define SUBPRI_BITMAP_MAXNUM                ( 4 )
-            #define SUBPRI_BITMAP_TOPBIT                ( 0x02 )
-        #else
-            #if ( OSQUICK_GET_PRIORITY == 2U )
-                #define SUBPRI_MAXNUM                   ( 4 )
-                #define SUBPRI_TOPPRI                   ( 3 )
-                #define SUBPRI_MASK_WIDTH               ( 2 )
-                #define SUBPRI_MASK_VALUE               ( 3 )
-                #define SUBPRI_BITMAP_WIDTH             ( 4 )
-                #define SUBPRI_BITMAP_MAXNUM            ( 16 )
-                #define SUBPRI_BITMAP_TOPBIT            ( 0x08 )
-            #else //( OSQUICK_GET_PRIORITY == 3U )
-                #define SUBPRI_MAXNUM                   ( 8 )
-                #define SUBPRI_TOPPRI                   ( 7 )
-                #define SUBPRI_MASK_WIDTH               ( 3 )
-                #define SUBPRI_MASK_VALUE               ( 7 )
-                #define SUBPRI_BITMAP_WIDTH             ( 8 )
-                #define SUBPRI_BITMAP_MAXNUM            ( 256 )
-                #define SUBPRI_BITMAP_TOPBIT            ( 0x80 )
-            #endif
-        #endif
-        TINIUX_DATA static uOS8_t gucSubPriorityMap[SUBPRI_BITMAP_MAXNUM];
-        TINIUX_DATA static volatile uOS8_t gucSubPriorityBit[SUBPRI_MAXNUM];
-        TINIUX_DATA static volatile uOS8_t gucSubPriorityGroupBit  = 0U;
-    #else
-    //default do nothing
-    #endif
+/* Ready priorities are kept in a two level bitmap, one bit per priority in
+gulReadyPriorityBit[] and one bit per non-empty word of it in
+gulReadyGroupBit, so the top ready priority is found with two highest bit
+lookups whatever the number of priorities. */
+#define OSREADY_GROUP_NUM                       ( ( OSHIGHEAST_PRIORITY + 31U ) >> 5U )
+
+#if ( OSREADY_GROUP_NUM > 1U )
+TINIUX_FAST_DATA static volatile  uOS32_t gulReadyGroupBit      = 0U;
+#endif
+TINIUX_FAST_DATA static volatile  uOS32_t gulReadyPriorityBit[ OSREADY_GROUP_NUM ];
+
+#if ( FITQUICK_GET_PRIORITY != 1U )
+/* Highest set bit of a nibble, the port has no count leading zeros. */
+TINIUX_DATA static const uOS8_t gucHighestBitMap[ 16 ] =
+{
+    0U, 0U, 1U, 1U, 2U, 2U, 2U, 2U, 3U, 3U, 3U, 3U, 3U, 3U, 3U, 3U
+};
 #endif
 
 TINIUX_DATA static volatile  uOSBool_t gbSchedulerRunning       = OS_FALSE;
-TINIUX_DATA static volatile  uOSBase_t guxSchedulerLocked       = ( uOSBase_t ) OS_FALSE;
-TINIUX_DATA static volatile  uOSBool_t gbNeedSchedule           = OS_FALSE;
-TINIUX_DATA static volatile  uOSTick_t guxTickCount             = ( uOSTick_t ) 0U;
+TINIUX_FAST_DATA static volatile  uOSBase_t guxSchedulerLocked  = ( uOSBase_t ) OS_FALSE;
+TINIUX_FAST_DATA static volatile  uOSBool_t gbNeedSchedule      = OS_FALSE;
+TINIUX_FAST_DATA static volatile  uOSTick_t guxTickCount        = ( uOSTick_t ) 0U;
 TINIUX_DATA static volatile  sOSBase_t gxOverflowCount          = ( sOSBase_t ) 0U;
 TINIUX_DATA static volatile  uOSBase_t guxPendedTicks           = ( uOSBase_t ) 0U;
+#if ( OS_LOWPOWER_ON!=0 )
 TINIUX_DATA static volatile  uOSTick_t guxNextUnblockTime       = ( uOSTick_t ) 0U;
+TINIUX_DATA static volatile  uOSBool_t gbNextUnblockTimeValid   = OS_FALSE;
+#endif /* OS_LOWPOWER_ON */
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+TINIUX_DATA static tOSTCB_t          gtOSIdleTCB;
+TINIUX_DATA static uOSStack_t        guxOSIdleStack[ OSMINIMAL_STACK_SIZE ];
+#endif /* OS_STATIC_ALLOC_ON */
 
 uOSBase_t OSInit( void )
 {
     uOSBase_t uxReturn = 0;
 
+#if ( OS_FAST_SECTION_ON!=0 )
+    // The fast sections must be loaded before any of their code or data is used
+    FitSectionInit( );
+#endif
+
     uxReturn += OSMemInit( );  
     uxReturn += OSScheduleInit( );  
     uxReturn += OSTaskInit( );
@@ -106,40 +99,25 @@ uOSBase_t OSInit( void )
 uOSBase_t OSScheduleInit( void )
 {
 
-#if ( FITQUICK_GET_PRIORITY == 1U )
-    guxTopReadyPriority         = OSLOWEAST_PRIORITY;
-#else
-#if ( OSQUICK_GET_PRIORITY != 0U )
-    uOS16_t uiSubPriIndex = 0;
-    uOS16_t uiBitIndex = 0;
+    uOSBase_t uxGroup = ( uOSBase_t ) 0U;
 
-    for (uiSubPriIndex = 0; uiSubPriIndex < SUBPRI_MAXNUM; uiSubPriIndex++)
+    for( uxGroup = ( uOSBase_t ) 0U; uxGroup < ( uOSBase_t ) OSREADY_GROUP_NUM; uxGroup++ )
     {
-        gucSubPriorityBit[uiSubPriIndex] = 0;
+        gulReadyPriorityBit[ uxGroup ] = 0U;
     }
-    for (uiSubPriIndex = 0; uiSubPriIndex < SUBPRI_BITMAP_MAXNUM; uiSubPriIndex++)
-    {
-        gucSubPriorityMap[uiSubPriIndex] = 0;
-        for (uiBitIndex = 0; uiBitIndex < SUBPRI_BITMAP_WIDTH; uiBitIndex++)
-        {
-            if (((uiSubPriIndex << uiBitIndex) & SUBPRI_BITMAP_TOPBIT) != 0)
-            {
-                gucSubPriorityMap[uiSubPriIndex] = SUBPRI_TOPPRI - uiBitIndex;
-                break;
-            }
-        }
-    }
-#else
-    //Default do nothing
+#if ( OSREADY_GROUP_NUM > 1U )
+    gulReadyGroupBit            = 0U;
 #endif
-#endif
-    
+
     guxTickCount                = ( uOSTick_t ) 0U;
     gbSchedulerRunning          = OS_FALSE;
     guxPendedTicks              = ( uOSBase_t ) 0U;
     gbNeedSchedule              = OS_FALSE;
     guxSchedulerLocked          = ( uOSBase_t ) OS_FALSE;
+#if ( OS_LOWPOWER_ON!=0 )
     guxNextUnblockTime          = ( uOSTick_t ) 0U;
+    gbNextUnblockTimeValid      = OS_FALSE;
+#endif /* OS_LOWPOWER_ON */
     gxOverflowCount             = ( sOSBase_t ) 0U;
 
     return 0;
@@ -150,14 +128,17 @@ uOSBase_t OSStart( void )
     uOSBase_t ReturnValue = (uOSBase_t)0U;
     OSTaskHandle_t TaskHandle = OS_NULL;
 
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    TaskHandle = OSTaskCreateStatic(OSIdleTask, OS_NULL, OSMINIMAL_STACK_SIZE, OSLOWEAST_PRIORITY, "OSIdleTask", guxOSIdleStack, &gtOSIdleTCB);
+#else
     TaskHandle = OSTaskCreate(OSIdleTask, OS_NULL, OSMINIMAL_STACK_SIZE, OSLOWEAST_PRIORITY, "OSIdleTask");
+#endif /* OS_STATIC_ALLOC_ON */
     if(TaskHandle != OS_NULL)
     {
 #if ( OS_TIMER_ON!=0 )
         OSTimerCreateMoniteTask();
 #endif /* ( OS_TIMER_ON!=0 ) */        
         
-        guxNextUnblockTime = OSPEND_FOREVER_VALUE;
         gbSchedulerRunning = OS_TRUE;
         guxTickCount = ( uOSTick_t ) 0U;
 
@@ -174,69 +155,53 @@ uOSBase_t OSStart( void )
 
 static void OSTickCountOverflow( void )
 {
-    OSTaskListPendSwitch();
     gxOverflowCount++;
-    OSUpdateUnblockTime();
 }
 
-uOSBool_t OSIncrementTickCount( void )
+static uOSBool_t OSTickCountAdvance( void )
 {
-    tOSTCB_t * ptTCB = OS_NULL;
-    uOSTick_t uxItemValue = (uOSTick_t)0U;
     uOSBool_t bNeedSchedule = OS_FALSE;
+    const uOSTick_t uxTickCount = guxTickCount + (uOSTick_t)1;
+    guxTickCount = uxTickCount;
 
-    if( OSScheduleIsLocked() == OS_FALSE )
+    if( uxTickCount == ( uOSTick_t ) 0U )
     {
-        const uOSTick_t uxTickCount = guxTickCount + (uOSTick_t)1;
-        guxTickCount = uxTickCount;
+        OSTickCountOverflow();
+    }
 
-        if( uxTickCount == ( uOSTick_t ) 0U )
-        {
-            OSTickCountOverflow();
-        }
+    /* The tick count goes up one at a time, so only the wheel slot of this
+    tick can hold tasks due now and the others are never looked at. */
+    bNeedSchedule = OSTaskListPendWake( uxTickCount );
 
-        if( uxTickCount >= guxNextUnblockTime )
-        {
-            for( ;; )
-            {
-                if( OSTaskListPendNum() == 0U )
-                {
-                    guxNextUnblockTime = OSPEND_FOREVER_VALUE;
-                    break;
-                }
-                else
-                {
-                    ptTCB = ( tOSTCB_t * ) OSTaskListPendHeadItem();
-                    uxItemValue = OSListItemGetValue( &( ptTCB->tTaskListItem ) );
-
-                    if( uxTickCount < uxItemValue )
-                    {
-                        guxNextUnblockTime = uxItemValue;
-                        break;
-                    }
+#if ( OS_LOWPOWER_ON!=0 )
+    /* The next unblock time is only worked out again when the idle task
+    wants to sleep past it. */
+    if( uxTickCount == guxNextUnblockTime )
+    {
+        gbNextUnblockTimeValid = OS_FALSE;
+    }
+#endif /* OS_LOWPOWER_ON */
+    #if (OSTIME_SLICE_ON != 0U)
+    if( OSTaskNeedTimeSlice() == OS_TRUE )
+    {
+        bNeedSchedule = OS_TRUE;
+    }
+    #endif //(OSTIME_SLICE_ON != 0U)
 
-                    ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+    return bNeedSchedule;
+}
 
-                    if( OSListItemGetList( &( ptTCB->tEventListItem ) ) != OS_NULL )
-                    {
-                        ( void ) OSListRemoveItem( &( ptTCB->tEventListItem ) );
-                    }
+uOSBool_t OSIncrementTickCount( void )
+{
+    uOSBool_t bNeedSchedule = OS_FALSE;
 
-                    OSTaskListReadyAdd( ptTCB );
+#if ( OS_HARD_TIMER_ON!=0 )
+    OSTimerHardTick();
+#endif /* OS_HARD_TIMER_ON */
 
-                    if( ptTCB->uxPriority >= OSTaskGetPriorityFromISR( OS_NULL ) )
-                    {
-                        bNeedSchedule = OS_TRUE;
-                    }
-                }
-            }
-        }
-        #if (OSTIME_SLICE_ON != 0U)
-        if( OSTaskNeedTimeSlice() == OS_TRUE )
-        {
-            bNeedSchedule = OS_TRUE;
-        }
-        #endif //(OSTIME_SLICE_ON != 0U)
+    if( OSScheduleIsLocked() == OS_FALSE )
+    {
+        bNeedSchedule = OSTickCountAdvance();
     }
     else
     {
@@ -279,6 +244,11 @@ void OSNeedSchedule( void )
     gbNeedSchedule = OS_TRUE;
 }
 
+void OSClearSchedule( void )
+{
+    gbNeedSchedule = OS_FALSE;
+}
+
 void OSScheduleLock( void )
 {
     ++guxSchedulerLocked;
@@ -309,16 +279,12 @@ uOSBool_t OSScheduleUnlock( void )
                         gbNeedSchedule = OS_TRUE;
                     }
                 }
-                if( ptTCB != OS_NULL )
-                {
-                    OSUpdateUnblockTime();
-                }
 
                 {
                     uOSBase_t uxPendedTicks = guxPendedTicks;
                     while( uxPendedTicks > ( uOSBase_t ) 0U )
                     {
-                        if( OSIncrementTickCount() != OS_FALSE )
+                        if( OSTickCountAdvance() != OS_FALSE )
                         {
                             gbNeedSchedule = OS_TRUE;
                         }
@@ -375,9 +341,18 @@ void OSFixTickCount( const uOSTick_t uxTicksToFix )
     const uOSTick_t uxNextUnblockTime = guxNextUnblockTime;
     
     /* Correct the tick count value after a period during which the tick
-    was suppressed. */
-    if( ( uxTickCount + uxTicksToFix ) <= uxNextUnblockTime )
+    was suppressed.  The tick count must stay short of the next unblock time
+    so that the tick which reaches it still wakes the tasks. */
+    if( uxTicksToFix < ( uOSTick_t ) ( uxNextUnblockTime - uxTickCount ) )
     {
+#if ( OS_HARD_TIMER_ON!=0 )
+        /* The same holds for the next hard timer expiry. */
+        if( uxTicksToFix >= OSTimerHardNextDelta() )
+        {
+            return;
+        }
+        OSTimerHardFixTime( uxTicksToFix );
+#endif /* OS_HARD_TIMER_ON */
         guxTickCount += uxTicksToFix;
     }
 }
@@ -406,8 +381,25 @@ uOSBool_t OSEnableLowPowerIdle( void )
 uOSTick_t OSGetBlockTickCount( void )
 {
     uOSTick_t xReturn = (uOSTick_t)0U;
-    const uOSTick_t uxTickCount = guxTickCount;
-    const uOSTick_t uxNextUnblockTime = guxNextUnblockTime;
+    uOSTick_t uxTickCount = (uOSTick_t)0U;
+    uOSTick_t uxNextUnblockTime = (uOSTick_t)0U;
+#if ( OS_HARD_TIMER_ON!=0 )
+    uOSTick_t uxHardTimerDelta = (uOSTick_t)0U;
+#endif /* OS_HARD_TIMER_ON */
+
+    OSIntLock();
+    {
+        if( gbNextUnblockTimeValid == OS_FALSE )
+        {
+            OSUpdateUnblockTime();
+        }
+        uxTickCount = guxTickCount;
+        uxNextUnblockTime = guxNextUnblockTime;
+#if ( OS_HARD_TIMER_ON!=0 )
+        uxHardTimerDelta = OSTimerHardNextDelta();
+#endif /* OS_HARD_TIMER_ON */
+    }
+    OSIntUnlock();
     
     if( OSTaskGetPriority( OS_NULL ) > OSLOWEAST_PRIORITY )
     {
@@ -423,6 +415,12 @@ uOSTick_t OSGetBlockTickCount( void )
     else
     {
         xReturn = uxNextUnblockTime - uxTickCount;
+#if ( OS_HARD_TIMER_ON!=0 )
+        if( uxHardTimerDelta < xReturn )
+        {
+            xReturn = uxHardTimerDelta;
+        }
+#endif /* OS_HARD_TIMER_ON */
     }
 
     return xReturn;
@@ -469,88 +467,95 @@ uOSBool_t OSGetTimeOutState( tOSTimeOut_t * const ptTimeOut, uOSTick_t * const p
     return bReturn;
 }
 
+#if ( OS_LOWPOWER_ON!=0 )
 void OSUpdateUnblockTime( void )
 {
-    tOSTCB_t *ptTCB = OS_NULL;
+    const uOSTick_t uxTickCount = guxTickCount;
+
+    /* With nothing pending this is as far ahead as the tick count can
+    represent, the tick finds no task then and looks again. */
+    guxNextUnblockTime = uxTickCount + OSTaskListPendNextDelta( uxTickCount );
+    gbNextUnblockTimeValid = OS_TRUE;
+}
 
-    if( OSTaskListPendNum() == 0U )
+void OSAdvanceUnblockTime( const uOSTick_t uxTimeToWake )
+{
+    const uOSTick_t uxTickCount = guxTickCount;
+
+    /* The next unblock time only has to be no later than the earliest wake
+    time, so adding a task can only move it earlier and removing one leaves
+    it as it is.  A stale one is worked out again before it is used. */
+    if( gbNextUnblockTimeValid != OS_FALSE )
     {
-        guxNextUnblockTime = OSPEND_FOREVER_VALUE;
+        if( ( uOSTick_t ) ( uxTimeToWake - uxTickCount ) < ( uOSTick_t ) ( guxNextUnblockTime - uxTickCount ) )
+        {
+            guxNextUnblockTime = uxTimeToWake;
+        }
     }
-    else
+}
+#endif /* OS_LOWPOWER_ON */
+
+#if ( FITQUICK_GET_PRIORITY != 1U )
+uOSBase_t OSGetHighestBit( uOS32_t ulBitmap )
+{
+    uOSBase_t uxBit = ( uOSBase_t ) 0U;
+
+    /* Narrow down to the nibble holding the highest set bit, then look it up,
+    a fixed number of steps for any non zero bitmap. */
+    if( ( ulBitmap & 0xFFFF0000UL ) != 0UL )
+    {
+        ulBitmap >>= 16U;
+        uxBit += ( uOSBase_t ) 16U;
+    }
+    if( ( ulBitmap & 0x0000FF00UL ) != 0UL )
+    {
+        ulBitmap >>= 8U;
+        uxBit += ( uOSBase_t ) 8U;
+    }
+    if( ( ulBitmap & 0x000000F0UL ) != 0UL )
     {
-        ( ptTCB ) = ( tOSTCB_t * ) OSTaskListPendHeadItem();
-        guxNextUnblockTime = OSListItemGetValue( &( ( ptTCB )->tTaskListItem ) );
+        ulBitmap >>= 4U;
+        uxBit += ( uOSBase_t ) 4U;
     }
+
+    return uxBit + ( uOSBase_t ) gucHighestBitMap[ ulBitmap & 0x0FUL ];
 }
+#endif
 
 void OSSetReadyPriority(uOSBase_t uxPriority)
 {
-#if ( FITQUICK_GET_PRIORITY == 1U )
-    guxTopReadyPriority |= ( 1UL << ( uxPriority ) ) ;
-#else
-#if ( OSQUICK_GET_PRIORITY != 0U )
-    uOS16_t iSubPriorityGroup = uxPriority >> SUBPRI_MASK_WIDTH;
-    uOS16_t iPriorityRemainder = uxPriority & SUBPRI_MASK_VALUE;
-    gucSubPriorityBit[iSubPriorityGroup] |= 1U << iPriorityRemainder;
-    gucSubPriorityGroupBit |= 1U << iSubPriorityGroup;
-#else
-    //Default do nothing
+    gulReadyPriorityBit[ uxPriority >> 5U ] |= ( 1UL << ( uxPriority & 31U ) );
+#if ( OSREADY_GROUP_NUM > 1U )
+    gulReadyGroupBit |= ( 1UL << ( uxPriority >> 5U ) );
 #endif
-#endif
-
-    /* Just to avoid compiler warnings. */
-    ( void ) uxPriority;
 }
 
 void OSResetReadyPriority(uOSBase_t uxPriority)
 {
-#if ( FITQUICK_GET_PRIORITY == 1U )
-    if( OSTaskListReadyNum( uxPriority ) == ( uOSBase_t ) 0 )
-    {
-        guxTopReadyPriority &= ~( 1UL << ( uxPriority ) );
-    }
-#else
-#if ( OSQUICK_GET_PRIORITY != 0U )
     if( OSTaskListReadyNum( uxPriority ) == ( uOSBase_t ) 0 )
     {
-        uOS16_t iSubPriorityGroup = uxPriority >> SUBPRI_MASK_WIDTH;
-        uOS16_t iPriorityRemainder = uxPriority & SUBPRI_MASK_VALUE;
-        gucSubPriorityBit[iSubPriorityGroup] &= ~(1U << iPriorityRemainder);
-        if (gucSubPriorityBit[iSubPriorityGroup] == 0U)
+        gulReadyPriorityBit[ uxPriority >> 5U ] &= ~( 1UL << ( uxPriority & 31U ) );
+#if ( OSREADY_GROUP_NUM > 1U )
+        if( gulReadyPriorityBit[ uxPriority >> 5U ] == 0U )
         {
-            gucSubPriorityGroupBit &= ~(1U << iSubPriorityGroup);
+            gulReadyGroupBit &= ~( 1UL << ( uxPriority >> 5U ) );
         }
-    }
-#else
-    //Default do nothing
-#endif
 #endif
-
-    /* Just to avoid compiler warnings. */
-    ( void ) uxPriority;
+    }
 }
 
 uOSBase_t OSGetTopReadyPriority( void )
 {
-    uOSBase_t uxTopPriority = OSHIGHEAST_PRIORITY - 1;
+    uOSBase_t uxTopGroup = ( uOSBase_t ) 0U;
+    uOSBase_t uxTopPriority = ( uOSBase_t ) 0U;
 
-#if ( FITQUICK_GET_PRIORITY == 1U )
-    FitGET_HIGHEST_PRIORITY( uxTopPriority, guxTopReadyPriority );
-#else
-#if ( OSQUICK_GET_PRIORITY != 0U )
-    uOS16_t iSubPriorityGroup = gucSubPriorityMap[gucSubPriorityGroupBit];
-    uOS16_t iPriorityRemainderBit = gucSubPriorityBit[iSubPriorityGroup];
-    uxTopPriority = gucSubPriorityMap[iPriorityRemainderBit] + (iSubPriorityGroup << SUBPRI_MASK_WIDTH);
-#else
-    /* Default, Find the highest priority queue that contains ready tasks. */
-    while( OSTaskListReadyNum( uxTopPriority ) == 0U )
-    {
-        --uxTopPriority;
-    }
-#endif
+    /* The idle task is always ready, so the bitmap is never empty. */
+#if ( OSREADY_GROUP_NUM > 1U )
+    OSGET_HIGHEST_BIT( uxTopGroup, gulReadyGroupBit );
 #endif
-    return uxTopPriority;
+    OSGET_HIGHEST_BIT( uxTopPriority, gulReadyPriorityBit[ uxTopGroup ] );
+
+    return ( uxTopGroup << 5U ) + uxTopPriority;
 }
 
 #ifdef __cplusplus
@@ -62,18 +62,21 @@ extern "C" {
 
 #define OSIsInsideISR()                     FitIsInsideISR()
 
+#define OSMemoryBarrier()                   FitMemoryBarrier()
+
 uOSBase_t    OSInit( void ) TINIUX_FUNCTION;
 uOSBase_t    OSStart( void ) TINIUX_FUNCTION;
 
 uOSBase_t    OSScheduleInit( void ) TINIUX_FUNCTION;
 void         OSScheduleLock( void ) TINIUX_FUNCTION;
 uOSBool_t    OSScheduleUnlock( void ) TINIUX_FUNCTION;
-uOSBool_t    OSScheduleIsLocked( void ) TINIUX_FUNCTION;
+uOSBool_t    OSScheduleIsLocked( void ) TINIUX_FAST_FUNCTION;
 
 sOSBase_t    OSScheduleGetState( void ) TINIUX_FUNCTION;
-void         OSNeedSchedule( void ) TINIUX_FUNCTION;
+void         OSNeedSchedule( void ) TINIUX_FAST_FUNCTION;
+void         OSClearSchedule( void ) TINIUX_FAST_FUNCTION;
 
-uOSBool_t    OSIncrementTickCount( void ) TINIUX_FUNCTION;
+uOSBool_t    OSIncrementTickCount( void ) TINIUX_FAST_FUNCTION;
 uOSTick_t    OSGetTickCount( void ) TINIUX_FUNCTION;
 uOSTick_t    OSGetTickCountFromISR( void ) TINIUX_FUNCTION;
 
@@ -85,12 +88,22 @@ uOSBool_t    OSGetTimeOutState( tOSTimeOut_t * const ptTimeOut, uOSTick_t * cons
 void         OSFixTickCount( const uOSTick_t uxTicksToFix ) TINIUX_FUNCTION;
 uOSBool_t    OSEnableLowPowerIdle( void ) TINIUX_FUNCTION;
 uOSTick_t    OSGetBlockTickCount( void ) TINIUX_FUNCTION;
-#endif //OS_LOWPOWER_ON
 void         OSUpdateUnblockTime( void ) TINIUX_FUNCTION;
+void         OSAdvanceUnblockTime( const uOSTick_t uxTimeToWake ) TINIUX_FUNCTION;
+#endif //OS_LOWPOWER_ON
+
+/* Index of the highest set bit of a non zero 32 bit bitmap, count leading zeros
+on the ports that have it, a constant time lookup otherwise. */
+#if ( FITQUICK_GET_PRIORITY == 1U )
+#define OSGET_HIGHEST_BIT( uxBit, ulBitmap )    FitGET_HIGHEST_PRIORITY( uxBit, ulBitmap )
+#else
+#define OSGET_HIGHEST_BIT( uxBit, ulBitmap )    uxBit = OSGetHighestBit( ulBitmap )
+uOSBase_t    OSGetHighestBit( uOS32_t ulBitmap ) TINIUX_FUNCTION;
+#endif
 
 void         OSSetReadyPriority(uOSBase_t uxPriority) TINIUX_FUNCTION;
 void         OSResetReadyPriority(uOSBase_t uxPriority) TINIUX_FUNCTION;
-uOSBase_t    OSGetTopReadyPriority( void ) TINIUX_FUNCTION;
+uOSBase_t    OSGetTopReadyPriority( void ) TINIUX_FAST_FUNCTION;
 
 #ifdef __cplusplus
 }
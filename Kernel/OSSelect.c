@@ -0,0 +1,389 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_SELECT_ON!=0 )
+
+#if ( OS_MSGQ_ON!=0 )
+TINIUX_DATA static uOS8_t const SELECT_TYPE_MSGQ                  = ( ( uOS8_t ) 1U );
+#endif
+#if ( OS_SEMAPHORE_ON!=0 )
+TINIUX_DATA static uOS8_t const SELECT_TYPE_SEM                   = ( ( uOS8_t ) 2U );
+#endif
+#if ( OS_MUTEX_ON!=0 )
+TINIUX_DATA static uOS8_t const SELECT_TYPE_MUTEX                 = ( ( uOS8_t ) 3U );
+#endif
+#if ( OS_TASK_SIGNAL_ON!=0 )
+TINIUX_DATA static uOS8_t const SELECT_TYPE_SIGNAL                = ( ( uOS8_t ) 4U );
+#endif
+
+/* Return the address of the select pointer kept in the member, must be called
+with the interrupts locked. */
+static tOSSelect_t ** OSSelectGetLink( void * const pvMember, const uOS8_t ucType )
+{
+    tOSSelect_t **pptSelect = OS_NULL;
+
+#if ( OS_MSGQ_ON!=0 )
+    if( ucType == SELECT_TYPE_MSGQ )
+    {
+        pptSelect = &( ( ( tOSMsgQ_t * ) pvMember )->ptSelect );
+    }
+#endif /* OS_MSGQ_ON */
+#if ( OS_SEMAPHORE_ON!=0 )
+    if( ucType == SELECT_TYPE_SEM )
+    {
+        pptSelect = &( ( ( tOSSem_t * ) pvMember )->ptSelect );
+    }
+#endif /* OS_SEMAPHORE_ON */
+#if ( OS_MUTEX_ON!=0 )
+    if( ucType == SELECT_TYPE_MUTEX )
+    {
+        pptSelect = &( ( ( tOSMutex_t * ) pvMember )->ptSelect );
+    }
+#endif /* OS_MUTEX_ON */
+#if ( OS_TASK_SIGNAL_ON!=0 )
+    if( ucType == SELECT_TYPE_SIGNAL )
+    {
+        pptSelect = &( ( ( tOSTCB_t * ) pvMember )->ptSelect );
+    }
+#endif /* OS_TASK_SIGNAL_ON */
+
+    return pptSelect;
+}
+
+/* Check whether the member can be received, pended, locked or waited on
+without blocking, must be called with the interrupts locked. */
+static uOSBool_t OSSelectIsReady( const tOSSelectMember_t * const ptMember )
+{
+    uOSBool_t bReturn = OS_FALSE;
+
+#if ( OS_MSGQ_ON!=0 )
+    if( ptMember->ucType == SELECT_TYPE_MSGQ )
+    {
+        bReturn = ( uOSBool_t ) ( ( ( tOSMsgQ_t * ) ptMember->pvMember )->uxCurNum != ( uOSBase_t ) 0U );
+    }
+#endif /* OS_MSGQ_ON */
+#if ( OS_SEMAPHORE_ON!=0 )
+    if( ptMember->ucType == SELECT_TYPE_SEM )
+    {
+        bReturn = ( uOSBool_t ) ( ( ( tOSSem_t * ) ptMember->pvMember )->uxCurNum != ( uOSBase_t ) 0U );
+    }
+#endif /* OS_SEMAPHORE_ON */
+#if ( OS_MUTEX_ON!=0 )
+    if( ptMember->ucType == SELECT_TYPE_MUTEX )
+    {
+        tOSMutex_t * const ptMutex = ( tOSMutex_t * ) ptMember->pvMember;
+
+        bReturn = ( uOSBool_t ) ( ( ptMutex->uxCurNum != ( uOSBase_t ) 0U ) ||
+                                  ( ptMutex->MutexHolderHandle == OSGetCurrentTaskHandle() ) );
+    }
+#endif /* OS_MUTEX_ON */
+#if ( OS_TASK_SIGNAL_ON!=0 )
+    if( ptMember->ucType == SELECT_TYPE_SIGNAL )
+    {
+        bReturn = OSTaskSignalIsPending( ( OSTaskHandle_t ) ptMember->pvMember );
+    }
+#endif /* OS_TASK_SIGNAL_ON */
+
+    return bReturn;
+}
+
+static uOSBool_t OSSelectAdd( tOSSelect_t * const ptSelect, void * const pvMember, const uOS8_t ucType )
+{
+    tOSSelect_t **pptSelect = OS_NULL;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        pptSelect = OSSelectGetLink( pvMember, ucType );
+
+        /* An object belongs to one select at most. */
+        if( ( *pptSelect == OS_NULL ) && ( ptSelect->uxCurNum < ptSelect->uxMaxNum ) )
+        {
+            ptSelect->ptMember[ ptSelect->uxCurNum ].pvMember = pvMember;
+            ptSelect->ptMember[ ptSelect->uxCurNum ].ucType = ucType;
+            ptSelect->uxCurNum++;
+            *pptSelect = ptSelect;
+
+            /* Let a waiting task pick up a member which is ready already. */
+            if( OSSelectNotify( ptSelect ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+            bReturn = OS_TRUE;
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+static void OSSelectInitNew( tOSSelect_t * const ptNewSelect, tOSSelectMember_t * const ptMember, const uOSBase_t uxMaxNum )
+{
+    ptNewSelect->pcSelectName[ 0 ] = '\0';
+    OSListInit( &( ptNewSelect->tTaskListEventSelect ) );
+    ptNewSelect->ptMember = ptMember;
+    ptNewSelect->uxMaxNum = uxMaxNum;
+    ptNewSelect->uxCurNum = ( uOSBase_t ) 0U;
+    ptNewSelect->uxNextIndex = ( uOSBase_t ) 0U;
+    ptNewSelect->xID = 0;
+}
+
+OSSelectHandle_t OSSelectCreate( const uOSBase_t uxMaxNum )
+{
+    tOSSelect_t *ptNewSelect = OS_NULL;
+
+    /* The members are stored right after the select. */
+    ptNewSelect = ( tOSSelect_t * ) OSMemMalloc( sizeof( tOSSelect_t ) + ( uxMaxNum * sizeof( tOSSelectMember_t ) ) );
+
+    if( ptNewSelect != OS_NULL )
+    {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewSelect->ucStaticAlloc = OS_FALSE;
+#endif
+        OSSelectInitNew( ptNewSelect, ( tOSSelectMember_t * ) ( ( ( uOS8_t * ) ptNewSelect ) + sizeof( tOSSelect_t ) ), uxMaxNum );
+    }
+
+    return ptNewSelect;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSSelectHandle_t OSSelectCreateStatic( const uOSBase_t uxMaxNum, tOSSelectMember_t * const ptMemberBuffer, tOSSelect_t * const ptSelectBuffer )
+{
+    if( ( ptMemberBuffer == OS_NULL ) || ( ptSelectBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    ptSelectBuffer->ucStaticAlloc = OS_TRUE;
+    OSSelectInitNew( ptSelectBuffer, ptMemberBuffer, uxMaxNum );
+
+    return ptSelectBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSSelectDelete( OSSelectHandle_t SelectHandle )
+{
+    tOSSelect_t * const ptSelect = ( tOSSelect_t * ) SelectHandle;
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+
+    OSIntLock();
+    {
+        for( uxIndex = 0U; uxIndex < ptSelect->uxCurNum; uxIndex++ )
+        {
+            *OSSelectGetLink( ptSelect->ptMember[ uxIndex ].pvMember, ptSelect->ptMember[ uxIndex ].ucType ) = OS_NULL;
+        }
+        ptSelect->uxCurNum = ( uOSBase_t ) 0U;
+    }
+    OSIntUnlock();
+
+    OSMemFreeObject( ptSelect );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSSelectSetID(OSSelectHandle_t SelectHandle, sOSBase_t xID)
+{
+    if(SelectHandle == OS_NULL)
+    {
+        return 1;
+    }
+    OSIntLock();
+    {
+        SelectHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return 0;
+}
+
+sOSBase_t OSSelectGetID(OSSelectHandle_t const SelectHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(SelectHandle != OS_NULL)
+    {
+        xID = SelectHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+#if ( OS_MSGQ_ON!=0 )
+uOSBool_t OSSelectAddMsgQ( OSSelectHandle_t SelectHandle, OSMsgQHandle_t MsgQHandle )
+{
+    return OSSelectAdd( ( tOSSelect_t * ) SelectHandle, ( void * ) MsgQHandle, SELECT_TYPE_MSGQ );
+}
+#endif /* OS_MSGQ_ON */
+
+#if ( OS_SEMAPHORE_ON!=0 )
+uOSBool_t OSSelectAddSem( OSSelectHandle_t SelectHandle, OSSemHandle_t SemHandle )
+{
+    return OSSelectAdd( ( tOSSelect_t * ) SelectHandle, ( void * ) SemHandle, SELECT_TYPE_SEM );
+}
+#endif /* OS_SEMAPHORE_ON */
+
+#if ( OS_MUTEX_ON!=0 )
+uOSBool_t OSSelectAddMutex( OSSelectHandle_t SelectHandle, OSMutexHandle_t MutexHandle )
+{
+    return OSSelectAdd( ( tOSSelect_t * ) SelectHandle, ( void * ) MutexHandle, SELECT_TYPE_MUTEX );
+}
+#endif /* OS_MUTEX_ON */
+
+#if ( OS_TASK_SIGNAL_ON!=0 )
+uOSBool_t OSSelectAddSignal( OSSelectHandle_t SelectHandle, OSTaskHandle_t TaskHandle )
+{
+    return OSSelectAdd( ( tOSSelect_t * ) SelectHandle, ( void * ) TaskHandle, SELECT_TYPE_SIGNAL );
+}
+#endif /* OS_TASK_SIGNAL_ON */
+
+uOSBool_t OSSelectRemove( OSSelectHandle_t SelectHandle, void * const pvMember )
+{
+    tOSSelect_t * const ptSelect = ( tOSSelect_t * ) SelectHandle;
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+    uOSBool_t bReturn = OS_FALSE;
+
+    OSIntLock();
+    {
+        for( uxIndex = 0U; uxIndex < ptSelect->uxCurNum; uxIndex++ )
+        {
+            if( ptSelect->ptMember[ uxIndex ].pvMember == pvMember )
+            {
+                *OSSelectGetLink( pvMember, ptSelect->ptMember[ uxIndex ].ucType ) = OS_NULL;
+
+                /* The last member takes the place of the removed one. */
+                ptSelect->uxCurNum--;
+                ptSelect->ptMember[ uxIndex ] = ptSelect->ptMember[ ptSelect->uxCurNum ];
+                bReturn = OS_TRUE;
+                break;
+            }
+        }
+    }
+    OSIntUnlock();
+
+    return bReturn;
+}
+
+void * OSSelectWait( OSSelectHandle_t SelectHandle, uOSTick_t uxTicksToWait )
+{
+    uOSBool_t bEntryTimeSet = OS_FALSE;
+    tOSTimeOut_t tTimeOut;
+    uOSBase_t uxIndex = ( uOSBase_t ) 0U;
+    uOSBase_t uxCount = ( uOSBase_t ) 0U;
+    tOSSelect_t * const ptSelect = ( tOSSelect_t * ) SelectHandle;
+
+    for( ;; )
+    {
+        OSIntLock();
+        {
+            /* Start after the member returned last time, so a busy member
+            does not hide the others. */
+            uxIndex = ptSelect->uxNextIndex;
+            for( uxCount = 0U; uxCount < ptSelect->uxCurNum; uxCount++ )
+            {
+                if( uxIndex >= ptSelect->uxCurNum )
+                {
+                    uxIndex = 0U;
+                }
+                if( OSSelectIsReady( &( ptSelect->ptMember[ uxIndex ] ) ) != OS_FALSE )
+                {
+                    ptSelect->uxNextIndex = uxIndex + 1U;
+
+                    OSIntUnlock();
+                    return ptSelect->ptMember[ uxIndex ].pvMember;
+                }
+                uxIndex++;
+            }
+
+            if( uxTicksToWait == ( uOSTick_t ) 0 )
+            {
+                OSIntUnlock();
+                //none of the members is ready
+                return OS_NULL;
+            }
+            else if( bEntryTimeSet == OS_FALSE )
+            {
+                OSSetTimeOutState( &tTimeOut );
+                bEntryTimeSet = OS_TRUE;
+            }
+            else if( OSGetTimeOutState( &tTimeOut, &uxTicksToWait ) != OS_FALSE )
+            {
+                OSIntUnlock();
+                //none of the members is ready
+                return OS_NULL;
+            }
+
+            /* The members wake this task through OSSelectNotify, it then scans them again. */
+            OSTaskListEventAdd( &( ptSelect->tTaskListEventSelect ), uxTicksToWait );
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+}
+
+/* Called by a member which may have become ready, with the interrupts locked
+or masked. Return OS_TRUE if a task of higher priority has been woken. */
+uOSBool_t OSSelectNotify( tOSSelect_t * const ptSelect )
+{
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    if( ptSelect != OS_NULL )
+    {
+        while( OSListIsEmpty( &( ptSelect->tTaskListEventSelect ) ) == OS_FALSE )
+        {
+            if( OSTaskListEventRemove( &( ptSelect->tTaskListEventSelect ) ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    return bNeedSchedule;
+}
+
+#endif //( OS_SELECT_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
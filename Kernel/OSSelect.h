@@ -0,0 +1,113 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_SELECT_H_
+#define __OS_SELECT_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_SELECT_ON!=0 )
+
+typedef struct tOSSelectMember
+{
+    void *                      pvMember;             // Handle of the MsgQ Sem Mutex or task
+    uOS8_t                      ucType;               // Kind of the member, selects the readiness test
+} tOSSelectMember_t;
+
+typedef struct tOSSelect
+{
+    char                        pcSelectName[ OSNAME_MAX_LEN ];
+
+    tOSList_t                   tTaskListEventSelect; // Select Wait TaskList;
+
+    tOSSelectMember_t *         ptMember;             // Members, stored right after the select
+    uOSBase_t                   uxMaxNum;
+    uOSBase_t                   uxCurNum;
+    uOSBase_t                   uxNextIndex;          // Where the next scan starts, so no member is starved
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;        // OS_TRUE if the memory was given by the application
+#endif
+
+    sOSBase_t                   xID;
+} tOSSelect_t;
+
+typedef tOSSelect_t* OSSelectHandle_t;
+
+OSSelectHandle_t  OSSelectCreate( const uOSBase_t uxMaxNum ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSSelectHandle_t  OSSelectCreateStatic( const uOSBase_t uxMaxNum, tOSSelectMember_t * const ptMemberBuffer, tOSSelect_t * const ptSelectBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_MEMFREE_ON != 0 )
+void              OSSelectDelete( OSSelectHandle_t SelectHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSSelectSetID(OSSelectHandle_t SelectHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSSelectGetID(OSSelectHandle_t const SelectHandle) TINIUX_FUNCTION;
+
+/* An object belongs to one select at most, remove it before deleting it. */
+#if ( OS_MSGQ_ON!=0 )
+uOSBool_t         OSSelectAddMsgQ( OSSelectHandle_t SelectHandle, OSMsgQHandle_t MsgQHandle ) TINIUX_FUNCTION;
+#endif /* OS_MSGQ_ON */
+#if ( OS_SEMAPHORE_ON!=0 )
+uOSBool_t         OSSelectAddSem( OSSelectHandle_t SelectHandle, OSSemHandle_t SemHandle ) TINIUX_FUNCTION;
+#endif /* OS_SEMAPHORE_ON */
+#if ( OS_MUTEX_ON!=0 )
+uOSBool_t         OSSelectAddMutex( OSSelectHandle_t SelectHandle, OSMutexHandle_t MutexHandle ) TINIUX_FUNCTION;
+#endif /* OS_MUTEX_ON */
+#if ( OS_TASK_SIGNAL_ON!=0 )
+uOSBool_t         OSSelectAddSignal( OSSelectHandle_t SelectHandle, OSTaskHandle_t TaskHandle ) TINIUX_FUNCTION;
+#endif /* OS_TASK_SIGNAL_ON */
+uOSBool_t         OSSelectRemove( OSSelectHandle_t SelectHandle, void * const pvMember ) TINIUX_FUNCTION;
+
+/* Return the handle of a member which is ready, or OS_NULL on timeout. The item is not taken,
+   the caller receives, pends, locks or waits on the member with no timeout afterwards. */
+void *            OSSelectWait( OSSelectHandle_t SelectHandle, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+
+uOSBool_t         OSSelectNotify( tOSSelect_t * const ptSelect ) TINIUX_FUNCTION;
+
+#endif //( OS_SELECT_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_SELECT_H_
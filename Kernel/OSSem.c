@@ -195,6 +195,18 @@ sOSBase_t OSSemReset( OSSemHandle_t SemHandle, uOSBool_t bNewQueue )
     return OS_TRUE;
 }
 
+static void OSSemInitNew( tOSSem_t * const ptNewSem, const uOSBase_t uxMaxNum, const uOSBase_t uxInitialCount )
+{
+    ptNewSem->uxMaxNum = uxMaxNum;
+#if ( OS_SELECT_ON!=0 )
+    ptNewSem->ptSelect = OS_NULL;
+#endif
+
+    ( void ) OSSemReset( ptNewSem, OS_TRUE );
+
+    ptNewSem->uxCurNum = uxInitialCount;
+}
+
 OSSemHandle_t OSSemCreateCount( const uOSBase_t uxMaxNum, const uOSBase_t uxInitialCount )
 {
     tOSSem_t *ptNewSem = OS_NULL;
@@ -204,11 +216,10 @@ OSSemHandle_t OSSemCreateCount( const uOSBase_t uxMaxNum, const uOSBase_t uxInit
 
     if( ptNewSem != OS_NULL )
     {
-        ptNewSem->uxMaxNum = uxMaxNum;
-
-        ( void ) OSSemReset( ptNewSem, OS_TRUE );
-
-        ptNewSem->uxCurNum = uxInitialCount;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewSem->ucStaticAlloc = OS_FALSE;
+#endif
+        OSSemInitNew( ptNewSem, uxMaxNum, uxInitialCount );
 
         xReturn = ptNewSem;
     }
@@ -216,6 +227,21 @@ OSSemHandle_t OSSemCreateCount( const uOSBase_t uxMaxNum, const uOSBase_t uxInit
     return xReturn;
 }
 
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSSemHandle_t OSSemCreateStatic( const uOSBase_t uxMaxNum, const uOSBase_t uxInitialCount, tOSSem_t * const ptSemBuffer )
+{
+    if( ptSemBuffer == OS_NULL )
+    {
+        return OS_NULL;
+    }
+
+    ptSemBuffer->ucStaticAlloc = OS_TRUE;
+    OSSemInitNew( ptSemBuffer, uxMaxNum, uxInitialCount );
+
+    return ptSemBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
 OSSemHandle_t OSSemCreate( const uOSBase_t uxInitialCount )
 {
     uOSBase_t uxInitialCountTemp = uxInitialCount;
@@ -231,7 +257,7 @@ void OSSemDelete( OSSemHandle_t SemHandle )
 {
     tOSSem_t * const ptSem = ( tOSSem_t * ) SemHandle;
 
-    OSMemFree( ptSem );
+    OSMemFreeObject( ptSem );
 }
 #endif /* OS_MEMFREE_ON */
 
@@ -370,6 +396,12 @@ uOSBool_t OSSemPost( OSSemHandle_t SemHandle )
                         OSSchedule();
                     }
                 }
+#if ( OS_SELECT_ON!=0 )
+                if( OSSelectNotify( ptSem->ptSelect ) != OS_FALSE )
+                {
+                    OSSchedule();
+                }
+#endif /* OS_SELECT_ON */
 
                 OSIntUnlock();
                 return OS_TRUE;
@@ -459,6 +491,12 @@ uOSBool_t OSSemPostFromISR( OSSemHandle_t SemHandle )
             {
                 ptSem->xSemVLock = ( sOSBase_t )(xSemVLock + 1);
             }
+#if ( OS_SELECT_ON!=0 )
+            if( OSSelectNotify( ptSem->ptSelect ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+#endif /* OS_SELECT_ON */
 
             bReturn = OS_TRUE;
         }
@@ -59,6 +59,14 @@ typedef struct tOSSem
     volatile sOSBase_t          xSemPLock;            // Record the number of task which pend from the semaphore while it was locked.
     volatile sOSBase_t          xSemVLock;            // Record the number of task which post to the semaphore while it was locked.
 
+#if ( OS_SELECT_ON!=0 )
+    struct tOSSelect *          ptSelect;             // The select this semaphore belongs to;
+#endif
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;        // OS_TRUE if the memory was given by the application;
+#endif
+
     sOSBase_t                   xID;
 } tOSSem_t;
 
@@ -66,6 +74,9 @@ typedef tOSSem_t* OSSemHandle_t;
 
 OSSemHandle_t     OSSemCreate( const uOSBase_t uxInitialCount ) TINIUX_FUNCTION;
 OSSemHandle_t     OSSemCreateCount( const uOSBase_t uxMaxNum, const uOSBase_t uxInitialCount ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSSemHandle_t     OSSemCreateStatic( const uOSBase_t uxMaxNum, const uOSBase_t uxInitialCount, tOSSem_t * const ptSemBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
 
 #if ( OS_MEMFREE_ON != 0 )
 void              OSSemDelete(OSSemHandle_t SemHandle) TINIUX_FUNCTION;
@@ -0,0 +1,451 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#include <string.h>
+
+#include "TINIUX.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_STREAMBUF_ON!=0 )
+
+static uOSBase_t OSStreamBufCount( const tOSStreamBuf_t *ptStreamBuf )
+{
+    const uOSBase_t uxHead = ptStreamBuf->uxHead;
+    const uOSBase_t uxTail = ptStreamBuf->uxTail;
+
+    if( uxHead >= uxTail )
+    {
+        return ( uxHead - uxTail );
+    }
+
+    return ( ptStreamBuf->uxLength - uxTail + uxHead );
+}
+
+static uOSBase_t OSStreamBufSpace( const tOSStreamBuf_t *ptStreamBuf )
+{
+    return ( ptStreamBuf->uxLength - ( uOSBase_t ) 1U - OSStreamBufCount( ptStreamBuf ) );
+}
+
+/* Only called by the writer. */
+static uOSBase_t OSStreamBufCopyIn( tOSStreamBuf_t * const ptStreamBuf, const void * pvData, uOSBase_t uxDataLen )
+{
+    const uOS8_t *pucData = ( const uOS8_t * ) pvData;
+    uOSBase_t uxHead = ptStreamBuf->uxHead;
+    uOSBase_t uxFirst = ( uOSBase_t ) 0U;
+    uOSBase_t uxSpace = OSStreamBufSpace( ptStreamBuf );
+
+    if( uxDataLen > uxSpace )
+    {
+        uxDataLen = uxSpace;
+    }
+    if( uxDataLen == ( uOSBase_t ) 0U )
+    {
+        return uxDataLen;
+    }
+
+    uxFirst = ptStreamBuf->uxLength - uxHead;
+    if( uxFirst > uxDataLen )
+    {
+        uxFirst = uxDataLen;
+    }
+    ( void ) memcpy( ( void * ) &( ptStreamBuf->pucBuffer[ uxHead ] ), ( const void * ) pucData, ( size_t ) uxFirst );
+    if( uxDataLen > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) ptStreamBuf->pucBuffer, ( const void * ) &( pucData[ uxFirst ] ), ( size_t ) ( uxDataLen - uxFirst ) );
+    }
+
+    uxHead += uxDataLen;
+    if( uxHead >= ptStreamBuf->uxLength )
+    {
+        uxHead -= ptStreamBuf->uxLength;
+    }
+
+    /* The bytes must be in the storage before the reader can see them. */
+    OSMemoryBarrier();
+    ptStreamBuf->uxHead = uxHead;
+
+    return uxDataLen;
+}
+
+/* Only called by the reader. */
+static uOSBase_t OSStreamBufCopyOut( tOSStreamBuf_t * const ptStreamBuf, void * pvBuffer, uOSBase_t uxBufferLen )
+{
+    uOS8_t *pucBuffer = ( uOS8_t * ) pvBuffer;
+    uOSBase_t uxTail = ptStreamBuf->uxTail;
+    uOSBase_t uxFirst = ( uOSBase_t ) 0U;
+    uOSBase_t uxCount = OSStreamBufCount( ptStreamBuf );
+
+    if( uxBufferLen > uxCount )
+    {
+        uxBufferLen = uxCount;
+    }
+    if( uxBufferLen == ( uOSBase_t ) 0U )
+    {
+        return uxBufferLen;
+    }
+
+    /* Do not read the bytes before the head which published them. */
+    OSMemoryBarrier();
+
+    uxFirst = ptStreamBuf->uxLength - uxTail;
+    if( uxFirst > uxBufferLen )
+    {
+        uxFirst = uxBufferLen;
+    }
+    ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) &( ptStreamBuf->pucBuffer[ uxTail ] ), ( size_t ) uxFirst );
+    if( uxBufferLen > uxFirst )
+    {
+        ( void ) memcpy( ( void * ) &( pucBuffer[ uxFirst ] ), ( const void * ) ptStreamBuf->pucBuffer, ( size_t ) ( uxBufferLen - uxFirst ) );
+    }
+
+    uxTail += uxBufferLen;
+    if( uxTail >= ptStreamBuf->uxLength )
+    {
+        uxTail -= ptStreamBuf->uxLength;
+    }
+
+    /* The bytes must be read out before the writer can reuse their space. */
+    OSMemoryBarrier();
+    ptStreamBuf->uxTail = uxTail;
+
+    return uxBufferLen;
+}
+
+/* Wake the blocked reader once the bytes it waits for are there, must be
+called with the interrupts locked or masked. */
+static uOSBool_t OSStreamBufWakeReader( tOSStreamBuf_t * const ptStreamBuf )
+{
+    if( OSListIsEmpty( &( ptStreamBuf->tTaskListEventRead ) ) == OS_FALSE )
+    {
+        if( OSStreamBufCount( ptStreamBuf ) >= ptStreamBuf->uxWaitBytes )
+        {
+            return OSTaskListEventRemove( &( ptStreamBuf->tTaskListEventRead ) );
+        }
+    }
+
+    return OS_FALSE;
+}
+
+/* Wake the blocked writer once the space it waits for is there, must be
+called with the interrupts locked or masked. */
+static uOSBool_t OSStreamBufWakeWriter( tOSStreamBuf_t * const ptStreamBuf )
+{
+    if( OSListIsEmpty( &( ptStreamBuf->tTaskListEventWrite ) ) == OS_FALSE )
+    {
+        if( OSStreamBufSpace( ptStreamBuf ) >= ptStreamBuf->uxWaitSpace )
+        {
+            return OSTaskListEventRemove( &( ptStreamBuf->tTaskListEventWrite ) );
+        }
+    }
+
+    return OS_FALSE;
+}
+
+static void OSStreamBufInitNew( tOSStreamBuf_t * const ptNewStreamBuf, uOS8_t * const pucStorage, const uOSBase_t uxBufferSize, const uOSBase_t uxTriggerLevel )
+{
+    ptNewStreamBuf->pcStreamBufName[ 0 ] = '\0';
+    ptNewStreamBuf->pucBuffer = pucStorage;
+    ptNewStreamBuf->uxLength = uxBufferSize + ( uOSBase_t ) 1U;
+    ptNewStreamBuf->uxHead = ( uOSBase_t ) 0U;
+    ptNewStreamBuf->uxTail = ( uOSBase_t ) 0U;
+
+    OSListInit( &( ptNewStreamBuf->tTaskListEventWrite ) );
+    OSListInit( &( ptNewStreamBuf->tTaskListEventRead ) );
+
+    ptNewStreamBuf->uxTriggerLevel = ( uxTriggerLevel == ( uOSBase_t ) 0U ) ? ( uOSBase_t ) 1U : uxTriggerLevel;
+    ptNewStreamBuf->uxWaitBytes = ( uOSBase_t ) 0U;
+    ptNewStreamBuf->uxWaitSpace = ( uOSBase_t ) 0U;
+    ptNewStreamBuf->xID = 0;
+}
+
+OSStreamBufHandle_t OSStreamBufCreate( const uOSBase_t uxBufferSize, const uOSBase_t uxTriggerLevel )
+{
+    tOSStreamBuf_t *ptNewStreamBuf = OS_NULL;
+
+    if( ( uxBufferSize == ( uOSBase_t ) 0U ) || ( uxTriggerLevel > uxBufferSize ) )
+    {
+        return ptNewStreamBuf;
+    }
+
+    ptNewStreamBuf = ( tOSStreamBuf_t * ) OSMemMalloc( sizeof( tOSStreamBuf_t ) + ( uOS32_t ) uxBufferSize + ( uOS32_t ) 1U );
+
+    if( ptNewStreamBuf != OS_NULL )
+    {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewStreamBuf->ucStaticAlloc = OS_FALSE;
+#endif
+        OSStreamBufInitNew( ptNewStreamBuf, ( ( uOS8_t * ) ptNewStreamBuf ) + sizeof( tOSStreamBuf_t ), uxBufferSize, uxTriggerLevel );
+    }
+
+    return ptNewStreamBuf;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSStreamBufHandle_t OSStreamBufCreateStatic( const uOSBase_t uxBufferSize, const uOSBase_t uxTriggerLevel, uOS8_t * const pucStorage, tOSStreamBuf_t * const ptStreamBufBuffer )
+{
+    if( ( uxBufferSize == ( uOSBase_t ) 0U ) || ( uxTriggerLevel > uxBufferSize ) || ( pucStorage == OS_NULL ) || ( ptStreamBufBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    ptStreamBufBuffer->ucStaticAlloc = OS_TRUE;
+    OSStreamBufInitNew( ptStreamBufBuffer, pucStorage, uxBufferSize, uxTriggerLevel );
+
+    return ptStreamBufBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_MEMFREE_ON != 0 )
+void OSStreamBufDelete( OSStreamBufHandle_t StreamBufHandle )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+
+    OSMemFreeObject( ptStreamBuf );
+}
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t OSStreamBufSetID(OSStreamBufHandle_t StreamBufHandle, sOSBase_t xID)
+{
+    if(StreamBufHandle == OS_NULL)
+    {
+        return (sOSBase_t)1;
+    }
+    OSIntLock();
+    {
+        StreamBufHandle->xID = xID;
+    }
+    OSIntUnlock();
+
+    return (sOSBase_t)0;
+}
+
+sOSBase_t OSStreamBufGetID(OSStreamBufHandle_t const StreamBufHandle)
+{
+    sOSBase_t xID = 0;
+
+    OSIntLock();
+    if(StreamBufHandle != OS_NULL)
+    {
+        xID = StreamBufHandle->xID;
+    }
+    OSIntUnlock();
+
+    return xID;
+}
+
+uOSBool_t OSStreamBufSetTriggerLevel( OSStreamBufHandle_t StreamBufHandle, uOSBase_t uxTriggerLevel )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+
+    if( uxTriggerLevel >= ptStreamBuf->uxLength )
+    {
+        return OS_FALSE;
+    }
+    if( uxTriggerLevel == ( uOSBase_t ) 0U )
+    {
+        uxTriggerLevel = ( uOSBase_t ) 1U;
+    }
+
+    OSIntLock();
+    {
+        ptStreamBuf->uxTriggerLevel = uxTriggerLevel;
+    }
+    OSIntUnlock();
+
+    return OS_TRUE;
+}
+
+uOSBase_t OSStreamBufWrite( OSStreamBufHandle_t StreamBufHandle, const void * pvData, uOSBase_t uxDataLen, uOSTick_t uxTicksToWait )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+    uOSBase_t uxWaitSpace = uxDataLen;
+    uOSBase_t uxWritten = ( uOSBase_t ) 0U;
+
+    if( uxWaitSpace >= ptStreamBuf->uxLength )
+    {
+        uxWaitSpace = ptStreamBuf->uxLength - ( uOSBase_t ) 1U;
+    }
+
+    /* Wait once for the whole data to fit, then write as much as fits. */
+    if( ( uxTicksToWait > ( uOSTick_t ) 0U ) && ( OSStreamBufSpace( ptStreamBuf ) < uxWaitSpace ) )
+    {
+        OSIntLock();
+        {
+            if( OSStreamBufSpace( ptStreamBuf ) < uxWaitSpace )
+            {
+                ptStreamBuf->uxWaitSpace = uxWaitSpace;
+                OSTaskListEventAdd( &( ptStreamBuf->tTaskListEventWrite ), uxTicksToWait );
+
+                OSSchedule();
+            }
+        }
+        OSIntUnlock();
+    }
+
+    uxWritten = OSStreamBufCopyIn( ptStreamBuf, pvData, uxDataLen );
+
+    /* The reader adds itself to the list with the interrupts locked after it
+    found too few bytes, so an empty list here means there is no one to wake. */
+    if( ( uxWritten > ( uOSBase_t ) 0U ) && ( OSListIsEmpty( &( ptStreamBuf->tTaskListEventRead ) ) == OS_FALSE ) )
+    {
+        OSIntLock();
+        {
+            if( OSStreamBufWakeReader( ptStreamBuf ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+        }
+        OSIntUnlock();
+    }
+
+    return uxWritten;
+}
+
+uOSBase_t OSStreamBufWriteFromISR( OSStreamBufHandle_t StreamBufHandle, const void * pvData, uOSBase_t uxDataLen )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBase_t uxWritten = ( uOSBase_t ) 0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    uxWritten = OSStreamBufCopyIn( ptStreamBuf, pvData, uxDataLen );
+
+    if( ( uxWritten > ( uOSBase_t ) 0U ) && ( OSListIsEmpty( &( ptStreamBuf->tTaskListEventRead ) ) == OS_FALSE ) )
+    {
+        uxIntSave = OSIntMaskFromISR();
+        {
+            bNeedSchedule = OSStreamBufWakeReader( ptStreamBuf );
+        }
+        OSIntUnmaskFromISR( uxIntSave );
+
+        if(SCHEDULER_RUNNING == OSScheduleGetState())
+        {
+            OSScheduleFromISR( bNeedSchedule );
+        }
+    }
+
+    return uxWritten;
+}
+
+uOSBase_t OSStreamBufRead( OSStreamBufHandle_t StreamBufHandle, void * pvBuffer, uOSBase_t uxBufferLen, uOSTick_t uxTicksToWait )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+    uOSBase_t uxWaitBytes = ptStreamBuf->uxTriggerLevel;
+    uOSBase_t uxRead = ( uOSBase_t ) 0U;
+
+    if( uxWaitBytes > uxBufferLen )
+    {
+        uxWaitBytes = uxBufferLen;
+    }
+
+    /* Wait once for the trigger level, then read whatever is there. */
+    if( ( uxTicksToWait > ( uOSTick_t ) 0U ) && ( OSStreamBufCount( ptStreamBuf ) < uxWaitBytes ) )
+    {
+        OSIntLock();
+        {
+            if( OSStreamBufCount( ptStreamBuf ) < uxWaitBytes )
+            {
+                ptStreamBuf->uxWaitBytes = uxWaitBytes;
+                OSTaskListEventAdd( &( ptStreamBuf->tTaskListEventRead ), uxTicksToWait );
+
+                OSSchedule();
+            }
+        }
+        OSIntUnlock();
+    }
+
+    uxRead = OSStreamBufCopyOut( ptStreamBuf, pvBuffer, uxBufferLen );
+
+    if( ( uxRead > ( uOSBase_t ) 0U ) && ( OSListIsEmpty( &( ptStreamBuf->tTaskListEventWrite ) ) == OS_FALSE ) )
+    {
+        OSIntLock();
+        {
+            if( OSStreamBufWakeWriter( ptStreamBuf ) != OS_FALSE )
+            {
+                OSSchedule();
+            }
+        }
+        OSIntUnlock();
+    }
+
+    return uxRead;
+}
+
+uOSBase_t OSStreamBufReadFromISR( OSStreamBufHandle_t StreamBufHandle, void * pvBuffer, uOSBase_t uxBufferLen )
+{
+    tOSStreamBuf_t * const ptStreamBuf = ( tOSStreamBuf_t * ) StreamBufHandle;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+    uOSBase_t uxRead = ( uOSBase_t ) 0U;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    uxRead = OSStreamBufCopyOut( ptStreamBuf, pvBuffer, uxBufferLen );
+
+    if( ( uxRead > ( uOSBase_t ) 0U ) && ( OSListIsEmpty( &( ptStreamBuf->tTaskListEventWrite ) ) == OS_FALSE ) )
+    {
+        uxIntSave = OSIntMaskFromISR();
+        {
+            bNeedSchedule = OSStreamBufWakeWriter( ptStreamBuf );
+        }
+        OSIntUnmaskFromISR( uxIntSave );
+
+        if(SCHEDULER_RUNNING == OSScheduleGetState())
+        {
+            OSScheduleFromISR( bNeedSchedule );
+        }
+    }
+
+    return uxRead;
+}
+
+uOSBase_t OSStreamBufGetBytes( const OSStreamBufHandle_t StreamBufHandle )
+{
+    return OSStreamBufCount( ( tOSStreamBuf_t * ) StreamBufHandle );
+}
+
+uOSBase_t OSStreamBufGetSpace( const OSStreamBufHandle_t StreamBufHandle )
+{
+    return OSStreamBufSpace( ( tOSStreamBuf_t * ) StreamBufHandle );
+}
+
+#endif //( OS_STREAMBUF_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,110 @@
+/**********************************************************************************************************
+TINIUX - A tiny and efficient embedded real time operating system (RTOS)
+Copyright (C) SenseRate.com All rights reserved.
+http://www.tiniux.org -- Documentation, latest information, license and contact details.
+http://www.tiniux.com -- Commercial support, development, porting, licensing and training services.
+--------------------------------------------------------------------------------------------------------
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met: 
+1. Redistributions of source code must retain the above copyright notice, this list of 
+conditions and the following disclaimer. 
+2. Redistributions in binary form must reproduce the above copyright notice, this list 
+of conditions and the following disclaimer in the documentation and/or other materials 
+provided with the distribution. 
+3. Neither the name of the copyright holder nor the names of its contributors may be used 
+to endorse or promote products derived from this software without specific prior written 
+permission. 
+--------------------------------------------------------------------------------------------------------
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+--------------------------------------------------------------------------------------------------------
+ Notice of Export Control Law 
+--------------------------------------------------------------------------------------------------------
+ TINIUX may be subject to applicable export control laws and regulations, which might 
+ include those applicable to TINIUX of U.S. and the country in which you are located. 
+ Import, export and usage of TINIUX in any manner by you shall be in compliance with such 
+ applicable export control laws and regulations. 
+***********************************************************************************************************/
+
+#ifndef __OS_STREAMBUF_H_
+#define __OS_STREAMBUF_H_
+
+#include "OSType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( OS_STREAMBUF_ON!=0 )
+
+/* Byte stream from one writer to one reader, e.g. a driver ISR to a task.
+   The data path takes no lock, the interrupts are only locked to block or
+   wake a task, and a blocked reader is only woken once the trigger level is
+   reached. */
+typedef struct tOSStreamBuf
+{
+    char                        pcStreamBufName[ OSNAME_MAX_LEN ];
+
+    uOS8_t *                    pucBuffer;
+    uOSBase_t                   uxLength;              // Size of the storage, one more than the capacity;
+
+    volatile uOSBase_t          uxHead;                // Next byte to write, only moved by the writer;
+    volatile uOSBase_t          uxTail;                // Next byte to read, only moved by the reader;
+
+    tOSList_t                   tTaskListEventWrite;   // StreamBuf Write TaskList;
+    tOSList_t                   tTaskListEventRead;    // StreamBuf Read TaskList;
+
+    uOSBase_t                   uxTriggerLevel;        // Bytes needed to wake a blocked reader;
+    volatile uOSBase_t          uxWaitBytes;           // Bytes the blocked reader waits for;
+    volatile uOSBase_t          uxWaitSpace;           // Space the blocked writer waits for;
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                      ucStaticAlloc;         // OS_TRUE if the memory was given by the application
+#endif
+
+    sOSBase_t                   xID;
+} tOSStreamBuf_t;
+
+typedef tOSStreamBuf_t*         OSStreamBufHandle_t;
+
+// Bytes of storage OSStreamBufCreateStatic needs: the data and one spare byte
+#define OSSTREAMBUF_STORAGE_SIZE( uxBufferSize )    ( ( uxBufferSize ) + 1U )
+
+OSStreamBufHandle_t OSStreamBufCreate( const uOSBase_t uxBufferSize, const uOSBase_t uxTriggerLevel ) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSStreamBufHandle_t OSStreamBufCreateStatic( const uOSBase_t uxBufferSize, const uOSBase_t uxTriggerLevel, uOS8_t * const pucStorage, tOSStreamBuf_t * const ptStreamBufBuffer ) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_MEMFREE_ON != 0 )
+void              OSStreamBufDelete( OSStreamBufHandle_t StreamBufHandle ) TINIUX_FUNCTION;
+#endif /* OS_MEMFREE_ON */
+
+sOSBase_t         OSStreamBufSetID(OSStreamBufHandle_t StreamBufHandle, sOSBase_t xID) TINIUX_FUNCTION;
+sOSBase_t         OSStreamBufGetID(OSStreamBufHandle_t const StreamBufHandle) TINIUX_FUNCTION;
+
+uOSBool_t         OSStreamBufSetTriggerLevel( OSStreamBufHandle_t StreamBufHandle, uOSBase_t uxTriggerLevel ) TINIUX_FUNCTION;
+
+uOSBase_t         OSStreamBufWrite( OSStreamBufHandle_t StreamBufHandle, const void * pvData, uOSBase_t uxDataLen, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBase_t         OSStreamBufWriteFromISR( OSStreamBufHandle_t StreamBufHandle, const void * pvData, uOSBase_t uxDataLen ) TINIUX_FUNCTION;
+
+uOSBase_t         OSStreamBufRead( OSStreamBufHandle_t StreamBufHandle, void * pvBuffer, uOSBase_t uxBufferLen, uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBase_t         OSStreamBufReadFromISR( OSStreamBufHandle_t StreamBufHandle, void * pvBuffer, uOSBase_t uxBufferLen ) TINIUX_FUNCTION;
+
+uOSBase_t         OSStreamBufGetBytes( const OSStreamBufHandle_t StreamBufHandle ) TINIUX_FUNCTION;
+uOSBase_t         OSStreamBufGetSpace( const OSStreamBufHandle_t StreamBufHandle ) TINIUX_FUNCTION;
+
+#endif //( OS_STREAMBUF_ON!=0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__OS_STREAMBUF_H_
@@ -42,17 +42,15 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-TINIUX_DATA tOSTCB_t * volatile gptCurrentTCB                       = OS_NULL;
+TINIUX_FAST_DATA tOSTCB_t * volatile gptCurrentTCB                  = OS_NULL;
 TINIUX_DATA volatile  uOSBase_t guxCurrentTaskNum                   = ( uOSBase_t ) 0U;
 
 /* Lists for ready and blocked tasks. --------------------*/
-TINIUX_DATA static tOSList_t gtOSTaskListReady[ OSHIGHEAST_PRIORITY ];
+TINIUX_FAST_DATA static tOSList_t gtOSTaskListReady[ OSHIGHEAST_PRIORITY ];
 TINIUX_DATA static tOSList_t gtOSTaskListReadyPool;
 TINIUX_DATA static tOSList_t gptOSTaskListSuspended;
-TINIUX_DATA static tOSList_t gtOSTaskListPend1;
-TINIUX_DATA static tOSList_t gtOSTaskListPend2;
-TINIUX_DATA static tOSList_t * volatile gptOSTaskListPend           = OS_NULL;
-TINIUX_DATA static tOSList_t * volatile gptOSTaskListLongPeriodPend = OS_NULL;
+TINIUX_DATA static tOSList_t gtOSTaskListPendSlots[ OSPEND_WHEEL_SIZE ];
+TINIUX_DATA static tOSListWheel_t gtOSTaskListPend;
 
 // delete task
 #if ( OS_MEMFREE_ON != 0 )
@@ -60,6 +58,31 @@ TINIUX_DATA static tOSList_t gptOSTaskListRecycle;
 TINIUX_DATA static volatile  uOSBase_t guxTasksDeleted              = ( uOSBase_t ) 0U;
 #endif /* OS_MEMFREE_ON */
 
+#if ( OS_STACK_MPU_GUARD_ON!=0 ) && !defined( FITSTACK_GUARD )
+  #error "SETOS_STACK_MPU_GUARD is not supported by this port"
+#endif
+
+/* The stack of the running task is checked in hardware, by the MPU guard or
+by a stack limit register of the port, so there is no check on each switch. */
+#if ( OS_STACK_MPU_GUARD_ON!=0 ) || defined( FITSTACK_LIMIT )
+#define OSSTACK_HW_CHECK_ON     ( 1U )
+#else
+#define OSSTACK_HW_CHECK_ON     ( 0U )
+#endif
+
+/* Every stack is filled with this byte when the task is created. */
+#define OSSTACK_FILL_BYTE       ( 0xA1U )
+
+#if ( OS_STACK_HIGHWATER_ON!=0 )
+/* The fill byte in every byte of a word, for the scan of the stacks. */
+#define OSSTACK_FILL_WORD       ( ( ~( uOSAddr_t ) 0U / ( uOSAddr_t ) 0xFFU ) * ( uOSAddr_t ) OSSTACK_FILL_BYTE )
+#define OSSTACK_WORD_MASK       ( ( uOSAddr_t ) sizeof( uOSAddr_t ) - ( uOSAddr_t ) 1U )
+
+#if ( OS_STACK_IDLE_SCAN_ON!=0 )
+TINIUX_DATA static uOSBase_t guxStackScanIndex                       = ( uOSBase_t ) 0U;
+#endif /* OS_STACK_IDLE_SCAN_ON */
+#endif /* OS_STACK_HIGHWATER_ON */
+
 #if ( OS_TASK_SIGNAL_ON!=0 )
 TINIUX_DATA static uOS8_t const SIG_STATE_NOTWAITING                = ( ( uOS8_t ) 0 );
 TINIUX_DATA static uOS8_t const SIG_STATE_WAITING                   = ( ( uOS8_t ) 1 );
@@ -75,23 +98,17 @@ static void OSTaskListInit( void )
         OSListInit( &( gtOSTaskListReady[ uxPriority ] ) );
     }
 
-    OSListInit( &gtOSTaskListPend1 );
-    OSListInit( &gtOSTaskListPend2 );
+    OSListWheelInit( &gtOSTaskListPend, gtOSTaskListPendSlots, OSPEND_WHEEL_SIZE );
     OSListInit( &gtOSTaskListReadyPool );
 #if ( OS_MEMFREE_ON != 0 )
     OSListInit( &gptOSTaskListRecycle );
 #endif /* OS_MEMFREE_ON */
     OSListInit( &gptOSTaskListSuspended );
-
-    gptOSTaskListPend = &gtOSTaskListPend1;
-    gptOSTaskListLongPeriodPend = &gtOSTaskListPend2;
 }
 
 uOSBase_t OSTaskInit( void )
 {
     gptCurrentTCB               = OS_NULL;
-    gptOSTaskListPend           = OS_NULL;
-    gptOSTaskListLongPeriodPend = OS_NULL;
     guxCurrentTaskNum     = ( uOSBase_t ) 0U;
 
 #if ( OS_MEMFREE_ON != 0 )
@@ -123,35 +140,63 @@ void OSTaskListReadyAdd(tOSTCB_t* ptTCB)
     OSListInsertItemToEnd( &( gtOSTaskListReady[ ( ptTCB )->uxPriority ] ), &( ( ptTCB )->tTaskListItem ) );
 }
 
-static OSTaskHandle_t OSAllocateTCBAndStack( const uOS16_t usStackDepth, uOSStack_t *puxStackBuffer )
+static OSTaskHandle_t OSAllocateTCBAndStack( const uOS16_t usStackDepth, uOSStack_t *puxStackBuffer, tOSTCB_t *ptTCBBuffer )
 {
-    OSTaskHandle_t ptNewTCB;
-    ptNewTCB = ( OSTaskHandle_t ) OSMemMalloc( sizeof( tOSTCB_t ) );
-    
-    /* Just to avoid compiler warnings. */
-    ( void ) puxStackBuffer;
-    
-    if( ptNewTCB != OS_NULL )
+    OSTaskHandle_t ptNewTCB = OS_NULL;
+
+    if( ( ptTCBBuffer != OS_NULL ) && ( puxStackBuffer != OS_NULL ) )
     {
-        ptNewTCB->puxStartStack = ( uOSStack_t * )OSMemMalloc( ( ( uOS16_t )usStackDepth ) * sizeof( uOSStack_t ));
+        /* The TCB and the stack are given by the application. */
+        ptNewTCB = ptTCBBuffer;
+        ptNewTCB->puxStartStack = puxStackBuffer;
+    }
+    else
+    {
+        /* Take the TCB and the stack from the region of OSTASK_MEM_HINT, any other one when it is full. */
+        ptNewTCB = ( OSTaskHandle_t ) OSMemMallocPrefer( sizeof( tOSTCB_t ), OSTASK_MEM_HINT );
 
-        if( ptNewTCB->puxStartStack == OS_NULL )
-        {
-            #if ( OS_MEMFREE_ON != 0 )
-            OSMemFree( ptNewTCB );
-            #endif /* OS_MEMFREE_ON */
-            
-            ptNewTCB = OS_NULL;
-        }
-        else
+        if( ptNewTCB != OS_NULL )
         {
-            memset( (void*)ptNewTCB->puxStartStack, ( uOS8_t ) 0xA1U, ( uOS32_t ) usStackDepth * sizeof( uOSStack_t ) );
+            ptNewTCB->puxStartStack = ( uOSStack_t * )OSMemMallocPrefer( ( ( uOS16_t )usStackDepth ) * sizeof( uOSStack_t ), OSTASK_MEM_HINT );
+
+            if( ptNewTCB->puxStartStack == OS_NULL )
+            {
+                #if ( OS_MEMFREE_ON != 0 )
+                OSMemFree( ptNewTCB );
+                #endif /* OS_MEMFREE_ON */
+
+                ptNewTCB = OS_NULL;
+            }
         }
     }
 
+    if( ptNewTCB != OS_NULL )
+    {
+        #if ( OS_STATIC_ALLOC_ON!=0 )
+        ptNewTCB->ucStaticAlloc = ( uOS8_t ) ( ( ptNewTCB == ptTCBBuffer ) ? OS_TRUE : OS_FALSE );
+        #endif /* OS_STATIC_ALLOC_ON */
+
+        memset( (void*)ptNewTCB->puxStartStack, ( uOS8_t ) OSSTACK_FILL_BYTE, ( uOS32_t ) usStackDepth * sizeof( uOSStack_t ) );
+    }
+
     return ptNewTCB;
 }
 
+#if ( OS_MEMFREE_ON != 0 )
+static void OSTaskFreeTCB( tOSTCB_t * const ptTCB )
+{
+    #if ( OS_STATIC_ALLOC_ON!=0 )
+    if( ptTCB->ucStaticAlloc != OS_FALSE )
+    {
+        return;
+    }
+    #endif /* OS_STATIC_ALLOC_ON */
+
+    OSMemFree( ptTCB->puxStartStack );
+    OSMemFree( ptTCB );
+}
+#endif /* OS_MEMFREE_ON */
+
 static void OSTaskInitTCB( tOSTCB_t * const ptTCB, const char * const pcName, uOSBase_t uxPriority, const uOS16_t usStackDepth )
 {
     uOSBase_t x = ( uOSBase_t ) 0;
@@ -185,8 +230,18 @@ static void OSTaskInitTCB( tOSTCB_t * const ptTCB, const char * const pcName, uO
     {
         ptTCB->ucSigState = SIG_STATE_NOTWAITING;        /*< Task signal state: NotWaiting Waiting Received. */
         ptTCB->uiSigValue = 0;                            /*< Task signal value: Msg or count. */        
+        #if ( OS_SELECT_ON!=0 )
+        ptTCB->ptSelect = OS_NULL;
+        #endif
     }
     #endif // OS_TASK_SIGNAL_ON!=0
+
+    #if ( OS_EVENT_ON!=0 )
+    {
+        ptTCB->uiEventFlags = 0;
+        ptTCB->ucEventOptions = 0;
+    }
+    #endif // OS_EVENT_ON!=0
         
     OSListItemInitialise( &( ptTCB->tTaskListItem ) );
     OSListItemInitialise( &( ptTCB->tEventListItem ) );
@@ -197,27 +252,33 @@ static void OSTaskInitTCB( tOSTCB_t * const ptTCB, const char * const pcName, uO
     OSListItemSetValue( &( ptTCB->tEventListItem ), ( uOSTick_t ) OSHIGHEAST_PRIORITY - ( uOSTick_t ) uxPriority );
     OSListItemSetHolder( &( ptTCB->tEventListItem ), ptTCB );
 
+    #if ( OS_STACK_HIGHWATER_ON!=0 ) && ( OS_STACK_IDLE_SCAN_ON!=0 )
+    ptTCB->usStackMinFree = usStackDepth;
+    #endif
+
     ( void ) usStackDepth;
 }
 
-OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
-                            void*               pvParameter,
-                            const uOS16_t       usStackDepth,
-                            uOSBase_t           uxPriority,
-                            sOS8_t*             pcTaskName)
+static OSTaskHandle_t OSTaskCreateGeneral(OSTaskFunction_t    pxTaskFunction,
+                                          void*               pvParameter,
+                                          const uOS16_t       usStackDepth,
+                                          uOSBase_t           uxPriority,
+                                          sOS8_t*             pcTaskName,
+                                          uOSStack_t*         puxStackBuffer,
+                                          tOSTCB_t*           ptTCBBuffer)
 {
     sOSBase_t xStatus = OS_FAIL;
     OSTaskHandle_t ptNewTCB = OS_NULL;
     uOSStack_t *puxTopOfStack = OS_NULL;
 
-    ptNewTCB = (tOSTCB_t * )OSAllocateTCBAndStack( usStackDepth, OS_NULL );
+    ptNewTCB = (tOSTCB_t * )OSAllocateTCBAndStack( usStackDepth, puxStackBuffer, ptTCBBuffer );
 
     if( ptNewTCB != OS_NULL )
     {
         #if( OSSTACK_GROWTH < 0 )
         {
             puxTopOfStack = ptNewTCB->puxStartStack + ( usStackDepth - ( uOS16_t ) 1 );
-            puxTopOfStack = ( uOSStack_t * ) ( ( ( uOS32_t ) puxTopOfStack ) & ( ~( ( uOS32_t ) OSMEM_ALIGNMENT_MASK ) ) );
+            puxTopOfStack = ( uOSStack_t * ) ( ( ( uOSAddr_t ) puxTopOfStack ) & ( ~( ( uOSAddr_t ) OSMEM_ALIGNMENT_MASK ) ) );
         }
         #else
         {
@@ -271,10 +332,38 @@ OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
     return ptNewTCB;
 }
 
+OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
+                            void*               pvParameter,
+                            const uOS16_t       usStackDepth,
+                            uOSBase_t           uxPriority,
+                            sOS8_t*             pcTaskName)
+{
+    return OSTaskCreateGeneral( pxTaskFunction, pvParameter, usStackDepth, uxPriority, pcTaskName, OS_NULL, OS_NULL );
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTaskHandle_t OSTaskCreateStatic(OSTaskFunction_t    pxTaskFunction,
+                                  void*               pvParameter,
+                                  const uOS16_t       usStackDepth,
+                                  uOSBase_t           uxPriority,
+                                  sOS8_t*             pcTaskName,
+                                  uOSStack_t*         puxStackBuffer,
+                                  tOSTCB_t*           ptTCBBuffer)
+{
+    if( ( puxStackBuffer == OS_NULL ) || ( ptTCBBuffer == OS_NULL ) )
+    {
+        return OS_NULL;
+    }
+
+    return OSTaskCreateGeneral( pxTaskFunction, pvParameter, usStackDepth, uxPriority, pcTaskName, puxStackBuffer, ptTCBBuffer );
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
 #if ( OS_MEMFREE_ON != 0 )
 void OSTaskDelete( OSTaskHandle_t xTaskToDelete )
 {
     tOSTCB_t *ptTCB = OS_NULL;
+    tOSTCB_t *ptTCBToFree = OS_NULL;
 
     OSIntLock();
     {
@@ -298,12 +387,17 @@ void OSTaskDelete( OSTaskHandle_t xTaskToDelete )
         else
         {
             --guxCurrentTaskNum;
-            OSMemFree(ptTCB->puxStartStack);
-            OSUpdateUnblockTime();
+            ptTCBToFree = ptTCB;
         }        
     }
     OSIntUnlock();
 
+    // The task is off all the lists, free it with the interrupts on 
+    if( ptTCBToFree != OS_NULL )
+    {
+        OSTaskFreeTCB( ptTCBToFree );
+    }
+
     if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
     {
         if( ptTCB == gptCurrentTCB )
@@ -359,7 +453,7 @@ static void OSTaskListRecycleRemove( void )
         }
         OSIntUnlock();
 
-        OSMemFree(ptTCB->puxStartStack);
+        OSTaskFreeTCB( ptTCB );
     }
 
 }
@@ -386,28 +480,23 @@ static void OSTaskListPendAdd(tOSTCB_t* ptTCB, const uOSTick_t uxTicksToWait, uO
     }
     else
     {
-        uxTimeToWake = uxTickCount + uxTicksToWait;
-        OSListItemSetValue( &( ptTCB->tTaskListItem ), uxTimeToWake );
-
-        if( uxTimeToWake < uxTickCount )
+        /* The wheel only looks at the slot of the current tick, so the
+        earliest a task can wake is on the next one. */
+        if( uxTicksToWait == ( uOSTick_t ) 0U )
         {
-            OSListInsertItem( gptOSTaskListLongPeriodPend, &( ptTCB->tTaskListItem ) );
+            uxTimeToWake = uxTickCount + ( uOSTick_t ) 1U;
         }
         else
         {
-            OSListInsertItem( gptOSTaskListPend, &( ptTCB->tTaskListItem ) );
-            OSUpdateUnblockTime();
+            uxTimeToWake = uxTickCount + uxTicksToWait;
         }
-    }    
-}
-
-void OSTaskListPendSwitch( void )
-{
-    tOSList_t *ptTempList = OS_NULL;
+        OSListItemSetValue( &( ptTCB->tTaskListItem ), uxTimeToWake );
 
-    ptTempList = gptOSTaskListPend;
-    gptOSTaskListPend = gptOSTaskListLongPeriodPend;
-    gptOSTaskListLongPeriodPend = ptTempList;
+        OSListWheelInsertItem( &gtOSTaskListPend, &( ptTCB->tTaskListItem ) );
+#if ( OS_LOWPOWER_ON!=0 )
+        OSAdvanceUnblockTime( uxTimeToWake );
+#endif /* OS_LOWPOWER_ON */
+    }    
 }
 
 void OSTaskListEventAdd( tOSList_t * const ptEventList, const uOSTick_t uxTicksToWait )
@@ -419,10 +508,49 @@ void OSTaskListEventAdd( tOSList_t * const ptEventList, const uOSTick_t uxTicksT
 
 uOSBool_t OSTaskListEventRemove( const tOSList_t * const ptEventList )
 {
-    tOSTCB_t *pxUnblockedTCB = OS_NULL;
-    uOSBool_t bReturn = OS_FALSE;
+    return OSTaskListEventRemoveTask( ( tOSTCB_t * ) OSListGetHeadItemHolder( ptEventList ) );
+}
+
+#if ( OS_MSGQ_ON!=0 ) || ( OS_MSGBUF_ON!=0 )
+/* Block on the event list until ulNeed items or bytes are available. */
+void OSTaskListEventAddNeed( tOSList_t * const ptEventList, const uOS32_t ulNeed, const uOSTick_t uxTicksToWait )
+{
+    gptCurrentTCB->ulEventNeed = ulNeed;
+    OSTaskListEventAdd( ptEventList, uxTicksToWait );
+}
+
+/* Wake, highest priority first, every task whose need fits in what is still
+available once the tasks before it are served. A task which needs more than
+is left does not hold back the smaller ones behind it. */
+uOSBool_t OSTaskListEventRemoveFit( const tOSList_t * const ptEventList, uOS32_t ulAvailable )
+{
+    tOSListItem_t *ptIterator = OSListGetHeadItem( ptEventList );
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    while( ( ulAvailable > 0UL ) && ( ptIterator != OSListGetEndMarkerItem( ptEventList ) ) )
+    {
+        ptTCB = ( tOSTCB_t * ) OSListItemGetHolder( ptIterator );
+        ptIterator = OSListItemGetNextItem( ptIterator );
+
+        if( ptTCB->ulEventNeed <= ulAvailable )
+        {
+            ulAvailable -= ptTCB->ulEventNeed;
+            if( OSTaskListEventRemoveTask( ptTCB ) != OS_FALSE )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    return bNeedSchedule;
+}
+#endif /* ( OS_MSGQ_ON!=0 ) || ( OS_MSGBUF_ON!=0 ) */
 
-    pxUnblockedTCB = ( tOSTCB_t * ) OSListGetHeadItemHolder( ptEventList );
+uOSBool_t OSTaskListEventRemoveTask( OSTaskHandle_t const TaskHandle )
+{
+    tOSTCB_t * const pxUnblockedTCB = ( tOSTCB_t * ) TaskHandle;
+    uOSBool_t bReturn = OS_FALSE;
 
     ( void ) OSListRemoveItem( &( pxUnblockedTCB->tEventListItem ) );
 
@@ -445,19 +573,49 @@ uOSBool_t OSTaskListEventRemove( const tOSList_t * const ptEventList )
     {
         bReturn = OS_FALSE;
     }
-    OSUpdateUnblockTime();
     
     return bReturn;
 }
 
-uOSBase_t OSTaskListPendNum( void )
+uOSBool_t OSTaskListPendWake( const uOSTick_t uxTickCount )
 {
-    return OSListGetLength( gptOSTaskListPend );
+    tOSList_t * const ptSlot = OSListWheelGetSlot( &gtOSTaskListPend, uxTickCount );
+    tOSListItem_t *ptIterator = OS_NULL;
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+
+    /* Only the slot of this tick can hold tasks due now, the others in it
+    are due a whole number of turns later. */
+    ptIterator = OSListGetHeadItem( ptSlot );
+    while( ptIterator != OSListGetEndMarkerItem( ptSlot ) )
+    {
+        ptTCB = ( tOSTCB_t * ) OSListItemGetHolder( ptIterator );
+        ptIterator = OSListItemGetNextItem( ptIterator );
+
+        if( OSListItemGetValue( &( ptTCB->tTaskListItem ) ) == uxTickCount )
+        {
+            ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
+
+            if( OSListItemGetList( &( ptTCB->tEventListItem ) ) != OS_NULL )
+            {
+                ( void ) OSListRemoveItem( &( ptTCB->tEventListItem ) );
+            }
+
+            OSTaskListReadyAdd( ptTCB );
+
+            if( ptTCB->uxPriority >= gptCurrentTCB->uxPriority )
+            {
+                bNeedSchedule = OS_TRUE;
+            }
+        }
+    }
+
+    return bNeedSchedule;
 }
 
-OSTaskHandle_t OSTaskListPendHeadItem( void )
+uOSTick_t OSTaskListPendNextDelta( const uOSTick_t uxTickCount )
 {
-    return ( tOSTCB_t * ) OSListGetHeadItemHolder( gptOSTaskListPend );
+    return OSListWheelGetNextDelta( &gtOSTaskListPend, uxTickCount );
 }
 
 uOSBase_t OSTaskListReadyPoolNum( void )
@@ -475,6 +633,7 @@ uOSBase_t OSTaskListReadyNum( uOSBase_t uxPriority )
     return OSListGetLength( &( gtOSTaskListReady[ ( uxPriority ) ] ) );
 }
 
+#if ( OSSTACK_HW_CHECK_ON==0 )
 static void OSTaskCheckStackStatus()
 {
     uOSStack_t* puxStackTemp = (uOSStack_t*)gptCurrentTCB->puxTopOfStack;
@@ -491,6 +650,7 @@ static void OSTaskCheckStackStatus()
     }
     #endif
 }
+#endif /* OSSTACK_HW_CHECK_ON */
 
 void OSTaskSwitchContext( void )
 {
@@ -500,9 +660,13 @@ void OSTaskSwitchContext( void )
     }
     else
     {
-        OSNeedSchedule();
+        // The switch happens now, a schedule left pending would raise another one on every tick
+        OSClearSchedule();
 
+        // With a hardware stack check the port sets it up for the new task instead 
+        #if ( OSSTACK_HW_CHECK_ON==0 )
         OSTaskCheckStackStatus();
+        #endif
         OSTaskSelectToSchedule();
     }
 }
@@ -555,8 +719,7 @@ eOSTaskState_t OSTaskGetState( OSTaskHandle_t TaskHandle )
 {
     eOSTaskState_t eReturn = eTaskStateRuning;
     tOSList_t const *ptStateList = OS_NULL;
-    tOSList_t const *ptOSTaskListPend = OS_NULL;
-    tOSList_t const *ptOSTaskListLongPeriodPend = OS_NULL;
+    uOSBool_t bPending = OS_FALSE;
     const tOSTCB_t * const ptTCB = ( tOSTCB_t * ) TaskHandle;
 
     if( ptTCB == gptCurrentTCB )
@@ -568,12 +731,11 @@ eOSTaskState_t OSTaskGetState( OSTaskHandle_t TaskHandle )
         OSIntLock();
         {
             ptStateList = ( tOSList_t * ) OSListItemGetList( &( ptTCB->tTaskListItem ) );
-            ptOSTaskListPend = gptOSTaskListPend;
-            ptOSTaskListLongPeriodPend = gptOSTaskListLongPeriodPend;
+            bPending = OSListWheelContainListItem( &gtOSTaskListPend, &( ptTCB->tTaskListItem ) );
         }
         OSIntUnlock();
 
-        if( ( ptStateList == ptOSTaskListPend ) || ( ptStateList == ptOSTaskListLongPeriodPend ) )
+        if( bPending != OS_FALSE )
         {
             eReturn = eTaskStateBlocked;
         }
@@ -733,6 +895,220 @@ void OSTaskSetPriority( OSTaskHandle_t TaskHandle, uOSBase_t uxNewPriority )
     OSIntUnlock();
 }
 
+#if ( OS_STACK_HIGHWATER_ON!=0 )
+/* Count the stack still holding the fill pattern, from the far end of the
+   stack up to the first byte written. Most of it is compared a word at a
+   time. The caller keeps the task from being deleted, the interrupts stay on. */
+static uOS16_t OSTaskStackCountFree( const tOSTCB_t * const ptTCB )
+{
+    #if( OSSTACK_GROWTH < 0 )
+    #if ( OS_STACK_MPU_GUARD_ON!=0 )
+    /* The guard of the running task can not be read, it is not counted as free. */
+    const uOS8_t * const pucStart = ( const uOS8_t * ) FitStackGuardEnd( ptTCB->puxStartStack );
+    #else
+    const uOS8_t * const pucStart = ( const uOS8_t * ) ptTCB->puxStartStack;
+    #endif
+    const uOS8_t * const pucEnd = ( const uOS8_t * ) ptTCB->puxTopOfStack;
+    const uOS8_t *pucScan = pucStart;
+
+    while( ( pucScan < pucEnd ) && ( ( ( uOSAddr_t ) pucScan & OSSTACK_WORD_MASK ) != 0U ) && ( *pucScan == OSSTACK_FILL_BYTE ) )
+    {
+        pucScan++;
+    }
+    if( ( ( uOSAddr_t ) pucScan & OSSTACK_WORD_MASK ) == 0U )
+    {
+        while( ( ( uOSAddr_t ) ( pucEnd - pucScan ) >= sizeof( uOSAddr_t ) ) && ( *( const uOSAddr_t * ) pucScan == OSSTACK_FILL_WORD ) )
+        {
+            pucScan += sizeof( uOSAddr_t );
+        }
+    }
+    while( ( pucScan < pucEnd ) && ( *pucScan == OSSTACK_FILL_BYTE ) )
+    {
+        pucScan++;
+    }
+
+    return ( uOS16_t ) ( ( uOSAddr_t ) ( pucScan - pucStart ) / sizeof( uOSStack_t ) );
+    #else
+    const uOS8_t * const pucStart = ( const uOS8_t * ) ptTCB->puxTopOfStack;
+    const uOS8_t * const pucEnd = ( const uOS8_t * ) ptTCB->puxEndOfStack + sizeof( uOSStack_t );
+    const uOS8_t *pucScan = pucEnd;
+
+    while( ( pucScan > pucStart ) && ( ( ( uOSAddr_t ) pucScan & OSSTACK_WORD_MASK ) != 0U ) && ( pucScan[ -1 ] == OSSTACK_FILL_BYTE ) )
+    {
+        pucScan--;
+    }
+    if( ( ( uOSAddr_t ) pucScan & OSSTACK_WORD_MASK ) == 0U )
+    {
+        while( ( ( uOSAddr_t ) ( pucScan - pucStart ) >= sizeof( uOSAddr_t ) ) && ( ( ( const uOSAddr_t * ) pucScan )[ -1 ] == OSSTACK_FILL_WORD ) )
+        {
+            pucScan -= sizeof( uOSAddr_t );
+        }
+    }
+    while( ( pucScan > pucStart ) && ( pucScan[ -1 ] == OSSTACK_FILL_BYTE ) )
+    {
+        pucScan--;
+    }
+
+    return ( uOS16_t ) ( ( uOSAddr_t ) ( pucEnd - pucScan ) / sizeof( uOSStack_t ) );
+    #endif
+}
+
+#if ( OS_STACK_IDLE_SCAN_ON!=0 )
+/* The uxIndex-th task of the ready, pend and suspended lists, OS_NULL past
+   the last one. The scheduler must be locked so the tasks stay on their lists. */
+static tOSTCB_t * OSTaskListGetTask( uOSBase_t uxIndex )
+{
+    tOSList_t *ptList = OS_NULL;
+    tOSListItem_t const *ptItem = OS_NULL;
+    /* The number of lists does not fit in an 8 bit uOSBase_t. */
+    uOS32_t ulList = 0UL;
+    const uOS32_t ulListNum = ( uOS32_t ) OSHIGHEAST_PRIORITY + ( uOS32_t ) OSPEND_WHEEL_SIZE + 1UL;
+
+    for( ulList = 0UL; ulList < ulListNum; ulList++ )
+    {
+        if( ulList < ( uOS32_t ) OSHIGHEAST_PRIORITY )
+        {
+            ptList = &( gtOSTaskListReady[ ulList ] );
+        }
+        else if( ulList < ( uOS32_t ) OSHIGHEAST_PRIORITY + ( uOS32_t ) OSPEND_WHEEL_SIZE )
+        {
+            ptList = &( gtOSTaskListPendSlots[ ulList - ( uOS32_t ) OSHIGHEAST_PRIORITY ] );
+        }
+        else
+        {
+            ptList = &( gptOSTaskListSuspended );
+        }
+
+        if( uxIndex >= OSListGetLength( ptList ) )
+        {
+            uxIndex -= OSListGetLength( ptList );
+            continue;
+        }
+
+        ptItem = OSListGetHeadItem( ptList );
+        while( uxIndex > ( uOSBase_t ) 0U )
+        {
+            ptItem = OSListItemGetNextItem( ptItem );
+            uxIndex--;
+        }
+        return ( tOSTCB_t * ) OSListItemGetHolder( ptItem );
+    }
+
+    return OS_NULL;
+}
+#endif /* OS_STACK_IDLE_SCAN_ON */
+
+/* Fill ptUsage from uxNum on with the tasks of ptList, up to uxMaxNum in all,
+   returns the new number filled. */
+static uOSBase_t OSTaskListGetStackUsage( const tOSList_t * const ptList, tOSTaskStackUsage_t * const ptUsage, uOSBase_t uxNum, const uOSBase_t uxMaxNum )
+{
+    tOSListItem_t const *ptItem = OSListGetHeadItem( ptList );
+    tOSTCB_t *ptTCB = OS_NULL;
+
+    while( ( uxNum < uxMaxNum ) && ( ptItem != OSListGetEndMarkerItem( ptList ) ) )
+    {
+        ptTCB = ( tOSTCB_t * ) OSListItemGetHolder( ptItem );
+
+        ptUsage[ uxNum ].TaskHandle = ptTCB;
+        #if ( OS_STACK_IDLE_SCAN_ON!=0 )
+        ptUsage[ uxNum ].usStackMinFree = ptTCB->usStackMinFree;
+        #else
+        ptUsage[ uxNum ].usStackMinFree = OSTaskStackCountFree( ptTCB );
+        #endif
+
+        uxNum++;
+        ptItem = OSListItemGetNextItem( ptItem );
+    }
+
+    return uxNum;
+}
+
+/* Lock out the other tasks, so the one being scanned can not be deleted. */
+static void OSTaskStackScanLock( void )
+{
+    if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
+    {
+        OSScheduleLock();
+    }
+}
+
+static void OSTaskStackScanUnlock( void )
+{
+    if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
+    {
+        ( void ) OSScheduleUnlock();
+    }
+}
+
+/* Lowest free stack the task (OS_NULL for the calling one) ever had, in
+   uOSStack_t like usStackDepth. Only the scheduler is locked for the scan. */
+uOS16_t OSTaskGetStackHighWaterMark( OSTaskHandle_t TaskHandle )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+    uOS16_t usFree = ( uOS16_t ) 0U;
+
+    OSTaskStackScanLock();
+    {
+        ptTCB = ( tOSTCB_t * ) OSTaskGetTCBFromHandle( TaskHandle );
+        usFree = OSTaskStackCountFree( ptTCB );
+        #if ( OS_STACK_IDLE_SCAN_ON!=0 )
+        ptTCB->usStackMinFree = usFree;
+        #endif
+    }
+    OSTaskStackScanUnlock();
+
+    return usFree;
+}
+
+/* Fill ptUsage with the lowest free stack of up to uxMaxNum tasks, returns
+   the number filled. With SETOS_STACK_IDLE_SCAN the values found by the idle
+   task are returned, otherwise the stacks are scanned with the scheduler locked. */
+uOSBase_t OSTaskGetStackUsage( tOSTaskStackUsage_t * const ptUsage, uOSBase_t uxMaxNum )
+{
+    uOSBase_t uxNum = ( uOSBase_t ) 0U;
+    uOSBase_t uxList = ( uOSBase_t ) 0U;
+
+    /* Each list is walked once, in the order of OSTaskListGetTask. */
+    OSTaskStackScanLock();
+    for( uxList = ( uOSBase_t ) 0U; uxList < ( uOSBase_t ) OSHIGHEAST_PRIORITY; uxList++ )
+    {
+        uxNum = OSTaskListGetStackUsage( &( gtOSTaskListReady[ uxList ] ), ptUsage, uxNum, uxMaxNum );
+    }
+    for( uxList = ( uOSBase_t ) 0U; uxList < ( uOSBase_t ) OSPEND_WHEEL_SIZE; uxList++ )
+    {
+        uxNum = OSTaskListGetStackUsage( &( gtOSTaskListPendSlots[ uxList ] ), ptUsage, uxNum, uxMaxNum );
+    }
+    uxNum = OSTaskListGetStackUsage( &gptOSTaskListSuspended, ptUsage, uxNum, uxMaxNum );
+    OSTaskStackScanUnlock();
+
+    return uxNum;
+}
+
+#if ( OS_STACK_IDLE_SCAN_ON!=0 )
+/* Scan the stack of the next task, one task per call of the idle loop. */
+static void OSTaskStackIdleScan( void )
+{
+    tOSTCB_t *ptTCB = OS_NULL;
+
+    OSScheduleLock();
+    {
+        ptTCB = OSTaskListGetTask( guxStackScanIndex );
+        if( ptTCB == OS_NULL )
+        {
+            guxStackScanIndex = ( uOSBase_t ) 0U;
+            ptTCB = OSTaskListGetTask( guxStackScanIndex );
+        }
+        if( ptTCB != OS_NULL )
+        {
+            ptTCB->usStackMinFree = OSTaskStackCountFree( ptTCB );
+            guxStackScanIndex++;
+        }
+    }
+    ( void ) OSScheduleUnlock();
+}
+#endif /* OS_STACK_IDLE_SCAN_ON */
+#endif /* OS_STACK_HIGHWATER_ON */
+
 #if ( OS_MUTEX_ON!= 0 )
 OSTaskHandle_t OSTaskGetMutexHolder( void )
 {
@@ -888,7 +1264,8 @@ void OSTaskPriorityDisinheritAfterTimeout( OSTaskHandle_t const MutexHolderTaskH
 #if (OSTIME_SLICE_ON != 0U)
 uOSBool_t OSTaskNeedTimeSlice( void )
 {
-    return (uOSBool_t)(OSListGetLength( &( gtOSTaskListReady[ gptCurrentTCB-> uxPriority ] ) )>0U);
+    // Only when another task shares the priority of the running one
+    return (uOSBool_t)(OSListGetLength( &( gtOSTaskListReady[ gptCurrentTCB-> uxPriority ] ) )>1U);
 }
 #endif //(OSTIME_SLICE_ON != 0U)
 
@@ -931,16 +1308,6 @@ void OSTaskSuspend( OSTaskHandle_t TaskHandle )
     }
     OSIntUnlock();
 
-    if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
-    {
-        /* Update the next expected unblock time */
-        OSIntLock();
-        {
-            OSUpdateUnblockTime();
-        }
-        OSIntUnlock();
-    }
-
     if( ptTCB == gptCurrentTCB )
     {
         if( OSScheduleGetState() != SCHEDULER_NOT_STARTED )
@@ -1079,6 +1446,10 @@ void OSIdleTask( void *pvParameters)
             OSTaskListRecycleRemove();
         }
         #endif /* OS_MEMFREE_ON */        
+
+        #if ( OS_STACK_HIGHWATER_ON!=0 ) && ( OS_STACK_IDLE_SCAN_ON!=0 )
+        OSTaskStackIdleScan();
+        #endif
         
         #if ( OS_LOWPOWER_ON!=0 )
         {
@@ -1176,8 +1547,6 @@ uOSBool_t OSTaskSignalEmit( OSTaskHandle_t const TaskHandle )
             ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
             OSTaskListReadyAdd( ptTCB );
 
-            OSUpdateUnblockTime();
-
             if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
             {
                 /* The signaled task has a priority above the currently
@@ -1185,6 +1554,12 @@ uOSBool_t OSTaskSignalEmit( OSTaskHandle_t const TaskHandle )
                 OSSchedule();
             }
         }
+#if ( OS_SELECT_ON!=0 )
+        if( OSSelectNotify( ptTCB->ptSelect ) != OS_FALSE )
+        {
+            OSSchedule();
+        }
+#endif /* OS_SELECT_ON */
     }
     OSIntUnlock();
 
@@ -1239,6 +1614,12 @@ uOSBool_t OSTaskSignalEmitFromISR( OSTaskHandle_t const TaskHandle )
                 bNeedSchedule = OS_TRUE;
             }
         }
+#if ( OS_SELECT_ON!=0 )
+        if( OSSelectNotify( ptTCB->ptSelect ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+#endif /* OS_SELECT_ON */
     }
     OSIntUnmaskFromISR( uxIntSave );    
     
@@ -1339,8 +1720,6 @@ uOSBool_t OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const ui
             ( void ) OSListRemoveItem( &( ptTCB->tTaskListItem ) );
             OSTaskListReadyAdd( ptTCB );
 
-            OSUpdateUnblockTime();
-
             if( ptTCB->uxPriority > gptCurrentTCB->uxPriority )
             {
                 /* The signaled task has a priority above the currently
@@ -1348,6 +1727,12 @@ uOSBool_t OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const ui
                 OSSchedule();
             }
         }
+#if ( OS_SELECT_ON!=0 )
+        if( OSSelectNotify( ptTCB->ptSelect ) != OS_FALSE )
+        {
+            OSSchedule();
+        }
+#endif /* OS_SELECT_ON */
     }
     OSIntUnlock();
 
@@ -1402,6 +1787,12 @@ uOSBool_t OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t c
                 bNeedSchedule = OS_TRUE;
             }
         }
+#if ( OS_SELECT_ON!=0 )
+        if( OSSelectNotify( ptTCB->ptSelect ) != OS_FALSE )
+        {
+            bNeedSchedule = OS_TRUE;
+        }
+#endif /* OS_SELECT_ON */
     }
     OSIntUnmaskFromISR( uxIntSave );
 
@@ -1411,6 +1802,16 @@ uOSBool_t OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t c
     }
     return bReturn;
 }
+#if ( OS_SELECT_ON!=0 )
+/* Check whether OSTaskSignalWait or OSTaskSignalWaitMsg would return at once,
+must be called with the interrupts locked. */
+uOSBool_t OSTaskSignalIsPending( OSTaskHandle_t const TaskHandle )
+{
+    tOSTCB_t * const ptTCB = ( tOSTCB_t * ) TaskHandle;
+
+    return ( uOSBool_t ) ( ( ptTCB->ucSigState == SIG_STATE_RECEIVED ) || ( ptTCB->uiSigValue != 0UL ) );
+}
+#endif /* OS_SELECT_ON */
 uOSBool_t OSTaskSignalClear( OSTaskHandle_t const TaskHandle )
 {
     tOSTCB_t *ptTCB = OS_NULL;
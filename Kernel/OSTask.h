@@ -79,22 +79,59 @@ typedef struct OSTaskControlBlock
 #endif
 
     sOSBase_t               xID;
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                  ucStaticAlloc;        /*< OS_TRUE if the TCB and the stack were given by the application. */
+#endif
     
 #if ( OS_TASK_SIGNAL_ON!=0 )                      /*< Task signal: SEM_SIG MSG_SIG MSG_SIG_OVERWRITE. */
     volatile uOS8_t         ucSigState;           /*< Task signal state: NotWaiting Waiting GotSignal. */
     volatile uOS32_t        uiSigValue;           /*< Task signal value: Msg or count. */
+#if ( OS_SELECT_ON!=0 )
+    struct tOSSelect *      ptSelect;             /*< The select the task signal belongs to. */
+#endif
+#endif
+
+#if ( OS_EVENT_ON!=0 )
+    volatile uOS32_t        uiEventFlags;         /*< Event flags waited for, then the flags which woke the task. */
+    volatile uOS8_t         ucEventOptions;       /*< Event flags wait options: Any/All AutoClear, and Satisfied. */
+#endif
+
+#if ( OS_MSGQ_ON!=0 ) || ( OS_MSGBUF_ON!=0 )
+    uOS32_t                 ulEventNeed;          /*< Items or bytes a blocked MsgQ/MsgBuf task needs before it can go on. */
+#endif
+
+#if ( OS_STACK_HIGHWATER_ON!=0 ) && ( OS_STACK_IDLE_SCAN_ON!=0 )
+    uOS16_t                 usStackMinFree;       /*< Lowest free stack found by the idle task, in uOSStack_t. */
 #endif
 
 } tOSTCB_t;
 
 typedef    tOSTCB_t*        OSTaskHandle_t;
 
+#if ( OS_STACK_HIGHWATER_ON!=0 )
+typedef struct tOSTaskStackUsage
+{
+    OSTaskHandle_t          TaskHandle;
+    uOS16_t                 usStackMinFree;       /*< Lowest free stack since the task was created, in uOSStack_t. */
+} tOSTaskStackUsage_t;
+#endif /* OS_STACK_HIGHWATER_ON */
+
 uOSBase_t    OSTaskInit( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSTaskCreate(OSTaskFunction_t    pxTaskFunction,
                             void*               pvParameter,
                             const uOS16_t       usStackDepth,
                             uOSBase_t           uxPriority,
                             sOS8_t*             pcTaskName) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTaskHandle_t OSTaskCreateStatic(OSTaskFunction_t    pxTaskFunction,
+                                  void*               pvParameter,
+                                  const uOS16_t       usStackDepth,
+                                  uOSBase_t           uxPriority,
+                                  sOS8_t*             pcTaskName,
+                                  uOSStack_t*         puxStackBuffer,
+                                  tOSTCB_t*           ptTCBBuffer) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
 #if ( OS_MEMFREE_ON != 0 )
 void         OSTaskDelete( OSTaskHandle_t xTaskToDelete ) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
@@ -106,15 +143,19 @@ uOSBase_t    OSTaskGetPriorityFromISR( OSTaskHandle_t const TaskHandle ) TINIUX_
 
 void         OSTaskListEventAdd( tOSList_t * const ptEventList, const uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskListEventRemove( const tOSList_t * const ptEventList ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskListEventRemoveTask( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+#if ( OS_MSGQ_ON!=0 ) || ( OS_MSGBUF_ON!=0 )
+void         OSTaskListEventAddNeed( tOSList_t * const ptEventList, const uOS32_t ulNeed, const uOSTick_t uxTicksToWait ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskListEventRemoveFit( const tOSList_t * const ptEventList, uOS32_t ulAvailable ) TINIUX_FUNCTION;
+#endif
 void         OSTaskListReadyAdd(tOSTCB_t* ptTCB) TINIUX_FUNCTION;
 uOSBase_t    OSTaskListReadyNum( uOSBase_t uxPriority ) TINIUX_FUNCTION;
-uOSBase_t    OSTaskListPendNum( void ) TINIUX_FUNCTION;
 uOSBase_t    OSTaskListReadyPoolNum( void ) TINIUX_FUNCTION;
-OSTaskHandle_t OSTaskListPendHeadItem( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSTaskListReadyPoolHeadItem( void ) TINIUX_FUNCTION;
 
-void         OSTaskListPendSwitch( void ) TINIUX_FUNCTION;
-void         OSTaskSwitchContext( void ) TINIUX_FUNCTION;
+uOSBool_t    OSTaskListPendWake( const uOSTick_t uxTickCount ) TINIUX_FUNCTION;
+uOSTick_t    OSTaskListPendNextDelta( const uOSTick_t uxTickCount ) TINIUX_FUNCTION;
+void         OSTaskSwitchContext( void ) TINIUX_FAST_FUNCTION;
 
 #if (OSTIME_SLICE_ON != 0U)
 uOSBool_t    OSTaskNeedTimeSlice( void ) TINIUX_FUNCTION;
@@ -127,6 +168,11 @@ uOSBase_t    OSTaskGetCurrentTaskNum( void ) TINIUX_FUNCTION;
 OSTaskHandle_t OSGetCurrentTaskHandle( void ) TINIUX_FUNCTION;
 void         OSIdleTask( void *pvParameters) TINIUX_FUNCTION;
 
+#if ( OS_STACK_HIGHWATER_ON!=0 )
+uOS16_t      OSTaskGetStackHighWaterMark( OSTaskHandle_t TaskHandle ) TINIUX_FUNCTION;
+uOSBase_t    OSTaskGetStackUsage( tOSTaskStackUsage_t * const ptUsage, uOSBase_t uxMaxNum ) TINIUX_FUNCTION;
+#endif /* OS_STACK_HIGHWATER_ON */
+
 #if ( OS_MUTEX_ON!= 0 )
 OSTaskHandle_t OSTaskGetMutexHolder( void ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskPriorityInherit( OSTaskHandle_t const MutexHolderTaskHandle ) TINIUX_FUNCTION;
@@ -146,6 +192,9 @@ uOSBool_t    OSTaskSignalWaitMsg( uOS32_t* puiSigValue, uOSTick_t const uxTicksT
 uOSBool_t    OSTaskSignalEmitMsg( OSTaskHandle_t const TaskHandle, uOS32_t const uiSigValue, uOSBool_t bOverWrite ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskSignalEmitMsgFromISR( OSTaskHandle_t const TaskHandle, uOS32_t const uiSigValue, uOSBool_t bOverWrite ) TINIUX_FUNCTION;
 uOSBool_t    OSTaskSignalClear( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+#if ( OS_SELECT_ON!=0 )
+uOSBool_t    OSTaskSignalIsPending( OSTaskHandle_t const TaskHandle ) TINIUX_FUNCTION;
+#endif /* OS_SELECT_ON */
 #endif
 
 #ifdef __cplusplus
@@ -41,67 +41,92 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-#if ( OS_MSGQ_ON!=0 )
 #if ( OS_TIMER_ON!=0 )
 
-TINIUX_DATA static sOSBase_t const TMCMD_MSGQ_NO_DELAY          = ( ( sOSBase_t ) 0 );
-TINIUX_DATA static sOSBase_t const TMCMD_MSGQ_LENGTH            = ( ( sOSBase_t ) 8 );
-
+TINIUX_DATA static sOSBase_t const TMCMD_NONE                   = ( ( sOSBase_t ) 0 );
 TINIUX_DATA static sOSBase_t const TMCMD_START                  = ( ( sOSBase_t ) 1 );
-TINIUX_DATA static sOSBase_t const TMCMD_RESET                  = ( ( sOSBase_t ) 2 );
-TINIUX_DATA static sOSBase_t const TMCMD_STOP                   = ( ( sOSBase_t ) 3 );
-TINIUX_DATA static sOSBase_t const TMCMD_CHANGE_PERIOD          = ( ( sOSBase_t ) 4 );
+TINIUX_DATA static sOSBase_t const TMCMD_STOP                   = ( ( sOSBase_t ) 2 );
+TINIUX_DATA static sOSBase_t const TMCMD_CHANGE_PERIOD          = ( ( sOSBase_t ) 3 );
 
 #if ( OS_MEMFREE_ON != 0 )
-TINIUX_DATA static sOSBase_t const TMCMD_DELETE                 = ( ( sOSBase_t ) 5 );
+TINIUX_DATA static sOSBase_t const TMCMD_DELETE                 = ( ( sOSBase_t ) 4 );
 #endif /* OS_MEMFREE_ON */
 
-TINIUX_DATA static sOSBase_t const TMCMD_FIRST_FROM_ISR_TYPE    = ( ( sOSBase_t ) 6 );
-TINIUX_DATA static sOSBase_t const TMCMD_START_FROM_ISR         = ( ( sOSBase_t ) 6 );
-TINIUX_DATA static sOSBase_t const TMCMD_RESET_FROM_ISR         = ( ( sOSBase_t ) 7 );
-TINIUX_DATA static sOSBase_t const TMCMD_STOP_FROM_ISR          = ( ( sOSBase_t ) 8 );
-TINIUX_DATA static sOSBase_t const TMCMD_CHANGE_PERIOD_FROM_ISR = ( ( sOSBase_t ) 9 );
+/* Each FromISR command is its task counterpart plus this offset. */
+TINIUX_DATA static sOSBase_t const TMCMD_FIRST_FROM_ISR_TYPE    = ( ( sOSBase_t ) 5 );
+TINIUX_DATA static sOSBase_t const TMCMD_START_FROM_ISR         = ( ( sOSBase_t ) 5 );
+TINIUX_DATA static sOSBase_t const TMCMD_STOP_FROM_ISR          = ( ( sOSBase_t ) 6 );
+TINIUX_DATA static sOSBase_t const TMCMD_CHANGE_PERIOD_FROM_ISR = ( ( sOSBase_t ) 7 );
 
 #if ( OS_MEMFREE_ON != 0 )
-TINIUX_DATA static sOSBase_t const TMCMD_DELETE_FROM_ISR        = ( ( sOSBase_t ) 10 );
+TINIUX_DATA static sOSBase_t const TMCMD_DELETE_FROM_ISR        = ( ( sOSBase_t ) 8 );
 #endif /* OS_MEMFREE_ON */
 
-TINIUX_DATA static tOSList_t         gtOSTimerList1;
-TINIUX_DATA static tOSList_t         gtOSTimerList2;
-TINIUX_DATA static tOSList_t *        gptOSTimerList            = OS_NULL;
-TINIUX_DATA static tOSList_t *        gptOSOFTimerList          = OS_NULL;
+TINIUX_DATA static tOSList_t         gtOSTimerWheelSlots[ OSTIMER_WHEEL_SIZE ];
+TINIUX_DATA static tOSListWheel_t    gtOSTimerWheel;
+TINIUX_DATA static uOSTick_t         guxOSTimerLastTime         = ( uOSTick_t ) 0U;
+
+/* The earliest expiry time of the wheel, kept up to date as timers are
+added and looked up again only once the monitor task has passed it. */
+TINIUX_DATA static uOSTick_t         guxOSTimerNextTime         = ( uOSTick_t ) 0U;
+TINIUX_DATA static uOSBool_t         gbOSTimerNextTimeValid     = OS_FALSE;
+TINIUX_DATA static uOSBool_t         gbOSTimerWheelEmpty        = OS_FALSE;
+
+#if ( OS_HARD_TIMER_ON!=0 )
+TINIUX_DATA static tOSList_t         gtOSHardTimerWheelSlots[ OSTIMER_WHEEL_SIZE ];
+TINIUX_DATA static tOSListWheel_t    gtOSHardTimerWheel;
+TINIUX_DATA static volatile uOSTick_t guxOSHardTimerTime        = ( uOSTick_t ) 0U;
+#if ( OS_LOWPOWER_ON!=0 )
+/* The earliest hard timer expiry for the tickless idle, kept up to date as
+hard timers are added and looked up again only after the tick has reached it. */
+TINIUX_DATA static volatile uOSTick_t guxOSHardTimerNextTime    = ( uOSTick_t ) 0U;
+TINIUX_DATA static volatile uOSBool_t gbOSHardTimerNextTimeValid = OS_FALSE;
+#endif /* OS_LOWPOWER_ON */
+/* The hard timers due on the current tick, taken off the wheel before their
+callbacks run. */
+TINIUX_DATA static tOSList_t         gtOSHardTimerDueList;
+#endif /* OS_HARD_TIMER_ON */
+
+/* Timers with a pending command are queued here once each, in the order
+their first command was sent, for the monitor task to drain. */
+TINIUX_DATA static tOSTimer_t *      gptOSTimerCmdHead          = OS_NULL;
+TINIUX_DATA static tOSTimer_t *      gptOSTimerCmdTail          = OS_NULL;
+TINIUX_DATA static tOSList_t         gtOSTimerCmdEventList;
 
-TINIUX_DATA static OSMsgQHandle_t     gOSTimerCmdMsgQHandle     = OS_NULL;
 TINIUX_DATA static OSTaskHandle_t    gOSTimerMoniteTaskHandle   = OS_NULL;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+TINIUX_DATA static tOSTCB_t          gtOSTimerMoniteTCB;
+TINIUX_DATA static uOSStack_t        guxOSTimerMoniteStack[ OSMINIMAL_STACK_SIZE ];
+#endif /* OS_STATIC_ALLOC_ON */
 
 uOSBase_t OSTimerInit( void )
 {
-    gptOSTimerList               = OS_NULL;
-    gptOSOFTimerList             = OS_NULL;
+    OSListWheelInit( &gtOSTimerWheel, gtOSTimerWheelSlots, OSTIMER_WHEEL_SIZE );
+    guxOSTimerLastTime           = ( uOSTick_t ) 0U;
+    guxOSTimerNextTime           = ( uOSTick_t ) 0U;
+    gbOSTimerNextTimeValid       = OS_FALSE;
+    gbOSTimerWheelEmpty          = OS_FALSE;
+
+    gptOSTimerCmdHead            = OS_NULL;
+    gptOSTimerCmdTail            = OS_NULL;
+    OSListInit( &gtOSTimerCmdEventList );
 
-    gOSTimerCmdMsgQHandle        = OS_NULL;
     gOSTimerMoniteTaskHandle     = OS_NULL;
+
+#if ( OS_HARD_TIMER_ON!=0 )
+    /* The tick interrupt looks at the hard timers from the start. */
+    OSListWheelInit( &gtOSHardTimerWheel, gtOSHardTimerWheelSlots, OSTIMER_WHEEL_SIZE );
+    OSListInit( &gtOSHardTimerDueList );
+    guxOSHardTimerTime           = ( uOSTick_t ) 0U;
+#if ( OS_LOWPOWER_ON!=0 )
+    guxOSHardTimerNextTime       = ( uOSTick_t ) 0U;
+    gbOSHardTimerNextTimeValid   = OS_FALSE;
+#endif /* OS_LOWPOWER_ON */
+#endif /* OS_HARD_TIMER_ON */
     
     return 0U;
 }
 
-static void OSTimerInitListsAndCmdMsgQ( void )
-{
-    OSIntLock();
-    {
-        if( gOSTimerCmdMsgQHandle == OS_NULL )
-        {
-            OSListInit( &gtOSTimerList1 );
-            OSListInit( &gtOSTimerList2 );
-            gptOSTimerList = &gtOSTimerList1;
-            gptOSOFTimerList = &gtOSTimerList2;
-
-            gOSTimerCmdMsgQHandle = OSMsgQCreate(TMCMD_MSGQ_LENGTH, sizeof(tOSTimerCmdMsg_t));
-        }
-    }
-    OSIntUnlock();
-}
-
 static void OSTimerInitTCB( OSTimerHandle_t NewTimerHandle,
                             const uOSBase_t uxTimerTicks, 
                             const uOS16_t   uiIsPeriod, 
@@ -113,11 +138,6 @@ static void OSTimerInitTCB( OSTimerHandle_t NewTimerHandle,
     
     if( NewTimerHandle != OS_NULL )
     {
-        if( gOSTimerCmdMsgQHandle==OS_NULL )
-        {
-            OSTimerInitListsAndCmdMsgQ();
-        }
-
         for( x = ( uOSBase_t ) 0; x < ( uOSBase_t ) OSNAME_MAX_LEN; x++ )
         {
             NewTimerHandle->pcTimerName[ x ] = pcName[ x ];
@@ -140,6 +160,13 @@ static void OSTimerInitTCB( OSTimerHandle_t NewTimerHandle,
         NewTimerHandle->uxTimerTicks     = uxTimerTicks;
         NewTimerHandle->pxTimerFunction  = Function;
         NewTimerHandle->pvParameter      = pvParameter;
+        NewTimerHandle->ptCmdNext        = OS_NULL;
+        NewTimerHandle->xCmdType         = TMCMD_NONE;
+        NewTimerHandle->uxCmdTicks       = ( uOSTick_t ) 0U;
+        NewTimerHandle->uxCmdPeriod      = ( uOSTick_t ) 0U;
+#if ( OS_HARD_TIMER_ON!=0 )
+        NewTimerHandle->bHard            = OS_FALSE;
+#endif /* OS_HARD_TIMER_ON */
 
         OSListItemInitialise( &( NewTimerHandle->tTimerListItem ) );
     }
@@ -157,283 +184,531 @@ OSTimerHandle_t OSTimerCreate(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPe
     if (TimerHandle != OS_NULL) 
     {
         OSTimerInitTCB( TimerHandle, uxTimerTicks, uiIsPeriod, Function, pvParameter, pcName);
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        TimerHandle->ucStaticAlloc = OS_FALSE;
+#endif /* OS_STATIC_ALLOC_ON */
     }    
 
     return TimerHandle;
 }
 
-uOSBool_t OSTimerSendCmdMsg( OSTimerHandle_t xTimer, const sOSBase_t xCmdMsgType, const uOSTick_t xOptionalValue, const uOSTick_t uxTicksToWait )
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTimerHandle_t OSTimerCreateStatic(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName, tOSTimer_t * const ptTimerBuffer)
 {
-    uOSBool_t bReturn = OS_FALSE;
-    tOSTimerCmdMsg_t tCmdMsg;
+    if((uxTimerTicks == (uOSTick_t)0U) || (ptTimerBuffer == OS_NULL))
+    {
+        return OS_NULL;
+    }
+
+    OSTimerInitTCB( ptTimerBuffer, uxTimerTicks, uiIsPeriod, Function, pvParameter, pcName);
+    ptTimerBuffer->ucStaticAlloc = OS_TRUE;
+
+    return ptTimerBuffer;
+}
+#endif /* OS_STATIC_ALLOC_ON */
+
+#if ( OS_HARD_TIMER_ON!=0 )
+OSTimerHandle_t OSTimerCreateHard(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName)
+{
+    OSTimerHandle_t TimerHandle = OSTimerCreate( uxTimerTicks, uiIsPeriod, Function, pvParameter, pcName );
 
-    if( gOSTimerCmdMsgQHandle != OS_NULL )
+    if (TimerHandle != OS_NULL) 
     {
-        tCmdMsg.xCmdMsgType     = xCmdMsgType;
-        tCmdMsg.uxTicks         = xOptionalValue;
-        tCmdMsg.ptTimer         = ( tOSTimer_t * ) xTimer;
+        TimerHandle->bHard = OS_TRUE;
+    }
 
-        if( xCmdMsgType < TMCMD_FIRST_FROM_ISR_TYPE )
-        {
-            if( OSScheduleGetState() == SCHEDULER_RUNNING )
-            {
-                bReturn = OSMsgQSend( gOSTimerCmdMsgQHandle, &tCmdMsg, uxTicksToWait );
-            }
-            else
-            {
-                bReturn = OSMsgQSend( gOSTimerCmdMsgQHandle, &tCmdMsg, TMCMD_MSGQ_NO_DELAY );
-            }
-        }
-        else
-        {
-            bReturn = OSMsgQSendFromISR( gOSTimerCmdMsgQHandle, &tCmdMsg );
-        }
+    return TimerHandle;
+}
+
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTimerHandle_t OSTimerCreateHardStatic(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName, tOSTimer_t * const ptTimerBuffer)
+{
+    OSTimerHandle_t TimerHandle = OSTimerCreateStatic( uxTimerTicks, uiIsPeriod, Function, pvParameter, pcName, ptTimerBuffer );
+
+    if (TimerHandle != OS_NULL) 
+    {
+        TimerHandle->bHard = OS_TRUE;
     }
 
-    return bReturn;
+    return TimerHandle;
 }
+#endif /* OS_STATIC_ALLOC_ON */
 
-static void OSTimerListSwitch( void )
+static void OSTimerHardAddToWheel( tOSTimer_t * const ptTimer, const uOSTick_t uxNextExpiryTime )
+{
+#if ( OS_LOWPOWER_ON!=0 )
+    const uOSTick_t uxTimeNow = guxOSHardTimerTime;
+#endif /* OS_LOWPOWER_ON */
+
+    OSListItemSetValue( &( ptTimer->tTimerListItem ), uxNextExpiryTime );
+    OSListItemSetHolder( &( ptTimer->tTimerListItem ), ptTimer );
+
+    OSListWheelInsertItem( &gtOSHardTimerWheel, &( ptTimer->tTimerListItem ) );
+
+#if ( OS_LOWPOWER_ON!=0 )
+    if( ( gbOSHardTimerNextTimeValid != OS_FALSE ) &&
+        ( ( uOSTick_t ) ( uxNextExpiryTime - uxTimeNow ) < ( uOSTick_t ) ( guxOSHardTimerNextTime - uxTimeNow ) ) )
+    {
+        guxOSHardTimerNextTime = uxNextExpiryTime;
+    }
+#endif /* OS_LOWPOWER_ON */
+}
+
+/* Apply a command to a hard timer in place, return OS_TRUE if the monitor
+task still has to see it. */
+static uOSBool_t OSTimerHardCmd( tOSTimer_t * const ptTimer, const sOSBase_t xCmdType, const uOSTick_t xOptionalValue, const uOSBool_t bFromISR )
 {
-    uOSTick_t uxNextExpireTime =(uOSTick_t)0U, xReloadTime = (uOSTick_t)0U;
-    tOSList_t *pxTempList = OS_NULL;
-    tOSTimer_t *ptTimer = OS_NULL;
     uOSBool_t bReturn = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
 
-    while( OSListIsEmpty( gptOSTimerList ) == OS_FALSE )
+    if( bFromISR == OS_FALSE )
     {
-        uxNextExpireTime = OSlistGetHeadItemValue( gptOSTimerList );
+        OSIntLock();
+    }
+    else
+    {
+        uxIntSave = OSIntMaskFromISR();
+    }
 
-        ptTimer = ( tOSTimer_t * ) OSListGetHeadItemHolder( gptOSTimerList );
+    if( OSListContainListItem( OS_NULL, &( ptTimer->tTimerListItem ) ) == OS_FALSE )
+    {
         ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+    }
 
-        ptTimer->pxTimerFunction( ptTimer->pvParameter );
+    if( xCmdType==TMCMD_START )
+    {
+        OSTimerHardAddToWheel( ptTimer, ( uOSTick_t ) ( guxOSHardTimerTime + ptTimer->uxTimerTicks ) );
+    }
+    else if( xCmdType==TMCMD_CHANGE_PERIOD )
+    {
+        ptTimer->uxTimerTicks = xOptionalValue;
 
-        if( ptTimer->bPeriod == ( sOSBase_t ) OS_TRUE )
-        {
-            xReloadTime = ( uxNextExpireTime + ptTimer->uxTimerTicks );
-            if( xReloadTime > uxNextExpireTime )
-            {
-                OSListItemSetValue( &( ptTimer->tTimerListItem ), xReloadTime );
-                OSListItemSetHolder( &( ptTimer->tTimerListItem ), ptTimer );
-                OSListInsertItem( gptOSTimerList, &( ptTimer->tTimerListItem ) );
-            }
-            else
-            {
-                bReturn = OSTimerSendCmdMsg( ptTimer, TMCMD_START, uxNextExpireTime, TMCMD_MSGQ_NO_DELAY );
-                ( void ) bReturn;
-            }
-        }
+        OSTimerHardAddToWheel( ptTimer, ( uOSTick_t ) ( guxOSHardTimerTime + ptTimer->uxTimerTicks ) );
+    }
+    #if ( OS_MEMFREE_ON != 0 )
+    else if( xCmdType==TMCMD_DELETE )
+    {/* The memory is freed by the monitor task. */
+        bReturn = OS_TRUE;
+    }
+    #endif /* OS_MEMFREE_ON */
+
+    if( bFromISR == OS_FALSE )
+    {
+        OSIntUnlock();
+    }
+    else
+    {
+        OSIntUnmaskFromISR( uxIntSave );
     }
 
-    pxTempList = gptOSTimerList;
-    gptOSTimerList = gptOSOFTimerList;
-    gptOSOFTimerList = pxTempList;
+    return bReturn;
 }
 
-static uOSTick_t OSTimerGetCurTime( uOSBool_t * const pbTimerListsSwitched )
+void OSTimerHardTick( void )
 {
-    uOSTick_t uxTimeNow = ( uOSTick_t ) 0U;
-    TINIUX_DATA static uOSTick_t uxLastTime = ( uOSTick_t ) 0U; 
+    tOSList_t *ptSlot = OS_NULL;
+    tOSListItem_t *ptIterator = OS_NULL;
+    tOSTimer_t *ptTimer = OS_NULL;
+    const uOSTick_t uxTimeNow = guxOSHardTimerTime + (uOSTick_t)1U;
 
-    uxTimeNow = OSGetTickCount();
+    /* Hard timers count every tick, even the ones held back while the
+    scheduler is locked. */
+    guxOSHardTimerTime = uxTimeNow;
 
-    if( uxTimeNow < uxLastTime )
+#if ( OS_LOWPOWER_ON!=0 )
+    if( uxTimeNow == guxOSHardTimerNextTime )
     {
-        OSTimerListSwitch();
-        *pbTimerListsSwitched = OS_TRUE;
+        /* Looked up again when the tickless idle next asks for it. */
+        gbOSHardTimerNextTimeValid = OS_FALSE;
     }
-    else
+#endif /* OS_LOWPOWER_ON */
+
+    /* Only the slot of this tick can hold the timers due now, so move them
+    off it in one walk.  A callback may start or stop any timer, so the due
+    ones are taken from the head of their own list, a timer stopped by an
+    earlier callback has left it. */
+    ptSlot = OSListWheelGetSlot( &gtOSHardTimerWheel, uxTimeNow );
+    ptIterator = OSListGetHeadItem( ptSlot );
+    while( ptIterator != OSListGetEndMarkerItem( ptSlot ) )
     {
-        *pbTimerListsSwitched = OS_FALSE;
+        ptTimer = ( tOSTimer_t * ) OSListItemGetHolder( ptIterator );
+        ptIterator = OSListItemGetNextItem( ptIterator );
+
+        if( OSListItemGetValue( &( ptTimer->tTimerListItem ) ) == uxTimeNow )
+        {
+            ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+            OSListInsertItemToEnd( &gtOSHardTimerDueList, &( ptTimer->tTimerListItem ) );
+        }
     }
 
-    uxLastTime = uxTimeNow;
+    while( OSListIsEmpty( &gtOSHardTimerDueList ) == OS_FALSE )
+    {
+        ptTimer = ( tOSTimer_t * ) OSListGetHeadItemHolder( &gtOSHardTimerDueList );
+        ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
 
-    return uxTimeNow;
+        if( ptTimer->bPeriod == ( sOSBase_t ) OS_TRUE )
+        {
+            OSTimerHardAddToWheel( ptTimer, ( uOSTick_t ) ( uxTimeNow + ptTimer->uxTimerTicks ) );
+        }
+
+        ptTimer->pxTimerFunction( ptTimer->pvParameter );
+    }
 }
 
-static uOSBool_t OSTimerAddToList( tOSTimer_t * const ptTimer, const uOSTick_t uxNextExpiryTime, const uOSTick_t uxTimeNow, const uOSTick_t uxCommandTime )
+#if ( OS_LOWPOWER_ON!=0 )
+/* Ticks until the next hard timer expiry, must be called with the interrupts
+locked or masked. */
+uOSTick_t OSTimerHardNextDelta( void )
 {
-    uOSBool_t bProcessTimerNow = OS_FALSE;
+    if( gbOSHardTimerNextTimeValid == OS_FALSE )
+    {
+        guxOSHardTimerNextTime = guxOSHardTimerTime + OSListWheelGetNextDelta( &gtOSHardTimerWheel, guxOSHardTimerTime );
+        gbOSHardTimerNextTimeValid = OS_TRUE;
+    }
 
-    OSListItemSetValue( &( ptTimer->tTimerListItem ), uxNextExpiryTime );
-    OSListItemSetHolder( &( ptTimer->tTimerListItem ), ptTimer );
+    return ( uOSTick_t ) ( guxOSHardTimerNextTime - guxOSHardTimerTime );
+}
+
+void OSTimerHardFixTime( const uOSTick_t uxTicksToFix )
+{
+    guxOSHardTimerTime += uxTicksToFix;
+}
+#endif /* OS_LOWPOWER_ON */
+#endif /* OS_HARD_TIMER_ON */
+
+static uOSBool_t OSTimerSendCmd( OSTimerHandle_t xTimer, sOSBase_t xCmdType, const uOSTick_t xOptionalValue )
+{
+    uOSBool_t bFromISR = OS_FALSE;
+    uOSBool_t bNeedSchedule = OS_FALSE;
+    uOSBase_t uxIntSave = (uOSBase_t)0U;
+
+    if( xTimer == OS_NULL )
+    {
+        return OS_FALSE;
+    }
+
+    if( xCmdType >= TMCMD_FIRST_FROM_ISR_TYPE )
+    {
+        bFromISR = OS_TRUE;
+        xCmdType -= ( sOSBase_t ) ( TMCMD_FIRST_FROM_ISR_TYPE - TMCMD_START );
+    }
+
+#if ( OS_HARD_TIMER_ON!=0 )
+    if( xTimer->bHard != OS_FALSE )
+    {
+        /* Hard timers do not wait for the monitor task. */
+        if( OSTimerHardCmd( xTimer, xCmdType, xOptionalValue, bFromISR ) == OS_FALSE )
+        {
+            return OS_TRUE;
+        }
+    }
+#endif /* OS_HARD_TIMER_ON */
+
+    if( bFromISR != OS_FALSE )
+    {
+        uxIntSave = OSIntMaskFromISR();
+    }
+    else
+    {
+        OSIntLock();
+    }
 
-    if( uxNextExpiryTime <= uxTimeNow )
+    /* A timer is queued only once, the commands sent to it before the
+    monitor task gets to it are merged into the pending one, so sending a
+    command never fails and never waits. */
+    if( xTimer->xCmdType == TMCMD_NONE )
     {
-        if( ( ( uOSTick_t ) ( uxTimeNow - uxCommandTime ) ) >= ptTimer->uxTimerTicks ) 
+        xTimer->ptCmdNext = OS_NULL;
+        if( gptOSTimerCmdTail == OS_NULL )
         {
-            bProcessTimerNow = OS_TRUE;
+            gptOSTimerCmdHead = xTimer;
         }
         else
         {
-            OSListInsertItem( gptOSOFTimerList, &( ptTimer->tTimerListItem ) );
+            gptOSTimerCmdTail->ptCmdNext = xTimer;
         }
+        gptOSTimerCmdTail = xTimer;
     }
-    else
+
+#if ( OS_MEMFREE_ON != 0 )
+    if( xTimer->xCmdType != TMCMD_DELETE )
+#endif /* OS_MEMFREE_ON */
     {
-        if( ( uxTimeNow < uxCommandTime ) && ( uxNextExpiryTime >= uxCommandTime ) )
+        if( xCmdType == TMCMD_CHANGE_PERIOD )
         {
-            bProcessTimerNow = OS_TRUE;
+            xTimer->uxCmdPeriod = xOptionalValue;
         }
-        else
+        else if( xCmdType == TMCMD_START )
         {
-            OSListInsertItem( gptOSTimerList, &( ptTimer->tTimerListItem ) );
+            xTimer->uxCmdTicks = xOptionalValue;
         }
+        xTimer->xCmdType = xCmdType;
     }
 
-    return bProcessTimerNow;
+    if( OSListIsEmpty( &gtOSTimerCmdEventList ) == OS_FALSE )
+    {
+        bNeedSchedule = OSTaskListEventRemove( &gtOSTimerCmdEventList );
+    }
+
+    if( bFromISR != OS_FALSE )
+    {
+        OSIntUnmaskFromISR( uxIntSave );
+
+        if(SCHEDULER_RUNNING == OSScheduleGetState())
+        {
+            OSScheduleFromISR( bNeedSchedule );
+        }
+    }
+    else
+    {
+        if( bNeedSchedule != OS_FALSE )
+        {
+            OSSchedule();
+        }
+        OSIntUnlock();
+    }
+
+    return OS_TRUE;
 }
 
-static void OSTimerExpiredProcess( const uOSTick_t uxNextExpireTime, const uOSTick_t uxTimeNow )
+/* Look the next expiry time up again, the walk starts at the tick after the
+last processed one and stops at the first slot with a timer due then. */
+static void OSTimerUpdateNextTime( void )
 {
-    uOSBool_t bReturn = OS_FALSE;
-    tOSTimer_t * const ptTimer = ( tOSTimer_t * ) OSListGetHeadItemHolder( gptOSTimerList );
+    const uOSTick_t uxNextDelta = OSListWheelGetNextDelta( &gtOSTimerWheel, ( uOSTick_t ) ( guxOSTimerLastTime + 1U ) );
+
+    gbOSTimerWheelEmpty = ( uOSBool_t ) ( uxNextDelta == OSPEND_FOREVER_VALUE );
+    guxOSTimerNextTime = ( uOSTick_t ) ( guxOSTimerLastTime + 1U + uxNextDelta );
+    gbOSTimerNextTimeValid = OS_TRUE;
+}
+
+static void OSTimerAddToWheel( tOSTimer_t * const ptTimer, const uOSTick_t uxNextExpiryTime )
+{
+    OSListItemSetValue( &( ptTimer->tTimerListItem ), uxNextExpiryTime );
+    OSListItemSetHolder( &( ptTimer->tTimerListItem ), ptTimer );
 
-    ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+    OSListWheelInsertItem( &gtOSTimerWheel, &( ptTimer->tTimerListItem ) );
 
-    if( ptTimer->bPeriod == ( sOSBase_t ) OS_TRUE )
+    /* Removing a timer leaves the next expiry time early, which only costs
+    a look at a slot with nothing due. */
+    if( gbOSTimerNextTimeValid != OS_FALSE )
     {
-        if( OSTimerAddToList( ptTimer, ( uxNextExpireTime + ptTimer->uxTimerTicks ), uxTimeNow, uxNextExpireTime ) != OS_FALSE )
+        if( ( gbOSTimerWheelEmpty != OS_FALSE ) ||
+            ( ( uOSTick_t ) ( uxNextExpiryTime - guxOSTimerLastTime ) < ( uOSTick_t ) ( guxOSTimerNextTime - guxOSTimerLastTime ) ) )
         {
-            bReturn = OSTimerSendCmdMsg( ptTimer, TMCMD_START, uxNextExpireTime, TMCMD_MSGQ_NO_DELAY );
-            ( void ) bReturn;
+            guxOSTimerNextTime = uxNextExpiryTime;
+            gbOSTimerWheelEmpty = OS_FALSE;
         }
     }
+}
 
-    ptTimer->pxTimerFunction( ptTimer->pvParameter );
+static void OSTimerActivate( tOSTimer_t * const ptTimer, uOSTick_t uxCommandTime, const uOSTick_t uxTimeNow )
+{
+    /* The command may have been pending longer than the timer period, run
+    the callback for every period that has already passed. */
+    while( ( ( uOSTick_t ) ( uxTimeNow - uxCommandTime ) ) >= ptTimer->uxTimerTicks )
+    {
+        ptTimer->pxTimerFunction( ptTimer->pvParameter );
+
+        if( ptTimer->bPeriod != ( sOSBase_t ) OS_TRUE )
+        {
+            return;
+        }
+        uxCommandTime += ptTimer->uxTimerTicks;
+    }
+
+    OSTimerAddToWheel( ptTimer, ( uOSTick_t ) ( uxCommandTime + ptTimer->uxTimerTicks ) );
 }
 
-static void OSTimerProcessOrBlock( const uOSTick_t uxNextExpireTime, uOSBool_t bListWasEmpty )
+static void OSTimerExpiredProcess( const uOSTick_t uxTimeNow )
 {
-    uOSTick_t uxTimeNow = (uOSTick_t)0U;
-    uOSBool_t bTimerListsSwitched = OS_FALSE;
+    tOSList_t *ptSlot = OS_NULL;
+    tOSListItem_t *ptIterator = OS_NULL;
+    tOSTimer_t *ptTimer = OS_NULL;
 
-    OSScheduleLock();
+    while( guxOSTimerLastTime != uxTimeNow )
     {
-        uxTimeNow = OSTimerGetCurTime( &bTimerListsSwitched );
-        if( bTimerListsSwitched == OS_FALSE )
+        /* Over a whole turn or more, stepping would visit some slots more
+        than once, so the wheel is only searched in that case. */
+        if( ( gbOSTimerNextTimeValid == OS_FALSE ) && ( ( uOSTick_t ) ( uxTimeNow - guxOSTimerLastTime ) >= ( uOSTick_t ) OSTIMER_WHEEL_SIZE ) )
         {
-            if( ( bListWasEmpty == OS_FALSE ) && ( uxNextExpireTime <= uxTimeNow ) )
+            OSTimerUpdateNextTime();
+        }
+
+        if( gbOSTimerNextTimeValid != OS_FALSE )
+        {
+            /* Jump straight to the next expiry, the ticks before it have
+            nothing due. */
+            if( ( gbOSTimerWheelEmpty != OS_FALSE ) ||
+                ( ( uOSTick_t ) ( guxOSTimerNextTime - guxOSTimerLastTime ) > ( uOSTick_t ) ( uxTimeNow - guxOSTimerLastTime ) ) )
             {
-                ( void ) OSScheduleUnlock();
-                OSTimerExpiredProcess( uxNextExpireTime, uxTimeNow );
+                guxOSTimerLastTime = uxTimeNow;
+                break;
             }
-            else
-            {
-                if( bListWasEmpty != OS_FALSE )
-                {
-                    bListWasEmpty = OSListIsEmpty( gptOSOFTimerList );
-                }
+            guxOSTimerLastTime = guxOSTimerNextTime;
 
-                OSMsgQWait( gOSTimerCmdMsgQHandle, ( uxNextExpireTime - uxTimeNow ), bListWasEmpty );
+            /* Its slot is processed now, the expiry after it is only looked
+            up when the monitor task has to block. */
+            gbOSTimerNextTimeValid = OS_FALSE;
+        }
+        else
+        {
+            /* Otherwise step to the next slot, an empty one costs a single
+            test. */
+            guxOSTimerLastTime++;
+        }
 
-                if( OSScheduleUnlock() == OS_FALSE )
+        ptSlot = OSListWheelGetSlot( &gtOSTimerWheel, guxOSTimerLastTime );
+        ptIterator = OSListGetHeadItem( ptSlot );
+        while( ptIterator != OSListGetEndMarkerItem( ptSlot ) )
+        {
+            ptTimer = ( tOSTimer_t * ) OSListItemGetHolder( ptIterator );
+            ptIterator = OSListItemGetNextItem( ptIterator );
+
+            if( OSListItemGetValue( &( ptTimer->tTimerListItem ) ) == guxOSTimerLastTime )
+            {
+                ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+
+                if( ptTimer->bPeriod == ( sOSBase_t ) OS_TRUE )
                 {
-                    OSSchedule();
+                    OSTimerAddToWheel( ptTimer, ( uOSTick_t ) ( guxOSTimerLastTime + ptTimer->uxTimerTicks ) );
                 }
+
+                ptTimer->pxTimerFunction( ptTimer->pvParameter );
             }
         }
-        else
-        {
-            ( void ) OSScheduleUnlock();
-        }
     }
 }
 
-static uOSTick_t OSTimerGetNextExpireTime( uOSBool_t * const pbListWasEmpty )
+static void OSTimerWaitForExpiry( void )
 {
-    uOSTick_t uxNextExpireTime = (uOSTick_t)0U;
+    uOSTick_t uxTimeNow = (uOSTick_t)0U;
+    uOSBool_t bWheelWasEmpty = OS_FALSE;
 
-    *pbListWasEmpty = OSListIsEmpty( gptOSTimerList );
-    if( *pbListWasEmpty == OS_FALSE )
+    OSScheduleLock();
     {
-        uxNextExpireTime = OSlistGetHeadItemValue( gptOSTimerList );
+        uxTimeNow = OSGetTickCount();
+        if( gbOSTimerNextTimeValid == OS_FALSE )
+        {
+            OSTimerUpdateNextTime();
+        }
+        bWheelWasEmpty = gbOSTimerWheelEmpty;
+
+        /* The check and the block are done with the interrupts locked, so a
+        command sent from an interrupt in between always wakes this task. */
+        OSIntLock();
+        if( gptOSTimerCmdHead == OS_NULL )
+        {
+            if( bWheelWasEmpty != OS_FALSE )
+            {
+                OSTaskBlockAndPend( &gtOSTimerCmdEventList, OSPEND_FOREVER_VALUE, OS_TRUE );
+            }
+            else if( ( uOSTick_t ) ( guxOSTimerNextTime - guxOSTimerLastTime ) > ( uOSTick_t ) ( uxTimeNow - guxOSTimerLastTime ) )
+            {
+                OSTaskBlockAndPend( &gtOSTimerCmdEventList, ( uOSTick_t ) ( guxOSTimerNextTime - uxTimeNow ), OS_FALSE );
+            }
+        }
+        OSIntUnlock();
+
+        if( OSScheduleUnlock() == OS_FALSE )
+        {
+            OSSchedule();
+        }
     }
-    else
+
+    /* Nothing was armed, so no tick has been missed while waiting. */
+    if( bWheelWasEmpty != OS_FALSE )
     {
-        uxNextExpireTime = ( uOSTick_t ) 0U;
+        guxOSTimerLastTime = OSGetTickCount();
     }
-
-    return uxNextExpireTime;
 }
 
-static void OSTimerReceiveCmdMsg( void )
+static void OSTimerReceiveCmd( void )
 {
-    tOSTimerCmdMsg_t tCmdMsg;
     tOSTimer_t *ptTimer = OS_NULL;
-    uOSBool_t bTimerListsSwitched = OS_FALSE;
-    uOSBool_t bReturn = OS_FALSE;
+    sOSBase_t xCmdType = TMCMD_NONE;
+    uOSTick_t uxCmdTicks = (uOSTick_t)0U;
+    uOSTick_t uxCmdPeriod = (uOSTick_t)0U;
     uOSTick_t uxTimeNow = (uOSTick_t)0U;
 
-    while( OSMsgQReceive( gOSTimerCmdMsgQHandle, &tCmdMsg, TMCMD_MSGQ_NO_DELAY ) != OS_FALSE ) 
+    /* Drain every pending command, the interrupts are only locked while one
+    timer is taken off the list. */
+    for( ;; )
     {
-
-        if( tCmdMsg.xCmdMsgType >= ( sOSBase_t ) 0 )
+        OSIntLock();
         {
-            ptTimer = tCmdMsg.ptTimer;
-
-            if( OSListContainListItem( OS_NULL, &( ptTimer->tTimerListItem ) ) == OS_FALSE )
+            ptTimer = gptOSTimerCmdHead;
+            if( ptTimer != OS_NULL )
             {
-                ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+                gptOSTimerCmdHead = ptTimer->ptCmdNext;
+                if( gptOSTimerCmdHead == OS_NULL )
+                {
+                    gptOSTimerCmdTail = OS_NULL;
+                }
+
+                xCmdType = ptTimer->xCmdType;
+                uxCmdTicks = ptTimer->uxCmdTicks;
+                uxCmdPeriod = ptTimer->uxCmdPeriod;
+                ptTimer->xCmdType = TMCMD_NONE;
+                ptTimer->uxCmdPeriod = ( uOSTick_t ) 0U;
             }
+        }
+        OSIntUnlock();
 
-            uxTimeNow = OSTimerGetCurTime( &bTimerListsSwitched );
+        if( ptTimer == OS_NULL )
+        {
+            break;
+        }
 
-            if( tCmdMsg.xCmdMsgType==TMCMD_START || tCmdMsg.xCmdMsgType==TMCMD_START_FROM_ISR ||
-                tCmdMsg.xCmdMsgType==TMCMD_RESET || tCmdMsg.xCmdMsgType==TMCMD_RESET_FROM_ISR )
-            {
-                if( OSTimerAddToList( ptTimer,  tCmdMsg.uxTicks + ptTimer->uxTimerTicks, uxTimeNow, tCmdMsg.uxTicks ) != OS_FALSE )
-                {
-                    ptTimer->pxTimerFunction( ptTimer->pvParameter );
+        if( OSListContainListItem( OS_NULL, &( ptTimer->tTimerListItem ) ) == OS_FALSE )
+        {
+            ( void ) OSListRemoveItem( &( ptTimer->tTimerListItem ) );
+        }
 
-                    if( ptTimer->bPeriod == ( sOSBase_t ) OS_TRUE )
-                    {
-                        bReturn = OSTimerSendCmdMsg( ptTimer, TMCMD_START, tCmdMsg.uxTicks + ptTimer->uxTimerTicks, TMCMD_MSGQ_NO_DELAY );
-                        ( void ) bReturn;
-                    }
-                }
-            }
-            else if( tCmdMsg.xCmdMsgType==TMCMD_STOP || tCmdMsg.xCmdMsgType==TMCMD_STOP_FROM_ISR)
-            {/* The timer has already been removed from the active list. */
-            }
-            else if( tCmdMsg.xCmdMsgType==TMCMD_CHANGE_PERIOD || tCmdMsg.xCmdMsgType==TMCMD_CHANGE_PERIOD_FROM_ISR)
-            {
-                ptTimer->uxTimerTicks = tCmdMsg.uxTicks;
+        if( uxCmdPeriod != ( uOSTick_t ) 0U )
+        {
+            ptTimer->uxTimerTicks = uxCmdPeriod;
+        }
 
-                ( void ) OSTimerAddToList( ptTimer, ( uxTimeNow + ptTimer->uxTimerTicks ), uxTimeNow, uxTimeNow );                    
-            }
-            #if ( OS_MEMFREE_ON != 0 )
-            else if( tCmdMsg.xCmdMsgType==TMCMD_DELETE || tCmdMsg.xCmdMsgType==TMCMD_DELETE_FROM_ISR)
-            {/* The timer has already been removed from the active list. */
-                OSMemFree(ptTimer);                
-            }
-            #endif /* OS_MEMFREE_ON */
+        uxTimeNow = OSGetTickCount();
+
+        if( xCmdType==TMCMD_START )
+        {
+            OSTimerActivate( ptTimer, uxCmdTicks, uxTimeNow );
         }
+        else if( xCmdType==TMCMD_STOP )
+        {/* The timer has already been removed from the wheel. */
+        }
+        else if( xCmdType==TMCMD_CHANGE_PERIOD )
+        {
+            OSTimerAddToWheel( ptTimer, ( uOSTick_t ) ( uxTimeNow + ptTimer->uxTimerTicks ) );
+        }
+        #if ( OS_MEMFREE_ON != 0 )
+        else if( xCmdType==TMCMD_DELETE )
+        {/* The timer has already been removed from the wheel. */
+            OSMemFreeObject(ptTimer);
+        }
+        #endif /* OS_MEMFREE_ON */
     }
 }
 
 
 static void OSTimerMoniteTask( void *pvParameters)
 {
-    uOSTick_t uxNextExpireTime = (uOSTick_t)0U;
-    uOSBool_t bListWasEmpty = OS_FALSE;
-
     ( void ) pvParameters;
 
     for( ;; )
     {
-        /* Query the timers list to see if it contains any timers, and if so,
-        obtain the time at which the next timer will expire. */
-        uxNextExpireTime = OSTimerGetNextExpireTime( &bListWasEmpty );
+        /* Run the callbacks of the timers that have expired since the last
+        time the wheel was processed. */
+        OSTimerExpiredProcess( OSGetTickCount() );
 
-        /* If a timer has expired, process it.  Otherwise, block this task
-        until either a timer does expire, or a command is received. */
-        OSTimerProcessOrBlock( uxNextExpireTime, bListWasEmpty );
+        /* Block this task until either the next timer does expire, or a
+        command is received. */
+        OSTimerWaitForExpiry();
 
-        /* Receive the command queue. */
-        OSTimerReceiveCmdMsg();
+        /* Apply the pending commands. */
+        OSTimerReceiveCmd();
     }
 }
 
@@ -441,14 +716,13 @@ uOSBool_t OSTimerCreateMoniteTask( void )
 {
     uOSBool_t bReturn = OS_FALSE;
 
-    if( gOSTimerCmdMsgQHandle == OS_NULL )
-    {
-        OSTimerInitListsAndCmdMsgQ();
-    }
-        
-    if( (gOSTimerCmdMsgQHandle != OS_NULL) && (gOSTimerMoniteTaskHandle == OS_NULL))
+    if( gOSTimerMoniteTaskHandle == OS_NULL )
     {
+#if ( OS_STATIC_ALLOC_ON!=0 )
+        gOSTimerMoniteTaskHandle = OSTaskCreateStatic(OSTimerMoniteTask, OS_NULL, OSMINIMAL_STACK_SIZE, OSCALLBACK_TASK_PRIO, "SRCbMsgTask", guxOSTimerMoniteStack, &gtOSTimerMoniteTCB );
+#else
         gOSTimerMoniteTaskHandle = OSTaskCreate(OSTimerMoniteTask, OS_NULL, OSMINIMAL_STACK_SIZE, OSCALLBACK_TASK_PRIO, "SRCbMsgTask" );
+#endif /* OS_STATIC_ALLOC_ON */
     }
     
     if( gOSTimerMoniteTaskHandle != OS_NULL )
@@ -462,11 +736,11 @@ uOSBool_t OSTimerCreateMoniteTask( void )
 #if ( OS_MEMFREE_ON != 0 )
 uOSBool_t OSTimerDelete(OSTimerHandle_t TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_DELETE, 0U, OSPEND_FOREVER_VALUE );
+    return OSTimerSendCmd( TimerHandle, TMCMD_DELETE, 0U );
 }
 uOSBool_t OSTimerDeleteFromISR(OSTimerHandle_t TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_DELETE_FROM_ISR, 0U, 0U );
+    return OSTimerSendCmd( TimerHandle, TMCMD_DELETE_FROM_ISR, 0U );
 }
 #endif /* OS_MEMFREE_ON */
 
@@ -478,7 +752,7 @@ uOSBool_t OSTimerSetTicks(OSTimerHandle_t const TimerHandle, const uOSTick_t uxT
     }
     else
     {
-        return OSTimerSendCmdMsg( TimerHandle, TMCMD_CHANGE_PERIOD, uxTimerTicks, OSPEND_FOREVER_VALUE );
+        return OSTimerSendCmd( TimerHandle, TMCMD_CHANGE_PERIOD, uxTimerTicks );
     }
 }
 uOSBool_t OSTimerSetTicksFromISR(OSTimerHandle_t const TimerHandle, const uOSTick_t uxTimerTicks)
@@ -489,7 +763,7 @@ uOSBool_t OSTimerSetTicksFromISR(OSTimerHandle_t const TimerHandle, const uOSTic
     }
     else
     {
-        return OSTimerSendCmdMsg( TimerHandle, TMCMD_CHANGE_PERIOD_FROM_ISR, uxTimerTicks, 0U );
+        return OSTimerSendCmd( TimerHandle, TMCMD_CHANGE_PERIOD_FROM_ISR, uxTimerTicks );
     }
 }
 
@@ -501,7 +775,7 @@ uOSBool_t OSTimerSetPeriod(OSTimerHandle_t const TimerHandle, const uOSTick_t ux
     }
     else
     {
-        return OSTimerSendCmdMsg( TimerHandle, TMCMD_CHANGE_PERIOD, uxTimerPeriod, OSPEND_FOREVER_VALUE );
+        return OSTimerSendCmd( TimerHandle, TMCMD_CHANGE_PERIOD, uxTimerPeriod );
     }
 }
 uOSBool_t OSTimerSetPeriodFromISR(OSTimerHandle_t const TimerHandle, const uOSTick_t uxTimerPeriod)
@@ -512,26 +786,26 @@ uOSBool_t OSTimerSetPeriodFromISR(OSTimerHandle_t const TimerHandle, const uOSTi
     }
     else
     {
-        return OSTimerSendCmdMsg( TimerHandle, TMCMD_CHANGE_PERIOD_FROM_ISR, uxTimerPeriod, 0U );
+        return OSTimerSendCmd( TimerHandle, TMCMD_CHANGE_PERIOD_FROM_ISR, uxTimerPeriod );
     }
 }
 
 uOSBool_t OSTimerStart(OSTimerHandle_t const TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_START, ( OSGetTickCount() ), OSPEND_FOREVER_VALUE );
+    return OSTimerSendCmd( TimerHandle, TMCMD_START, ( OSGetTickCount() ) );
 }
 uOSBool_t OSTimerStartFromISR(OSTimerHandle_t const TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_START_FROM_ISR, ( OSGetTickCount() ), 0U );
+    return OSTimerSendCmd( TimerHandle, TMCMD_START_FROM_ISR, ( OSGetTickCountFromISR() ) );
 }
 
 uOSBool_t OSTimerStop(OSTimerHandle_t const TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_STOP, 0U, OSPEND_FOREVER_VALUE );
+    return OSTimerSendCmd( TimerHandle, TMCMD_STOP, 0U );
 }
 uOSBool_t OSTimerStopFromISR(OSTimerHandle_t const TimerHandle)
 {
-    return OSTimerSendCmdMsg( TimerHandle, TMCMD_STOP_FROM_ISR, 0U, 0U );
+    return OSTimerSendCmd( TimerHandle, TMCMD_STOP_FROM_ISR, 0U );
 }
 
 uOSBool_t OSTimerIsActive(OSTimerHandle_t TimerHandle)
@@ -585,7 +859,6 @@ sOSBase_t OSTimerGetID(OSTimerHandle_t const TimerHandle)
 }
 
 #endif //( OS_TIMER_ON!=0 )
-#endif//( OS_MSGQ_ON!=0 )
     
 #ifdef __cplusplus
 }
@@ -44,7 +44,6 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-#if ( OS_MSGQ_ON!=0 )
 #if ( OS_TIMER_ON!=0 )
 
 typedef struct tOSTimer
@@ -56,20 +55,32 @@ typedef struct tOSTimer
     void *                   pvParameter;                /* << The value that will be used as the callback functions first parameter. */    
     sOS8_t                   pcTimerName[OSNAME_MAX_LEN];/* name of the timer*/
     sOSBase_t                xID;
+    struct tOSTimer *        ptCmdNext;                  /* << Next timer in the list of the pending commands. */
+    sOSBase_t                xCmdType;                   /* << The pending command, later commands are merged into it. */
+    uOSTick_t                uxCmdTicks;                 /* << The tick count at which a pending start was sent. */
+    uOSTick_t                uxCmdPeriod;                /* << The period set by a pending command, 0 if there is none. */
+#if ( OS_HARD_TIMER_ON!=0 )
+    uOS16_t                  bHard;                      /* << The callback runs from the tick interrupt. */
+#endif /* OS_HARD_TIMER_ON */
+#if ( OS_STATIC_ALLOC_ON!=0 )
+    uOS8_t                   ucStaticAlloc;              /* << OS_TRUE if the memory was given by the application. */
+#endif /* OS_STATIC_ALLOC_ON */
 }tOSTimer_t;
 
 typedef    tOSTimer_t*       OSTimerHandle_t;
 
-typedef struct tTimerCmdMsg
-{
-    sOSBase_t                xCmdMsgType;                /*<< The command message type being sent to the timer moniter task. */
-    uOSTick_t                uxTicks;                    /*<< An optional value used by a timer commands, for example, when changing the period of a timer. */
-    tOSTimer_t *             ptTimer;                    /*<< The timer to which the command will be applied. */
-} tOSTimerCmdMsg_t;
-
 uOSBase_t         OSTimerInit( void ) TINIUX_FUNCTION;
 
 OSTimerHandle_t   OSTimerCreate(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTimerHandle_t   OSTimerCreateStatic(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName, tOSTimer_t * const ptTimerBuffer) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#if ( OS_HARD_TIMER_ON!=0 )
+OSTimerHandle_t   OSTimerCreateHard(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName) TINIUX_FUNCTION;
+#if ( OS_STATIC_ALLOC_ON!=0 )
+OSTimerHandle_t   OSTimerCreateHardStatic(const uOSTick_t uxTimerTicks, const uOS16_t uiIsPeriod, const OSTimerFunction_t Function, void* pvParameter, sOS8_t* pcName, tOSTimer_t * const ptTimerBuffer) TINIUX_FUNCTION;
+#endif /* OS_STATIC_ALLOC_ON */
+#endif /* OS_HARD_TIMER_ON */
 #if ( OS_MEMFREE_ON != 0 )
 uOSBool_t         OSTimerDelete(OSTimerHandle_t TimerHandle) TINIUX_FUNCTION;
 #endif /* OS_MEMFREE_ON */
@@ -90,8 +101,15 @@ uOSBool_t         OSTimerStopFromISR(OSTimerHandle_t const TimerHandle) TINIUX_F
 
 uOSBool_t         OSTimerCreateMoniteTask( void ) TINIUX_FUNCTION;
 
+#if ( OS_HARD_TIMER_ON!=0 )
+void              OSTimerHardTick( void ) TINIUX_FUNCTION;
+#if ( OS_LOWPOWER_ON!=0 )
+uOSTick_t         OSTimerHardNextDelta( void ) TINIUX_FUNCTION;
+void              OSTimerHardFixTime( const uOSTick_t uxTicksToFix ) TINIUX_FUNCTION;
+#endif /* OS_LOWPOWER_ON */
+#endif /* OS_HARD_TIMER_ON */
+
 #endif //( OS_TIMER_ON!=0 )
-#endif//( OS_MSGQ_ON!=0 )
 
 #ifdef __cplusplus
 }
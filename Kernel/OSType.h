@@ -90,12 +90,28 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
 #endif
 #define      OSMEM_ALIGNMENT_MASK      ( OSMEM_ALIGNMENT-1 )
 
-// Priority range of the TINIUX 0~63
+// Largest value a uOSBase_t holds, ports with a narrower one than 32 bits define it
+#ifndef FITBASE_MAX
+  #define    OSBASE_MAX                ( 0xFFFFFFFFUL )
+#else
+  #define    OSBASE_MAX                ( FITBASE_MAX )
+#endif
+
+// Unsigned integer type wide enough to hold a data pointer
+#ifndef FITPOINTER_TYPE
+  typedef    uOS32_t                   uOSAddr_t;
+#else
+  typedef    FITPOINTER_TYPE           uOSAddr_t;
+#endif
+
+// Priority range of the TINIUX 0~255, one less where uOSBase_t is 8 bits so it can hold the count
 #ifndef SETOS_MAX_PRIORITIES
   #define    OSTASK_MAX_PRIORITY       ( 8U )
 #else
-  #if (SETOS_MAX_PRIORITIES>64U)
-    #define    OSTASK_MAX_PRIORITY     ( 64U )
+  #if (SETOS_MAX_PRIORITIES>OSBASE_MAX)
+    #define    OSTASK_MAX_PRIORITY     ( OSBASE_MAX )
+  #elif (SETOS_MAX_PRIORITIES>256U)
+    #define    OSTASK_MAX_PRIORITY     ( 256U )
   #else
     #define    OSTASK_MAX_PRIORITY     ( SETOS_MAX_PRIORITIES )
   #endif
@@ -104,26 +120,6 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
 #define      OSLOWEAST_PRIORITY        ( 0U )
 #define      OSHIGHEAST_PRIORITY       ( OSTASK_MAX_PRIORITY )
 
-// Use quick schedule mode or not
-#ifndef SETOS_USE_QUICK_SCHEDULE
-  #define    OSQUICK_SCHEDULE_ON       ( 0U )
-#else
-  #define    OSQUICK_SCHEDULE_ON       ( SETOS_USE_QUICK_SCHEDULE )
-#endif
-#if ( OSQUICK_SCHEDULE_ON!=0 )
-    #if (OSHIGHEAST_PRIORITY>16U)
-        #define OSQUICK_GET_PRIORITY        ( 3U )
-    #else
-        #if (OSHIGHEAST_PRIORITY>4U)
-            #define OSQUICK_GET_PRIORITY    ( 2U )
-        #else
-            #define OSQUICK_GET_PRIORITY    ( 1U )
-        #endif
-    #endif
-#else
-    #define     OSQUICK_GET_PRIORITY        ( 0U )
-#endif
-
 // Use time slice mode or not
 #ifndef SETOS_TIME_SLICE_ON
   #define    OSTIME_SLICE_ON           ( 1U )
@@ -159,6 +155,102 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OS_MEMFREE_ON             ( SETOS_ENABLE_MEMFREE )
 #endif
 
+// Enable the static create APIs or not, the objects then use memory given by the application
+#ifndef SETOS_ENABLE_STATIC_ALLOC
+  #define    OS_STATIC_ALLOC_ON        ( 0U )
+#else
+  #define    OS_STATIC_ALLOC_ON        ( SETOS_ENABLE_STATIC_ALLOC )
+#endif
+
+// Place the scheduler hot path in TCM or RAM given by the port (GCC Cortex-M4/M7 ports), see FitSection.ld
+#ifndef SETOS_FAST_SECTION
+  #define    OS_FAST_SECTION_ON        ( 0U )
+#else
+  #define    OS_FAST_SECTION_ON        ( SETOS_FAST_SECTION )
+#endif
+
+/* Marks the code and data used on every context switch and tick. */
+#if ( OS_FAST_SECTION_ON!=0 )
+  #if !defined( FITSECTION_FAST_DATA ) || !defined( FITSECTION_FAST_FUNCTION )
+    #error "SETOS_FAST_SECTION is not supported by this port"
+  #endif
+  #define    TINIUX_FAST_DATA          FITSECTION_FAST_DATA
+  #define    TINIUX_FAST_FUNCTION      FITSECTION_FAST_FUNCTION
+#else
+  #define    TINIUX_FAST_DATA          TINIUX_DATA
+  #define    TINIUX_FAST_FUNCTION      TINIUX_FUNCTION
+#endif
+
+// Catch a stack overflow with an MPU guard region at the bottom of the running task stack (GCC Cortex-M3/M4/M7 ports)
+#ifndef SETOS_STACK_MPU_GUARD
+  #define    OS_STACK_MPU_GUARD_ON     ( 0U )
+#else
+  #define    OS_STACK_MPU_GUARD_ON     ( SETOS_STACK_MPU_GUARD )
+#endif
+
+// Read back the stack fill pattern, see OSTaskGetStackHighWaterMark and OSTaskGetStackUsage
+#ifndef SETOS_ENABLE_STACK_HIGHWATER
+  #define    OS_STACK_HIGHWATER_ON     ( 0U )
+#else
+  #define    OS_STACK_HIGHWATER_ON     ( SETOS_ENABLE_STACK_HIGHWATER )
+#endif
+
+// Let the idle task refresh the stack high-water mark of one task per loop, OSTaskGetStackUsage then does not scan
+#ifndef SETOS_STACK_IDLE_SCAN
+  #define    OS_STACK_IDLE_SCAN_ON     ( 0U )
+#else
+  #define    OS_STACK_IDLE_SCAN_ON     ( SETOS_STACK_IDLE_SCAN )
+#endif
+
+// Use the TLSF heap (constant time malloc and free) instead of the first-fit one
+#ifndef SETOS_USE_MEM_TLSF
+  #define    OS_MEM_TLSF_ON            ( 0U )
+#else
+  #define    OS_MEM_TLSF_ON            ( SETOS_USE_MEM_TLSF )
+#endif
+
+// Lock the scheduler instead of the interrupts in the heap, OSMemMalloc/OSMemFree must not be called from ISRs then
+#ifndef SETOS_MEM_SCHEDULE_LOCK
+  #define    OS_MEM_SCHEDULE_LOCK_ON   ( 0U )
+#else
+  #define    OS_MEM_SCHEDULE_LOCK_ON   ( SETOS_MEM_SCHEDULE_LOCK )
+#endif
+
+// Keep the heap statistics returned by OSMemGetStats
+#ifndef SETOS_ENABLE_MEM_STATS
+  #define    OS_MEM_STATS_ON           ( 0U )
+#else
+  #define    OS_MEM_STATS_ON           ( SETOS_ENABLE_MEM_STATS )
+#endif
+
+// Number of heap regions, OSRamHeap and the ones added by OSMemAddRegion
+#ifndef SETOS_MEM_REGION_NUM
+  #define    OSMEM_REGION_NUM          ( 1U )
+#else
+  #define    OSMEM_REGION_NUM          ( SETOS_MEM_REGION_NUM )
+#endif
+
+// Size of the largest region added by OSMemAddRegion, the rest of a larger one is not used
+#ifndef SETOS_MEM_REGION_MAX_SIZE
+  #define    OSMEM_REGION_MAX_SIZE     ( OSTOTAL_HEAP_SIZE )
+#else
+  #define    OSMEM_REGION_MAX_SIZE     ( SETOS_MEM_REGION_MAX_SIZE )
+#endif
+
+// Placement attributes of OSRamHeap (OSMEM_REGION_FAST/DMA/BULK)
+#ifndef SETOS_MEM_HEAP_ATTR
+  #define    OSMEM_HEAP_ATTR           ( OSMEM_REGION_DMA )
+#else
+  #define    OSMEM_HEAP_ATTR           ( SETOS_MEM_HEAP_ATTR )
+#endif
+
+// Region the task stacks and TCBs are taken from first, e.g. OSMEM_REGION_FAST
+#ifndef SETOS_TASK_MEM_HINT
+  #define    OSTASK_MEM_HINT           ( OSMEM_REGION_ANY )
+#else
+  #define    OSTASK_MEM_HINT           ( SETOS_TASK_MEM_HINT )
+#endif
+
 // Use low-power mode or not
 #ifndef SETOS_LOWPOWER_MODE
   #define    OS_LOWPOWER_ON            ( 0U )
@@ -186,6 +278,13 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OSPEND_FOREVER_VALUE      ( ( uOSTick_t ) SETOS_PEND_FOREVER_VALUE )
 #endif
 
+// Number of slots in the timing wheel of the blocked tasks, a power of two
+#ifndef SETOS_PEND_WHEEL_SIZE
+  #define    OSPEND_WHEEL_SIZE         ( 16U )
+#else
+  #define    OSPEND_WHEEL_SIZE         ( SETOS_PEND_WHEEL_SIZE )
+#endif
+
 // Use semaphore or not
 #ifndef SETOS_USE_SEMAPHORE
   #define    OS_SEMAPHORE_ON           ( 1U )
@@ -207,6 +306,34 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OSMSGQ_MAX_MSGNUM         ( SETOS_MSGQ_MAX_MSGNUM )
 #endif
 
+// Use message buffer or not
+#ifndef SETOS_USE_MSGBUF
+  #define    OS_MSGBUF_ON              ( 1U )
+#else
+  #define    OS_MSGBUF_ON              ( SETOS_USE_MSGBUF )
+#endif
+
+// Use stream buffer or not
+#ifndef SETOS_USE_STREAMBUF
+  #define    OS_STREAMBUF_ON           ( 1U )
+#else
+  #define    OS_STREAMBUF_ON           ( SETOS_USE_STREAMBUF )
+#endif
+
+// Use fixed-block memory pool or not
+#ifndef SETOS_USE_MEMPOOL
+  #define    OS_MEMPOOL_ON             ( 1U )
+#else
+  #define    OS_MEMPOOL_ON             ( SETOS_USE_MEMPOOL )
+#endif
+
+// Look for every block given back to a memory pool on its free list, to catch one freed twice
+#ifndef SETOS_MEMPOOL_CHECK
+  #define    OS_MEMPOOL_CHECK_ON       ( 0U )
+#else
+  #define    OS_MEMPOOL_CHECK_ON       ( SETOS_MEMPOOL_CHECK )
+#endif
+
 
 // Use mutex or not
 #ifndef SETOS_USE_MUTEX
@@ -215,6 +342,20 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OS_MUTEX_ON               ( SETOS_USE_MUTEX )
 #endif
 
+// Use event flags or not
+#ifndef SETOS_USE_EVENT
+  #define    OS_EVENT_ON               ( 1U )
+#else
+  #define    OS_EVENT_ON               ( SETOS_USE_EVENT )
+#endif
+
+// Use select (wait on several MsgQ Sem Mutex and task signals at once) or not
+#ifndef SETOS_USE_SELECT
+  #define    OS_SELECT_ON              ( 1U )
+#else
+  #define    OS_SELECT_ON              ( SETOS_USE_SELECT )
+#endif
+
 // Use Timer or not
 #ifndef SETOS_USE_TIMER
   #define    OS_TIMER_ON               ( 1U )
@@ -222,14 +363,28 @@ typedef enum {OS_SUCESS = 0, OS_ERROR = !OS_SUCESS} uOSStatus_t;
   #define    OS_TIMER_ON               ( SETOS_USE_TIMER )
 #endif
 
-#if ( OS_MSGQ_ON!=0 )
+#if ( OS_TIMER_ON!=0 )
 // Used by timer
 #ifndef SETOS_CALLBACK_TASK_PRIORITY
   #define    OSCALLBACK_TASK_PRIO      ( OSHIGHEAST_PRIORITY - 1 )
 #else
   #define    OSCALLBACK_TASK_PRIO      ( SETOS_CALLBACK_TASK_PRIORITY )
 #endif
-#endif //( OS_MSGQ_ON!=0 )
+
+// Number of slots in the timing wheel of the armed timers, a power of two
+#ifndef SETOS_TIMER_WHEEL_SIZE
+  #define    OSTIMER_WHEEL_SIZE        ( 16U )
+#else
+  #define    OSTIMER_WHEEL_SIZE        ( SETOS_TIMER_WHEEL_SIZE )
+#endif
+#endif //( OS_TIMER_ON!=0 )
+
+// Use hard timers or not, their callbacks run from the tick interrupt
+#if ( OS_TIMER_ON!=0 ) && defined( SETOS_USE_HARD_TIMER )
+  #define    OS_HARD_TIMER_ON          ( SETOS_USE_HARD_TIMER )
+#else
+  #define    OS_HARD_TIMER_ON          ( 0U )
+#endif
 
 #ifndef SETOS_TASK_SIGNAL_ON
   #define    OS_TASK_SIGNAL_ON         ( 1U )
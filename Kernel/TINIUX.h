@@ -50,8 +50,13 @@ extern "C" {
 #include "OSSchedule.h"
 #include "OSTask.h"
 #include "OSMsgQ.h"
+#include "OSMsgBuf.h"
+#include "OSStreamBuf.h"
+#include "OSMemPool.h"
 #include "OSSem.h"
 #include "OSMutex.h"
+#include "OSEvent.h"
+#include "OSSelect.h"
 #include "OSTimer.h"
 
 #define KERNEL_VERSION      "V3.1.0"
@@ -58,18 +58,31 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SETOS_TICK_RATE_HZ                      ( 1000 )            //定义TINIUX系统中ticks频率
 
 #define SETOS_MINIMAL_STACK_SIZE                ( 80 )          //定义任务占用的最小Stack空间
+#define SETOS_ENABLE_STACK_HIGHWATER            ( 1 )           //是否可读取任务栈的历史最小剩余空间（高水位），见OSTaskGetStackHighWaterMark及OSTaskGetStackUsage
+#define SETOS_STACK_IDLE_SCAN                   ( 0 )           //是否由空闲任务逐个刷新各任务栈的高水位，开启后OSTaskGetStackUsage不再扫描任务栈
+#define SETOS_STACK_MPU_GUARD                   ( 0 )           //是否用MPU在当前任务栈底设置保护区，栈溢出时立即触发MemManage异常，开启后不再在任务切换时软件检查栈
+#define SETOS_FAST_SECTION                      ( 0 )           //是否将调度器热路径（任务切换、Tick处理及就绪表等）放入TCM或RAM中运行，需在链接脚本中引入FitSection.ld
 #define SETOS_TOTAL_HEAP_SIZE                   ( 1024*5 )      //定义系统占用的Heap空间
 #define SETOS_ENABLE_MEMFREE                    ( 1 )           //是否允许释放内存，允许后可以在系统运行时删除Task MsgQ Semaphone Mutex Timer等
+#define SETOS_ENABLE_STATIC_ALLOC               ( 1 )           //是否启用静态创建接口，任务及MsgQ Semaphone Mutex Timer等可使用应用程序提供的内存，不占用Heap
+#define SETOS_USE_MEM_TLSF                      ( 0 )           //是否使用TLSF内存分配算法，分配及释放耗时恒定，0使用首次适配算法
+#define SETOS_MEM_SCHEDULE_LOCK                 ( 0 )           //堆内存操作是否只锁调度器而不关中断，缩短关中断时间，开启后不可在中断中分配或释放内存
+#define SETOS_ENABLE_MEM_STATS                  ( 1 )           //是否统计堆内存使用情况（空闲字节、最大空闲块、历史最小空闲等），可通过OSMemGetStats获取
+#define SETOS_MEM_REGION_NUM                    ( 1 )           //定义堆内存区域的数量，大于1时可用OSMemAddRegion加入CCM/DTCM、外部SDRAM等内存
 #define SETOS_LOWPOWER_MODE                     ( 1 )           //是否开启低功耗模式
 #define SETOS_MAX_NAME_LEN                      ( 10 )          //定义任务、信号量、消息队列等变量中的名称长度
 #define SETOS_MAX_PRIORITIES                    ( 8 )           //定义任务最大优先级
 #define SETOS_TASK_SIGNAL_ON                    ( 1 )           //是否启动轻量级的任务同步信号，功能类似Semaphore MsgQ，内存占用要小于Semaphore MsgQ
 #define SETOS_USE_SEMAPHORE                     ( 1 )           //是否启用系统信号量功能 0关闭 1启用
 #define SETOS_USE_MUTEX                         ( 1 )           //是否启用互斥信号量功能 0关闭 1启用
+#define SETOS_USE_EVENT                         ( 1 )           //是否启用事件标志组功能 0关闭 1启用
+#define SETOS_USE_SELECT                        ( 1 )           //是否启用多对象等待（select）功能 0关闭 1启用
 #define SETOS_USE_MSGQ                          ( 1 )           //是否启用系统消息队列功能 0关闭 1启用
 #define SETOS_MSGQ_MAX_MSGNUM                   ( 5 )           //定义消息队列中消息的门限值
+#define SETOS_USE_MSGBUF                        ( 1 )           //是否启用变长消息缓冲区功能 0关闭 1启用
+#define SETOS_USE_STREAMBUF                     ( 1 )           //是否启用字节流缓冲区功能 0关闭 1启用
+#define SETOS_USE_MEMPOOL                       ( 1 )           //是否启用固定块内存池功能 0关闭 1启用
 #define SETOS_USE_TIMER                         ( 1 )           //是否使用系统软件定时器
-#define SETOS_USE_QUICK_SCHEDULE                ( 1 )           //是否启动快速调度算法
 #define SETOS_TIME_SLICE_ON                     ( 1 )           //是否启用时间片轮转（time slice）调度机制
 #define SETOS_PEND_FOREVER_VALUE                ( 0xFFFFFFFFUL )//定义信号量及消息队列中永久等待的数值
 
@@ -53,18 +53,29 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SETOS_TICK_RATE_HZ                      ( 1000 )             //定义TINIUX系统中ticks频率
 
 #define SETOS_MINIMAL_STACK_SIZE                ( ( unsigned short ) 100 )    //任务运行时的Stack空间，51架构下系统中所有任务运行时均使用此大小的stack空间
+#define SETOS_ENABLE_STACK_HIGHWATER            ( 0 )        //是否可读取任务栈的历史最小剩余空间（高水位），见OSTaskGetStackHighWaterMark及OSTaskGetStackUsage
+#define SETOS_STACK_IDLE_SCAN                   ( 0 )        //是否由空闲任务逐个刷新各任务栈的高水位，开启后OSTaskGetStackUsage不再扫描任务栈
 #define SETOS_TOTAL_HEAP_SIZE                   ( 1024*2 )   //定义系统占用的Heap空间
 #define SETOS_ENABLE_MEMFREE                    ( 0 )        //是否允许释放内存，允许后可以在系统运行时删除Task MsgQ Semaphone Mutex Timer等
+#define SETOS_ENABLE_STATIC_ALLOC               ( 0 )        //是否启用静态创建接口，任务及MsgQ Semaphone Mutex Timer等可使用应用程序提供的内存，不占用Heap
+#define SETOS_USE_MEM_TLSF                      ( 0 )        //是否使用TLSF内存分配算法，分配及释放耗时恒定，0使用首次适配算法
+#define SETOS_MEM_SCHEDULE_LOCK                 ( 0 )        //堆内存操作是否只锁调度器而不关中断，缩短关中断时间，开启后不可在中断中分配或释放内存
+#define SETOS_ENABLE_MEM_STATS                  ( 0 )        //是否统计堆内存使用情况（空闲字节、最大空闲块、历史最小空闲等），可通过OSMemGetStats获取
+#define SETOS_MEM_REGION_NUM                    ( 1 )        //定义堆内存区域的数量，大于1时可用OSMemAddRegion加入CCM/DTCM、外部SDRAM等内存
 #define SETOS_LOWPOWER_MODE                     ( 0 )        //是否开启低功耗模式
 #define SETOS_MAX_NAME_LEN                      ( 8 )        //定义任务、信号量、消息队列等变量中的名称长度
 #define SETOS_MAX_PRIORITIES                    ( 4 )        //定义任务最大优先级
 #define SETOS_TASK_SIGNAL_ON                    ( 1 )        //是否启动轻量级的任务同步信号，功能类似Semaphore MsgQ，内存占用要小于Semaphore MsgQ
 #define SETOS_USE_SEMAPHORE                     ( 0 )        //是否启用系统信号量功能 0关闭 1启用
 #define SETOS_USE_MUTEX                         ( 0 )        //是否启用互斥信号量功能 0关闭 1启用
+#define SETOS_USE_EVENT                         ( 0 )        //是否启用事件标志组功能 0关闭 1启用
+#define SETOS_USE_SELECT                        ( 0 )        //是否启用多对象等待（select）功能 0关闭 1启用
 #define SETOS_USE_MSGQ                          ( 0 )        //是否启用系统消息队列功能 0关闭 1启用
 #define SETOS_MSGQ_MAX_MSGNUM                   ( 5 )        //定义消息队列中消息的门限值
+#define SETOS_USE_MSGBUF                        ( 0 )        //是否启用变长消息缓冲区功能 0关闭 1启用
+#define SETOS_USE_STREAMBUF                     ( 0 )        //是否启用字节流缓冲区功能 0关闭 1启用
+#define SETOS_USE_MEMPOOL                       ( 0 )        //是否启用固定块内存池功能 0关闭 1启用
 #define SETOS_USE_TIMER                         ( 0 )        //是否使用系统软件定时器
-#define SETOS_USE_QUICK_SCHEDULE                ( 1 )        //是否启动快速调度算法
 #define SETOS_TIME_SLICE_ON                     ( 1 )        //是否启用时间片轮转（time slice）调度机制
 #define SETOS_PEND_FOREVER_VALUE                ( 0xFFFFU )  //定义信号量及消息队列中永久等待的数值
 